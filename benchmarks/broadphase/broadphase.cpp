@@ -0,0 +1,127 @@
+//
+// MARMaths - open source computing library for MAREngine
+//
+// Broadphase benchmark. Simulates N moving boxes and compares, on identical scenes, time per tick of
+// sweepAndPrune (incremental and rebuilt every tick) and of spatialHash (grid over box centers,
+// radius query and aabb filter). Every method has to report the same count of overlapping pairs.
+//
+// Example:
+//   g++ -std=c++17 -O2 -Iinclude benchmarks/broadphase/broadphase.cpp src/*.cpp -lpthread -o broadphase
+//   ./broadphase 100000 60
+//
+
+#include "MARMaths.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace marengine::maths;
+
+
+struct scene {
+	std::vector<vec3> positions;
+	std::vector<vec3> velocities;
+	std::vector<vec3> halfExtents;
+	std::vector<aabb> bounds;
+	float size;
+	float maxHalfExtent;
+};
+
+static scene createScene(size_t count) {
+	std::mt19937 random{ 1337 };
+	std::uniform_real_distribution<float> unit{ 0.f, 1.f };
+	scene s;
+	s.size = std::cbrt((float)count) * 4.f;
+	s.maxHalfExtent = 1.f;
+	for (size_t i = 0; i < count; i++) {
+		s.positions.push_back({ unit(random) * s.size, unit(random) * s.size, unit(random) * s.size });
+		s.velocities.push_back({ unit(random) - 0.5f, unit(random) - 0.5f, unit(random) - 0.5f });
+		s.halfExtents.push_back({ 0.2f + unit(random) * 0.8f, 0.2f + unit(random) * 0.8f, 0.2f + unit(random) * 0.8f });
+		s.bounds.push_back({ s.positions[i] - s.halfExtents[i], s.positions[i] + s.halfExtents[i] });
+	}
+	return s;
+}
+
+static void step(scene& s, float dt) {
+	for (size_t i = 0; i < s.positions.size(); i++) {
+		vec3 p{ s.positions[i] + s.velocities[i] * dt };
+		vec3& v{ s.velocities[i] };
+		if (p.x < 0.f || p.x > s.size) { v.x = -v.x; }
+		if (p.y < 0.f || p.y > s.size) { v.y = -v.y; }
+		if (p.z < 0.f || p.z > s.size) { v.z = -v.z; }
+		s.positions[i] = p;
+		s.bounds[i] = { p - s.halfExtents[i], p + s.halfExtents[i] };
+	}
+}
+
+static double milliseconds(std::chrono::steady_clock::time_point begin) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main(int argc, char** argv) {
+	const size_t count{ argc > 1 ? (size_t)std::atoll(argv[1]) : 100000 };
+	const size_t frames{ argc > 2 ? (size_t)std::atoll(argv[2]) : 60 };
+	scene s{ createScene(count) };
+
+	sweepAndPrune incremental;
+	spatialHash grid{ s.maxHalfExtent * 2.f };
+	std::vector<convexPair> pairs(count * 4);
+	std::vector<vec3> centers(count);
+	std::vector<uint32_t> offsets, neighbors;
+	// centers of overlapping boxes are at most twice the largest half-diagonal apart
+	const float queryRadius{ s.maxHalfExtent * 2.f * std::sqrt(3.f) };
+
+	double timeIncremental{ 0.0 };
+	double timeRebuilt{ 0.0 };
+	double timeHash{ 0.0 };
+	size_t totalPairs{ 0 };
+	for (size_t frame = 0; frame < frames; frame++) {
+		step(s, 1.f / 60.f);
+
+		auto begin{ std::chrono::steady_clock::now() };
+		incremental.update(s.bounds.data(), count);
+		size_t found{ incremental.findPairs(pairs.data(), pairs.size()) };
+		if (found > pairs.size()) {
+			pairs.resize(found);
+			found = incremental.findPairs(pairs.data(), pairs.size());
+		}
+		timeIncremental += milliseconds(begin);
+
+		begin = std::chrono::steady_clock::now();
+		sweepAndPrune rebuilt;
+		rebuilt.update(s.bounds.data(), count);
+		const size_t foundRebuilt{ rebuilt.findPairs(pairs.data(), pairs.size()) };
+		timeRebuilt += milliseconds(begin);
+
+		begin = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < count; i++) {
+			centers[i] = s.bounds[i].center();
+		}
+		grid.build(centers.data(), count);
+		grid.queryRadiusMany(centers.data(), count, queryRadius, offsets, neighbors);
+		size_t foundHash{ 0 };
+		for (size_t i = 0; i < count; i++) {
+			for (uint32_t k = offsets[i]; k < offsets[i + 1]; k++) {
+				const uint32_t j{ neighbors[k] };
+				foundHash += (i < j && aabb::intersects(s.bounds[i], s.bounds[j])) ? 1 : 0;
+			}
+		}
+		timeHash += milliseconds(begin);
+
+		if (found != foundRebuilt || found != foundHash) {
+			std::printf("mismatch in frame %zu: %zu / %zu / %zu pairs\n", frame, found, foundRebuilt, foundHash);
+			return 1;
+		}
+		totalPairs += found;
+	}
+
+	std::printf("%zu boxes, %zu frames, %.1f pairs per frame, sorted along axis %u\n", count, frames,
+		(double)totalPairs / (double)frames, incremental.axis());
+	std::printf("sweepAndPrune (incremental): %8.3f ms per frame\n", timeIncremental / (double)frames);
+	std::printf("sweepAndPrune (rebuilt):     %8.3f ms per frame\n", timeRebuilt / (double)frames);
+	std::printf("spatialHash:                 %8.3f ms per frame\n", timeHash / (double)frames);
+	return 0;
+}
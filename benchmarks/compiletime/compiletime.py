@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+#
+# MARMaths - open source computing library for MAREngine
+#
+# Compile-time benchmark. Generates synthetic project of N translation units, each including
+# given MARMaths header and using few core types, then compiles them and reports wall time.
+#
+# Example:
+#   python3 compiletime.py --header include/MARMathsCore.h
+#   python3 compiletime.py --header include/MARMaths.h --count 500 --jobs 1
+#   python3 compiletime.py --header include/MARMathsCore.h --pch
+#   python3 compiletime.py --root /path/to/older/checkout --header include/MARMaths.h
+#
+
+import argparse
+import os
+import shutil
+import subprocess
+import tempfile
+import time
+
+
+TRANSLATION_UNIT = """#include "{header}"
+
+namespace bench{index} {{
+
+	float compute(float angle, float x, float y, float z) {{
+		using namespace marengine::maths;
+		const vec3 position{{ x, y, z }};
+		const mat4 transform{{ mat4::translation(position) * mat4::rotation(angle, vec3{{ 0.f, 1.f, 0.f }}) }};
+		const vec4 moved{{ transform * vec4{{ position, 1.f }} }};
+		return vec3::length(vec3{{ moved.x, moved.y, moved.z }}) + vec2::dot(vec2{{ x, y }}, vec2{{ y, x }});
+	}}
+
+}}
+"""
+
+
+def generate(directory, header, count):
+    sources = []
+    for index in range(count):
+        path = os.path.join(directory, "tu{}.cpp".format(index))
+        with open(path, "w") as file:
+            file.write(TRANSLATION_UNIT.format(header=header, index=index))
+        sources.append(path)
+    return sources
+
+
+def compile_all(compiler, flags, sources, jobs):
+    running = []
+    start = time.perf_counter()
+    for source in sources:
+        if len(running) == jobs and running.pop(0).wait() != 0:
+            raise RuntimeError("compilation failed")
+        running.append(subprocess.Popen([compiler] + flags + ["-c", source, "-o", source + ".o"]))
+    for process in running:
+        if process.wait() != 0:
+            raise RuntimeError("compilation failed")
+    return time.perf_counter() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MARMaths compile-time benchmark")
+    parser.add_argument("--root", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+    parser.add_argument("--header", default="include/MARMaths.h")
+    parser.add_argument("--count", type=int, default=500)
+    parser.add_argument("--jobs", type=int, default=os.cpu_count())
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "g++"))
+    parser.add_argument("--flags", default="-std=c++17 -O0")
+    parser.add_argument("--pch", action="store_true", help="precompile the header first (gcc / clang)")
+    arguments = parser.parse_args()
+
+    header = os.path.abspath(os.path.join(arguments.root, arguments.header))
+    flags = arguments.flags.split()
+    directory = tempfile.mkdtemp(prefix="marmaths_compiletime_")
+    try:
+        if arguments.pch:
+            precompiled = os.path.join(directory, "core.h")
+            with open(precompiled, "w") as file:
+                file.write("#include \"{}\"\n".format(header))
+            pch_start = time.perf_counter()
+            subprocess.run([arguments.compiler] + flags + ["-x", "c++-header", precompiled, "-o", precompiled + ".gch"], check=True)
+            print("pch: {:.2f} s".format(time.perf_counter() - pch_start))
+            header = precompiled
+        sources = generate(directory, header, arguments.count)
+        elapsed = compile_all(arguments.compiler, flags, sources, max(1, arguments.jobs))
+        print("{} TUs including {}: {:.2f} s total, {:.1f} ms per TU ({} jobs)".format(
+            arguments.count, arguments.header, elapsed, elapsed * 1000.0 / arguments.count, arguments.jobs))
+    finally:
+        shutil.rmtree(directory)
+
+
+if __name__ == "__main__":
+    main()
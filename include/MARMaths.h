@@ -27,15 +27,49 @@
 #include <math.h>
 
 #include "../src/basic.h"
+#include "../src/parallel.h"
+#include "../src/instrumentation.h"
+#include "../src/diagnostics.h"
+#include "../src/stridedview.h"
 
 #include "../src/quat.h"
 
 #include "../src/trig.h"
 
 #include "../src/vec2.h"
+#include "../src/rotor2.h"
 #include "../src/vec3.h"
 #include "../src/vec4.h"
+#include "../src/dvec3.h"
+#include "../src/fixed.h"
+#include "../src/fixedvec3.h"
+#include "../src/fixedquat.h"
+#include "../src/expr.h"
 
+#include "../src/mat3.h"
 #include "../src/mat4.h"
+#include "../src/decomposition.h"
+#include "../src/affine2.h"
+#include "../src/sprite.h"
+#include "../src/fixedmat4.h"
+
+#include "../src/aabb.h"
+#include "../src/spatialcode.h"
+#include "../src/radixsort.h"
+#include "../src/spatialhash.h"
+#include "../src/kdtree.h"
+#include "../src/obb.h"
+#include "../src/convex.h"
+#include "../src/gjk.h"
+#include "../src/sweepandprune.h"
+#include "../src/rigidbody.h"
+
+#include "../src/world.h"
+#include "../src/frustum.h"
+#include "../src/camera.h"
+#include "../src/shadowcascades.h"
+
+#include "../src/archive.h"
+#include "../src/text.h"
 
 #endif // !MAR_MATH_MAIN_H
@@ -0,0 +1,47 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_CORE_H
+#define MAR_MATH_CORE_H
+
+
+/**
+ * Core types only: basic, trig, vec2, vec3, vec4, quat, mat3 and mat4. None of them pulls in
+ * <iostream>, <cmath> or any container, so it is cheap to include everywhere and is a good
+ * candidate for precompiled header. MARMaths.h includes everything (batch tools, archive, text...).
+ */
+
+
+#include "../src/basic.h"
+#include "../src/trig.h"
+
+#include "../src/vec2.h"
+#include "../src/vec3.h"
+#include "../src/vec4.h"
+#include "../src/quat.h"
+
+#include "../src/mat3.h"
+#include "../src/mat4.h"
+
+
+#endif // !MAR_MATH_CORE_H
@@ -0,0 +1,111 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_FWD_H
+#define MAR_MATH_FWD_H
+
+
+/**
+ * Forward declarations of every MARMaths type. Include it in headers, which only pass
+ * types by reference or pointer, and include the full type header in translation unit.
+ */
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+	struct basic;
+	struct trig;
+	struct parallel;
+
+	enum class diagnostic : uint32_t;
+	struct diagnostics;
+	struct denormalScope;
+	enum class probe : uint32_t;
+	struct probeRecord;
+	struct probeScope;
+	struct instrumentation;
+
+	struct vec2;
+	struct rotor2;
+	struct affine2;
+	struct vec3;
+	struct vec4;
+	struct dvec3;
+	struct quat;
+	struct mat3;
+	struct mat4;
+	struct decomposition;
+	struct spriteArrays;
+	struct sprite;
+
+	struct fixed;
+	struct fixedVec3;
+	struct fixedQuat;
+	struct fixedMat4;
+
+	struct aabb;
+	struct spatialCode;
+	struct radixSort;
+	struct spatialHash;
+	template<size_t N> struct kdTree;
+	using kdTree2 = kdTree<2>;
+	using kdTree3 = kdTree<3>;
+	struct obb;
+	struct convexShape;
+	struct gjkCache;
+	struct convexPair;
+	struct convexResult;
+	struct gjk;
+	struct sweepAndPrune;
+	struct rigidBodyArrays;
+	struct rigidBody;
+
+	struct world;
+	struct frustum;
+	struct camera;
+	struct cascade;
+	struct shadowCascades;
+
+	template<typename T> struct stridedView;
+	template<typename T> struct stridedWriter;
+
+	enum class archiveType : uint32_t;
+	template<typename T> struct archiveTypeOf;
+	struct archiveHeader;
+	struct archiveChunk;
+	struct archive;
+	struct archiveWriter;
+
+	enum class textStyle;
+	struct text;
+	struct textWriter;
+	struct textReader;
+
+}
+
+
+#endif // !MAR_MATH_FWD_H
@@ -0,0 +1,129 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "aabb.h"
+#include "mat4.h"
+#include <cfloat>
+
+
+namespace marengine::maths {
+
+
+	aabb::aabb() :
+		minimum(FLT_MAX, FLT_MAX, FLT_MAX),
+		maximum(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+	{}
+
+	aabb::aabb(vec3 _minimum, vec3 _maximum) :
+		minimum(_minimum),
+		maximum(_maximum)
+	{}
+
+	aabb aabb::fromPoints(const vec3* points, size_t count) {
+		aabb rtn;
+		for (size_t i = 0; i < count; i++) {
+			rtn.expand(points[i]);
+		}
+		return rtn;
+	}
+
+	void aabb::expand(vec3 point) {
+		minimum.x = point.x < minimum.x ? point.x : minimum.x;
+		minimum.y = point.y < minimum.y ? point.y : minimum.y;
+		minimum.z = point.z < minimum.z ? point.z : minimum.z;
+		maximum.x = point.x > maximum.x ? point.x : maximum.x;
+		maximum.y = point.y > maximum.y ? point.y : maximum.y;
+		maximum.z = point.z > maximum.z ? point.z : maximum.z;
+	}
+
+	aabb aabb::merge(const aabb& left, const aabb& right) {
+		aabb rtn{ left };
+		rtn.expand(right.minimum);
+		rtn.expand(right.maximum);
+		return rtn;
+	}
+
+	aabb aabb::transform(const aabb& box, const mat4& transform) {
+		if (box.isEmpty()) {
+			return box;
+		}
+
+		// Every output axis is translation plus sum of smaller / larger products of matrix
+		// row with box range, which gives exact bounds of 8 transformed corners.
+		const float* m{ transform.elements };
+		const float lower[3]{ box.minimum.x, box.minimum.y, box.minimum.z };
+		const float upper[3]{ box.maximum.x, box.maximum.y, box.maximum.z };
+		float outLower[3];
+		float outUpper[3];
+		for (size_t row = 0; row < 3; row++) {
+			outLower[row] = outUpper[row] = m[row + 3 * 4];
+			for (size_t col = 0; col < 3; col++) {
+				const float a{ m[row + col * 4] * lower[col] };
+				const float b{ m[row + col * 4] * upper[col] };
+				outLower[row] += a < b ? a : b;
+				outUpper[row] += a < b ? b : a;
+			}
+		}
+
+		return { { outLower[0], outLower[1], outLower[2] }, { outUpper[0], outUpper[1], outUpper[2] } };
+	}
+
+	bool aabb::isEmpty() const {
+		return minimum.x > maximum.x || minimum.y > maximum.y || minimum.z > maximum.z;
+	}
+
+	vec3 aabb::center() const {
+		return (minimum + maximum) * 0.5f;
+	}
+
+	vec3 aabb::extent() const {
+		return maximum - minimum;
+	}
+
+	float aabb::surfaceArea() const {
+		const vec3 e{ extent() };
+		return 2.f * (e.x * e.y + e.y * e.z + e.z * e.x);
+	}
+
+	bool aabb::contains(vec3 point) const {
+		return point.x >= minimum.x && point.x <= maximum.x &&
+			point.y >= minimum.y && point.y <= maximum.y &&
+			point.z >= minimum.z && point.z <= maximum.z;
+	}
+
+	bool aabb::intersects(const aabb& left, const aabb& right) {
+		return left.minimum.x <= right.maximum.x && left.maximum.x >= right.minimum.x &&
+			left.minimum.y <= right.maximum.y && left.maximum.y >= right.minimum.y &&
+			left.minimum.z <= right.maximum.z && left.maximum.z >= right.minimum.z;
+	}
+
+	bool aabb::operator==(const aabb& other) const {
+		return minimum == other.minimum && maximum == other.maximum;
+	}
+
+	bool aabb::operator!=(const aabb& other) const {
+		return !(*this == other);
+	}
+
+
+}
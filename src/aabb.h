@@ -0,0 +1,140 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_AABB_H
+#define MAR_MATH_AABB_H
+
+
+#include "maths.h"
+#include "vec3.h"
+
+
+namespace marengine::maths {
+
+	struct mat4;
+
+
+	/**
+	 * \struct aabb aabb.h "aabb.h"
+	 * \brief Axis-aligned bounding box given by its minimum and maximum corner. Default
+	 * constructed box is empty (minimum greater than maximum), so it can be grown with expand().
+	 */
+	struct aabb {
+
+		/// \brief corner with the smallest coordinates
+		vec3 minimum;
+		/// \brief corner with the largest coordinates
+		vec3 maximum;
+
+
+		/// \brief Default constructor, creates empty box.
+		aabb();
+
+		/**
+		 * \brief Constructor, that creates box from given corners.
+		 * \param _minimum corner with the smallest coordinates
+		 * \param _maximum corner with the largest coordinates
+		 */
+		aabb(vec3 _minimum, vec3 _maximum);
+
+		/**
+		 * \brief Creates the smallest box containing every given point.
+		 * \param points array of points
+		 * \param count count of points
+		 * \return created box, empty if count is 0
+		 */
+		static aabb fromPoints(const vec3* points, size_t count);
+
+		/**
+		 * \brief Grows box, so that it contains given point.
+		 * \param point point, which will be contained
+		 */
+		void expand(vec3 point);
+
+		/**
+		 * \brief Creates the smallest box containing both given boxes.
+		 * \param left first box
+		 * \param right second box
+		 * \return merged box
+		 */
+		static aabb merge(const aabb& left, const aabb& right);
+
+		/**
+		 * \brief Computes box containing given box after transformation (Arvo's method).
+		 * \param box box, which will be transformed
+		 * \param transform affine transform
+		 * \return transformed box
+		 */
+		static aabb transform(const aabb& box, const mat4& transform);
+
+		/**
+		 * \brief Checks, if box is empty (minimum is greater than maximum on any axis).
+		 * \return true, if box is empty
+		 */
+		bool isEmpty() const;
+
+		/**
+		 * \brief Returns center of box.
+		 * \return center
+		 */
+		vec3 center() const;
+
+		/**
+		 * \brief Returns size of box along every axis.
+		 * \return maximum - minimum
+		 */
+		vec3 extent() const;
+
+		/**
+		 * \brief Returns surface area of box, used as cost in tree building heuristics.
+		 * \return surface area
+		 */
+		float surfaceArea() const;
+
+		/**
+		 * \brief Checks, if point lies inside box (boundary included).
+		 * \param point point to check
+		 * \return true, if point is inside
+		 */
+		bool contains(vec3 point) const;
+
+		/**
+		 * \brief Checks, if two boxes overlap (touching boxes overlap).
+		 * \param left first box
+		 * \param right second box
+		 * \return true, if boxes overlap
+		 */
+		static bool intersects(const aabb& left, const aabb& right);
+
+		/// \brief self-explanatory
+		bool operator==(const aabb& other) const;
+		/// \brief self-explanatory
+		bool operator!=(const aabb& other) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_AABB_H
@@ -0,0 +1,177 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "affine2.h"
+#include "vec2.h"
+#include "rotor2.h"
+#include "mat3.h"
+#include "mat4.h"
+#include "parallel.h"
+#include "diagnostics.h"
+
+
+namespace marengine::maths {
+
+
+	affine2::affine2() :
+		elements{ 1.f, 0.f, 0.f, 1.f, 0.f, 0.f }
+	{}
+
+	affine2::affine2(vec2 xAxis, vec2 yAxis, vec2 translation) :
+		elements{ xAxis.x, xAxis.y, yAxis.x, yAxis.y, translation.x, translation.y }
+	{}
+
+	affine2 affine2::identity() {
+		return affine2();
+	}
+
+	affine2 affine2::translation(vec2 trans) {
+		return { { 1.f, 0.f }, { 0.f, 1.f }, trans };
+	}
+
+	affine2 affine2::rotation(float radians) {
+		return rotation(rotor2::fromAngle(radians));
+	}
+
+	affine2 affine2::rotation(rotor2 r) {
+		return { { r.c, r.s }, { -r.s, r.c }, { 0.f, 0.f } };
+	}
+
+	affine2 affine2::scale(vec2 scal) {
+		return { { scal.x, 0.f }, { 0.f, scal.y }, { 0.f, 0.f } };
+	}
+
+	affine2 affine2::compose(vec2 trans, rotor2 r, vec2 scal) {
+		return { { r.c * scal.x, r.s * scal.x }, { -r.s * scal.y, r.c * scal.y }, trans };
+	}
+
+	affine2 affine2::orthographic(float left, float right, float top, float bottom) {
+		return {
+			{ 2.f / (right - left), 0.f },
+			{ 0.f, 2.f / (top - bottom) },
+			{ -(right + left) / (right - left), -(top + bottom) / (top - bottom) }
+		};
+	}
+
+	affine2 affine2::multiply(const affine2& other) const {
+		const float* a{ elements };
+		const float* b{ other.elements };
+		affine2 rtn;
+		rtn.elements[0] = a[0] * b[0] + a[2] * b[1];
+		rtn.elements[1] = a[1] * b[0] + a[3] * b[1];
+		rtn.elements[2] = a[0] * b[2] + a[2] * b[3];
+		rtn.elements[3] = a[1] * b[2] + a[3] * b[3];
+		rtn.elements[4] = a[0] * b[4] + a[2] * b[5] + a[4];
+		rtn.elements[5] = a[1] * b[4] + a[3] * b[5] + a[5];
+		return rtn;
+	}
+
+	vec2 affine2::transformPoint(vec2 point) const {
+		return {
+			elements[0] * point.x + elements[2] * point.y + elements[4],
+			elements[1] * point.x + elements[3] * point.y + elements[5]
+		};
+	}
+
+	vec2 affine2::transformVector(vec2 vector) const {
+		return {
+			elements[0] * vector.x + elements[2] * vector.y,
+			elements[1] * vector.x + elements[3] * vector.y
+		};
+	}
+
+	void affine2::transformPoints(const affine2& transform, const vec2* in, vec2* out, size_t count) {
+		const affine2 t{ transform };
+		parallel::forEach(count, [&t, in, out](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				out[i] = t.transformPoint(in[i]);
+			}
+			MARMATH_CHECK_FINITE(&out[begin].x, 2 * (end - begin), "affine2::transformPoints");
+		});
+	}
+
+	float affine2::determinant(const affine2& a) {
+		return a.elements[0] * a.elements[3] - a.elements[2] * a.elements[1];
+	}
+
+	affine2 affine2::inverse(const affine2& a) {
+		const float det{ determinant(a) };
+		if (det == 0.f) {
+			MARMATH_DIAGNOSE(SingularInverse, "affine2::inverse - determinant is equal to 0!");
+		}
+
+		const float invDet{ 1.f / det };
+		affine2 rtn;
+		rtn.elements[0] = a.elements[3] * invDet;
+		rtn.elements[1] = -a.elements[1] * invDet;
+		rtn.elements[2] = -a.elements[2] * invDet;
+		rtn.elements[3] = a.elements[0] * invDet;
+		rtn.elements[4] = -(rtn.elements[0] * a.elements[4] + rtn.elements[2] * a.elements[5]);
+		rtn.elements[5] = -(rtn.elements[1] * a.elements[4] + rtn.elements[3] * a.elements[5]);
+		return rtn;
+	}
+
+	mat3 affine2::toMat3() const {
+		mat3 rtn(1.f);
+		for (size_t col = 0; col < 3; col++) {
+			rtn.elements[0 + col * 3] = elements[0 + col * 2];
+			rtn.elements[1 + col * 3] = elements[1 + col * 2];
+		}
+		return rtn;
+	}
+
+	mat4 affine2::toMat4() const {
+		mat4 rtn(1.f);
+		rtn.elements[0 + 0 * 4] = elements[0];
+		rtn.elements[1 + 0 * 4] = elements[1];
+		rtn.elements[0 + 1 * 4] = elements[2];
+		rtn.elements[1 + 1 * 4] = elements[3];
+		rtn.elements[0 + 3 * 4] = elements[4];
+		rtn.elements[1 + 3 * 4] = elements[5];
+		return rtn;
+	}
+
+	affine2 operator*(const affine2& left, const affine2& right) {
+		return left.multiply(right);
+	}
+
+	vec2 operator*(const affine2& left, vec2 right) {
+		return left.transformPoint(right);
+	}
+
+	bool affine2::operator==(const affine2& right) const {
+		for (size_t i = 0; i < 6; i++) {
+			if (elements[i] != right.elements[i]) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool affine2::operator!=(const affine2& right) const {
+		return !(*this == right);
+	}
+
+
+}
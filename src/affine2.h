@@ -0,0 +1,189 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_AFFINE2_H
+#define MAR_MATH_AFFINE2_H
+
+
+#include "maths.h"
+
+
+namespace marengine::maths {
+
+	struct vec2;
+	struct rotor2;
+	struct mat3;
+	struct mat4;
+
+
+	/**
+	 * \struct affine2 affine2.h "affine2.h"
+	 * \brief 2D affine transform stored as 2x3 matrix in column-major order: elements[0..1] is
+	 * transformed x axis, elements[2..3] is transformed y axis and elements[4..5] is translation.
+	 * Implicit last row is (0, 0, 1), so composing two transforms costs 12 multiplications
+	 * instead of 64 of mat4 product.
+	 */
+	struct affine2 {
+
+		/// \brief elements of affine2, column-major 2x3
+		float elements[2 * 3];
+
+
+		/// \brief Default constructor, creates identity transform.
+		affine2();
+
+		/**
+		 * \brief Constructor, that creates affine2 from its columns.
+		 * \param xAxis first column
+		 * \param yAxis second column
+		 * \param translation third column
+		 */
+		affine2(vec2 xAxis, vec2 yAxis, vec2 translation);
+
+		/**
+		 * \brief Static method to create identity transform.
+		 * \return identity transform
+		 */
+		static affine2 identity();
+
+		/**
+		 * \brief Creates translation transform.
+		 * \param trans translation
+		 * \return created transform
+		 */
+		static affine2 translation(vec2 trans);
+
+		/**
+		 * \brief Creates counter-clockwise rotation transform.
+		 * \param radians angle in radians
+		 * \return created transform
+		 */
+		static affine2 rotation(float radians);
+
+		/**
+		 * \brief Creates rotation transform from rotor2.
+		 * \param r rotation
+		 * \return created transform
+		 */
+		static affine2 rotation(rotor2 r);
+
+		/**
+		 * \brief Creates scale transform.
+		 * \param scal scale along x and y
+		 * \return created transform
+		 */
+		static affine2 scale(vec2 scal);
+
+		/**
+		 * \brief Creates translation * rotation * scale transform directly, without products.
+		 * \param trans translation
+		 * \param r rotation
+		 * \param scal scale
+		 * \return created transform
+		 */
+		static affine2 compose(vec2 trans, rotor2 r, vec2 scal);
+
+		/**
+		 * \brief Creates 2D orthographic projection, which maps given rectangle to <-1;1>, same
+		 * as mat4::orthographic restricted to x and y.
+		 * \param left left side of rectangle
+		 * \param right right side of rectangle
+		 * \param top top side of rectangle
+		 * \param bottom bottom side of rectangle
+		 * \return created transform
+		 */
+		static affine2 orthographic(float left, float right, float top, float bottom);
+
+		/**
+		 * \brief Multiplication method of affine2 and affine2.
+		 * \param other transform applied first
+		 * \return *this * other
+		 */
+		affine2 multiply(const affine2& other) const;
+
+		/**
+		 * \brief Transforms point (translation is applied).
+		 * \param point point, which will be transformed
+		 * \return transformed point
+		 */
+		vec2 transformPoint(vec2 point) const;
+
+		/**
+		 * \brief Transforms direction (translation is not applied).
+		 * \param vector direction, which will be transformed
+		 * \return transformed direction
+		 */
+		vec2 transformVector(vec2 vector) const;
+
+		/**
+		 * \brief Transforms array of points, large arrays are split with parallel::forEach.
+		 * In and out may be the same array.
+		 * \param transform transform applied to every point
+		 * \param in array of points
+		 * \param out array, to which transformed points will be written
+		 * \param count count of points
+		 */
+		static void transformPoints(const affine2& transform, const vec2* in, vec2* out, size_t count);
+
+		/**
+		 * \brief Computes determinant of linear part.
+		 * \param a transform
+		 * \return calculated determinant
+		 */
+		static float determinant(const affine2& a);
+
+		/**
+		 * \brief Computes inverse transform.
+		 * \param a transform, which will be inverted
+		 * \return inverted transform
+		 */
+		static affine2 inverse(const affine2& a);
+
+		/**
+		 * \brief Widens affine2 to mat3 (homogeneous 2D matrix).
+		 * \return created mat3
+		 */
+		mat3 toMat3() const;
+
+		/**
+		 * \brief Widens affine2 to mat4 acting on x and y, z and w are left untouched.
+		 * \return created mat4
+		 */
+		mat4 toMat4() const;
+
+		/// \brief self-explanatory
+		friend affine2 operator*(const affine2& left, const affine2& right);
+		/// \brief self-explanatory
+		friend vec2 operator*(const affine2& left, vec2 right);
+		/// \brief self-explanatory
+		bool operator==(const affine2& right) const;
+		/// \brief self-explanatory
+		bool operator!=(const affine2& right) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_AFFINE2_H
@@ -0,0 +1,341 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "archive.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+#include "dvec3.h"
+#include "quat.h"
+#include "mat4.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	static constexpr char g_archiveMagic[4]{ 'M', 'A', 'R', 'A' };
+	static constexpr uint32_t g_archiveEndianness{ 0x01020304 };
+
+	static uint64_t alignUp(uint64_t value) {
+		return (value + archive::alignment - 1) & ~(archive::alignment - 1);
+	}
+
+	static uint64_t elementSizeOf(archiveType type) {
+		switch (type) {
+		case archiveType::Float: return sizeof(float);
+		case archiveType::Vec2: return sizeof(vec2);
+		case archiveType::Vec3: return sizeof(vec3);
+		case archiveType::Vec4: return sizeof(vec4);
+		case archiveType::Quat: return sizeof(quat);
+		case archiveType::Mat4: return sizeof(mat4);
+		case archiveType::Dvec3: return sizeof(dvec3);
+		}
+		return 0;
+	}
+
+	// Every term is checked against remaining space before it is combined with others,
+	// so corrupted counts or offsets cannot wrap around uint64_t and pass the check.
+	static bool chunkFits(const archiveChunk& c, uint64_t fileSize) {
+		if (c.elementSize == 0 || c.elementSize != elementSizeOf(c.type) || c.lanes < 1 || c.offset > fileSize) {
+			return false;
+		}
+		const uint64_t available{ fileSize - c.offset };
+		if (c.count > available / c.elementSize) {
+			return false;
+		}
+		const uint64_t laneSize{ c.count * c.elementSize };
+		if (c.lanes == 1) {
+			return true;
+		}
+		return c.laneStride >= laneSize && c.laneStride != 0 && (uint64_t)(c.lanes - 1) <= (available - laneSize) / c.laneStride;
+	}
+
+	static bool writePadding(FILE* file, uint64_t& position, uint64_t target) {
+		static const unsigned char zeros[archive::alignment]{};
+		while (position < target) {
+			const size_t n{ (size_t)std::min<uint64_t>(target - position, archive::alignment) };
+			if (fwrite(zeros, 1, n, file) != n) {
+				return false;
+			}
+			position += n;
+		}
+		return true;
+	}
+
+
+	void archiveWriter::addSoA(const char* name, const float* const* lanes, size_t laneCount, size_t count) {
+		std::vector<const void*> pointers(lanes, lanes + laneCount);
+		addChunk(name, archiveType::Float, sizeof(float), pointers.data(), laneCount, count);
+	}
+
+	void archiveWriter::addChunk(const char* name, archiveType type, size_t elementSize, const void* const* lanes, size_t laneCount, size_t count) {
+		pendingChunk pending{};
+		// name is zero-initialized, so copying at most sizeof - 1 bytes keeps it terminated
+		memcpy(pending.chunk.name, name, std::min(strlen(name), sizeof(pending.chunk.name) - 1));
+		pending.chunk.type = type;
+		pending.chunk.elementSize = (uint32_t)elementSize;
+		pending.chunk.count = count;
+		pending.chunk.lanes = (uint32_t)laneCount;
+		pending.lanes.assign(lanes, lanes + laneCount);
+		m_chunks.push_back(pending);
+	}
+
+	bool archiveWriter::write(const char* path, bool checksums) const {
+		// layout: header | chunk table | aligned lanes of every chunk
+		std::vector<archiveChunk> table;
+		uint64_t position{ alignUp(sizeof(archiveHeader) + m_chunks.size() * sizeof(archiveChunk)) };
+		for (const pendingChunk& pending : m_chunks) {
+			archiveChunk chunk{ pending.chunk };
+			const uint64_t laneSize{ chunk.count * chunk.elementSize };
+			chunk.offset = position;
+			chunk.laneStride = chunk.lanes > 1 ? alignUp(laneSize) : 0;
+			chunk.hasChecksum = checksums ? 1 : 0;
+			chunk.checksum = 0;
+			if (checksums) {
+				uint64_t sum{ archive::checksum(nullptr, 0) };
+				for (const void* lane : pending.lanes) {
+					sum = archive::checksum(lane, (size_t)laneSize, sum);
+				}
+				chunk.checksum = sum;
+			}
+			position = alignUp(position + (chunk.lanes - 1) * chunk.laneStride + laneSize);
+			table.push_back(chunk);
+		}
+
+		archiveHeader header{};
+		memcpy(header.magic, g_archiveMagic, sizeof(header.magic));
+		header.endianness = g_archiveEndianness;
+		header.versionMajor = archive::versionMajor;
+		header.versionMinor = archive::versionMinor;
+		header.chunkCount = (uint32_t)table.size();
+		header.chunkTableOffset = sizeof(archiveHeader);
+		header.fileSize = position;
+
+#ifdef _WIN32
+		FILE* file{ nullptr };
+		if (fopen_s(&file, path, "wb") != 0) {
+			file = nullptr;
+		}
+#else
+		FILE* file{ fopen(path, "wb") };
+#endif
+		if (!file) {
+			return false;
+		}
+
+		bool written{ fwrite(&header, sizeof(header), 1, file) == 1 };
+		if (written && !table.empty()) {
+			written = fwrite(table.data(), sizeof(archiveChunk), table.size(), file) == table.size();
+		}
+		uint64_t current{ sizeof(archiveHeader) + table.size() * sizeof(archiveChunk) };
+		for (size_t i = 0; written && i < table.size(); i++) {
+			const archiveChunk& chunk{ table[i] };
+			const size_t laneSize{ (size_t)(chunk.count * chunk.elementSize) };
+			for (size_t lane = 0; written && lane < chunk.lanes; lane++) {
+				written = writePadding(file, current, chunk.offset + lane * chunk.laneStride);
+				if (written && laneSize != 0) {
+					written = fwrite(m_chunks[i].lanes[lane], 1, laneSize, file) == laneSize;
+				}
+				current += laneSize;
+			}
+		}
+		written = written && writePadding(file, current, header.fileSize);
+
+		return fclose(file) == 0 && written;
+	}
+
+
+	archive::~archive() {
+		close();
+	}
+
+	bool archive::open(const char* path, bool verifyChecksums) {
+		close();
+
+#ifdef _WIN32
+		const HANDLE file{ CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+		const HANDLE mapping{ CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+		CloseHandle(file);
+		if (!mapping) {
+			return false;
+		}
+		void* view{ MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) };
+		if (!view) {
+			CloseHandle(mapping);
+			return false;
+		}
+		m_handle = mapping;
+		m_data = (const unsigned char*)view;
+		m_size = (size_t)size.QuadPart;
+#else
+		const int file{ ::open(path, O_RDONLY) };
+		if (file < 0) {
+			return false;
+		}
+		struct stat info;
+		if (fstat(file, &info) != 0 || info.st_size == 0) {
+			::close(file);
+			return false;
+		}
+		void* view{ mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0) };
+		::close(file);
+		if (view == MAP_FAILED) {
+			return false;
+		}
+		m_data = (const unsigned char*)view;
+		m_size = (size_t)info.st_size;
+#endif
+
+		const archiveHeader* header{ (const archiveHeader*)m_data };
+		const bool validHeader{
+			m_size >= sizeof(archiveHeader) &&
+			memcmp(header->magic, g_archiveMagic, sizeof(header->magic)) == 0 &&
+			header->endianness == g_archiveEndianness &&
+			header->versionMajor == versionMajor &&
+			header->fileSize == m_size &&
+			header->chunkTableOffset % alignof(archiveChunk) == 0 &&
+			header->chunkTableOffset >= sizeof(archiveHeader) &&
+			(uint64_t)header->chunkCount <= m_size / sizeof(archiveChunk) &&
+			header->chunkTableOffset <= m_size - (uint64_t)header->chunkCount * sizeof(archiveChunk)
+		};
+		if (!validHeader) {
+			close();
+			return false;
+		}
+
+		for (size_t i = 0; i < chunkCount(); i++) {
+			const archiveChunk& c{ chunk(i) };
+			if (c.offset % alignment != 0 || !chunkFits(c, m_size)) {
+				close();
+				return false;
+			}
+			if (verifyChecksums && c.hasChecksum) {
+				const size_t laneSize{ (size_t)(c.count * c.elementSize) };
+				uint64_t sum{ checksum(nullptr, 0) };
+				for (size_t lane = 0; lane < c.lanes; lane++) {
+					sum = checksum(m_data + c.offset + lane * c.laneStride, laneSize, sum);
+				}
+				if (sum != c.checksum) {
+					close();
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void archive::close() {
+		if (!m_data) {
+			return;
+		}
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_handle);
+#else
+		munmap((void*)m_data, m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+		m_handle = nullptr;
+	}
+
+	size_t archive::chunkCount() const {
+		if (!m_data) {
+			return 0;
+		}
+		return ((const archiveHeader*)m_data)->chunkCount;
+	}
+
+	const archiveChunk& archive::chunk(size_t index) const {
+		const archiveHeader* header{ (const archiveHeader*)m_data };
+		return ((const archiveChunk*)(m_data + header->chunkTableOffset))[index];
+	}
+
+	const archiveChunk* archive::find(const char* name) const {
+		for (size_t i = 0; i < chunkCount(); i++) {
+			if (strncmp(chunk(i).name, name, sizeof(archiveChunk::name)) == 0) {
+				return &chunk(i);
+			}
+		}
+		return nullptr;
+	}
+
+	const float* archive::getLane(const char* name, size_t laneIndex, size_t& count) const {
+		return (const float*)lane(name, archiveType::Float, sizeof(float), laneIndex, count);
+	}
+
+	const void* archive::lane(const char* name, archiveType type, size_t elementSize, size_t laneIndex, size_t& count) const {
+		count = 0;
+		const archiveChunk* c{ find(name) };
+		if (!c || c->type != type || c->elementSize != elementSize || laneIndex >= c->lanes) {
+			return nullptr;
+		}
+		count = (size_t)c->count;
+		return m_data + c->offset + laneIndex * c->laneStride;
+	}
+
+	uint64_t archive::checksum(const void* data, size_t size, uint64_t seed) {
+		constexpr uint64_t prime{ 1099511628211ull };
+		const unsigned char* bytes{ (const unsigned char*)data };
+		uint64_t hash{ seed };
+		size_t i{ 0 };
+		for (; i + 8 <= size; i += 8) {
+			uint64_t word;
+			memcpy(&word, bytes + i, sizeof(word));
+			hash = (hash ^ word) * prime;
+		}
+		for (; i < size; i++) {
+			hash = (hash ^ bytes[i]) * prime;
+		}
+		return hash;
+	}
+
+
+}
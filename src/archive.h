@@ -0,0 +1,263 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_ARCHIVE_H
+#define MAR_MATH_ARCHIVE_H
+
+
+#include "maths.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace marengine::maths {
+
+	struct vec2;
+	struct vec3;
+	struct vec4;
+	struct dvec3;
+	struct quat;
+	struct mat4;
+
+
+	/**
+	 * \brief Type of elements stored in archive chunk.
+	 */
+	enum class archiveType : uint32_t {
+		Float = 1,
+		Vec2 = 2,
+		Vec3 = 3,
+		Vec4 = 4,
+		Quat = 5,
+		Mat4 = 6,
+		Dvec3 = 7
+	};
+
+	/// \brief Maps C++ type to archiveType, specialized for every type, which can be stored.
+	template<typename T> struct archiveTypeOf;
+	template<> struct archiveTypeOf<float> { static constexpr archiveType value{ archiveType::Float }; };
+	template<> struct archiveTypeOf<vec2> { static constexpr archiveType value{ archiveType::Vec2 }; };
+	template<> struct archiveTypeOf<vec3> { static constexpr archiveType value{ archiveType::Vec3 }; };
+	template<> struct archiveTypeOf<vec4> { static constexpr archiveType value{ archiveType::Vec4 }; };
+	template<> struct archiveTypeOf<quat> { static constexpr archiveType value{ archiveType::Quat }; };
+	template<> struct archiveTypeOf<mat4> { static constexpr archiveType value{ archiveType::Mat4 }; };
+	template<> struct archiveTypeOf<dvec3> { static constexpr archiveType value{ archiveType::Dvec3 }; };
+
+
+	/**
+	 * \struct archiveHeader archive.h "archive.h"
+	 * \brief Header placed at the beginning of every archive file. All offsets are in bytes from
+	 * the beginning of file. Data is stored in native layout of writing machine, endianness tells,
+	 * if it can be used in place (archive::open refuses files with different endianness).
+	 */
+	struct archiveHeader {
+		/// \brief "MARA" characters
+		char magic[4];
+		/// \brief 0x01020304 written in native byte order
+		uint32_t endianness;
+		/// \brief major version, archive::open refuses files with different major version
+		uint16_t versionMajor;
+		/// \brief minor version, bumped on backward compatible changes
+		uint16_t versionMinor;
+		/// \brief count of archiveChunk entries in chunk table
+		uint32_t chunkCount;
+		/// \brief offset of chunk table
+		uint64_t chunkTableOffset;
+		/// \brief size of whole file, used to detect truncated files
+		uint64_t fileSize;
+	};
+
+	/**
+	 * \struct archiveChunk archive.h "archive.h"
+	 * \brief Description of single array stored in archive. AoS chunks have one lane, SoA chunks
+	 * have lanes component arrays of count floats, every lane starts at offset + lane * laneStride.
+	 * Offset of every lane is aligned to archive::alignment.
+	 */
+	struct archiveChunk {
+		/// \brief null-terminated name of chunk
+		char name[48];
+		/// \brief type of every element
+		archiveType type;
+		/// \brief sizeof(element) on writing machine, archive refuses to map chunks with different size
+		uint32_t elementSize;
+		/// \brief count of elements (in every lane)
+		uint64_t count;
+		/// \brief count of lanes, 1 for AoS arrays
+		uint32_t lanes;
+		/// \brief 1 if checksum is valid
+		uint32_t hasChecksum;
+		/// \brief offset of first element
+		uint64_t offset;
+		/// \brief distance in bytes between lanes (0 for AoS arrays)
+		uint64_t laneStride;
+		/// \brief archive::checksum of all lanes
+		uint64_t checksum;
+	};
+
+
+	/**
+	 * \struct archiveWriter archive.h "archive.h"
+	 * \brief archiveWriter collects arrays and writes them into versioned, aligned binary file,
+	 * which can be memory-mapped with archive. Writer doesn't copy data, so every added
+	 * array must stay alive until write() is called.
+	 */
+	struct archiveWriter {
+
+		/**
+		 * \brief Adds array of elements (AoS) to archive.
+		 * \param name name of chunk (max 47 characters), must be unique
+		 * \param data pointer to first element
+		 * \param count count of elements
+		 */
+		template<typename T>
+		void add(const char* name, const T* data, size_t count) {
+			const void* lanes[1]{ data };
+			addChunk(name, archiveTypeOf<T>::value, sizeof(T), lanes, 1, count);
+		}
+
+		/**
+		 * \brief Adds SoA layout of floats (ex: positions.x, positions.y, positions.z) to archive.
+		 * \param name name of chunk (max 47 characters), must be unique
+		 * \param lanes array of laneCount pointers to component arrays
+		 * \param laneCount count of component arrays
+		 * \param count count of floats in every component array
+		 */
+		void addSoA(const char* name, const float* const* lanes, size_t laneCount, size_t count);
+
+		/**
+		 * \brief Writes archive to file.
+		 * \param path path to file, which will be created or overwritten
+		 * \param checksums if true, checksum of every chunk is computed and stored
+		 * \return true if whole file was written
+		 */
+		bool write(const char* path, bool checksums = true) const;
+
+	private:
+
+		struct pendingChunk {
+			archiveChunk chunk;
+			std::vector<const void*> lanes;
+		};
+
+		void addChunk(const char* name, archiveType type, size_t elementSize, const void* const* lanes, size_t laneCount, size_t count);
+
+		std::vector<pendingChunk> m_chunks;
+
+	};
+
+
+	/**
+	 * \struct archive archive.h "archive.h"
+	 * \brief archive memory-maps file written by archiveWriter and gives pointers directly into
+	 * mapping, so no parsing and no copying is done. Pointers are valid until close() or destruction.
+	 */
+	struct archive {
+
+		/// \brief alignment of every chunk (and lane) in file
+		static constexpr uint64_t alignment{ 64 };
+		/// \brief major version written by this library
+		static constexpr uint16_t versionMajor{ 1 };
+		/// \brief minor version written by this library
+		static constexpr uint16_t versionMinor{ 0 };
+
+		archive() = default;
+		archive(const archive&) = delete;
+		archive& operator=(const archive&) = delete;
+		~archive();
+
+		/**
+		 * \brief Maps file into memory and validates header (magic, endianness, major version, size, chunk table)
+		 * and every chunk (element size matching its type, all lanes inside of file).
+		 * \param path path to file
+		 * \param verifyChecksums if true, checksum of every chunk, that has it, is verified (touches whole file!)
+		 * \return true if file is mapped and valid
+		 */
+		bool open(const char* path, bool verifyChecksums = false);
+
+		/// \brief Unmaps file, every pointer returned earlier becomes invalid.
+		void close();
+
+		/**
+		 * \brief Returns count of chunks in archive.
+		 * \return count of chunks
+		 */
+		size_t chunkCount() const;
+
+		/**
+		 * \brief Returns chunk description at index. Make sure, that index is in range <0;chunkCount)!
+		 * \param index index of chunk
+		 * \return chunk description
+		 */
+		const archiveChunk& chunk(size_t index) const;
+
+		/**
+		 * \brief Finds chunk with given name.
+		 * \param name name of chunk
+		 * \return pointer to chunk description or nullptr, if there is no such chunk
+		 */
+		const archiveChunk* find(const char* name) const;
+
+		/**
+		 * \brief Returns array stored in AoS chunk with given name, if its type and element size matches T.
+		 * \param name name of chunk
+		 * \param count reference, to which count of elements will be written (0 on failure)
+		 * \return pointer to first element inside mapping or nullptr
+		 */
+		template<typename T>
+		const T* get(const char* name, size_t& count) const {
+			return (const T*)lane(name, archiveTypeOf<T>::value, sizeof(T), 0, count);
+		}
+
+		/**
+		 * \brief Returns component array of SoA chunk with given name.
+		 * \param name name of chunk
+		 * \param laneIndex index of component array
+		 * \param count reference, to which count of floats will be written (0 on failure)
+		 * \return pointer to first float of lane inside mapping or nullptr
+		 */
+		const float* getLane(const char* name, size_t laneIndex, size_t& count) const;
+
+		/**
+		 * \brief Computes checksum used by archive (64-bit FNV-1a over 8-byte words, then remaining bytes).
+		 * \param data pointer to data
+		 * \param size size of data in bytes
+		 * \param seed previous checksum, when data is split into parts
+		 * \return computed checksum
+		 */
+		static uint64_t checksum(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+	private:
+
+		const void* lane(const char* name, archiveType type, size_t elementSize, size_t laneIndex, size_t& count) const;
+
+		const unsigned char* m_data{ nullptr };
+		size_t m_size{ 0 };
+		void* m_handle{ nullptr };
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_ARCHIVE_H
@@ -21,6 +21,12 @@
 
 
 #include "basic.h"
+#include <cmath>
+#include <cfloat>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
 
 
 namespace marengine::maths {
@@ -30,6 +36,39 @@ namespace marengine::maths {
 		return sqrt(val);
 	}
 
+#if MARMATH_SIMD_SSE
+	// y = y * (1.5 - 0.5 * val * y * y), doubles precision of hardware estimate.
+	// For val below FLT_MIN (zero or denormal, which the estimate flushes to zero) estimate is +inf
+	// and for val equal to inf it is 0, in both cases step would give 0 * inf = NaN, so estimate is kept.
+	static __m128 rsqrtNewtonRaphson(__m128 val) {
+		const __m128 estimate{ _mm_rsqrt_ps(val) };
+		const __m128 halfVal{ _mm_mul_ps(_mm_set1_ps(0.5f), val) };
+		const __m128 correction{ _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfVal, _mm_mul_ps(estimate, estimate))) };
+		const __m128 keepEstimate{ _mm_or_ps(_mm_cmplt_ps(val, _mm_set1_ps(FLT_MIN)), _mm_cmpeq_ps(val, _mm_set1_ps(INFINITY))) };
+		return _mm_or_ps(_mm_and_ps(keepEstimate, estimate), _mm_andnot_ps(keepEstimate, _mm_mul_ps(estimate, correction)));
+	}
+#endif
+
+	float basic::rsqrt(float val) {
+#if MARMATH_SIMD_SSE
+		return _mm_cvtss_f32(rsqrtNewtonRaphson(_mm_set_ss(val)));
+#else
+		return 1.f / sqrt(val);
+#endif
+	}
+
+	void basic::rsqrtMany(const float* in, float* out, size_t count) {
+		size_t i{ 0 };
+#if MARMATH_SIMD_SSE
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(out + i, rsqrtNewtonRaphson(_mm_loadu_ps(in + i)));
+		}
+#endif
+		for (; i < count; i++) {
+			out[i] = rsqrt(in[i]);
+		}
+	}
+
 	float basic::power(float val) {
 		return val * val;
 	}
@@ -44,6 +44,26 @@ namespace marengine::maths {
 		 */
 		static float square(float val);
 
+		/**
+		 * \brief Calculates reciprocal square root 1 / sqrt(val). With SSE it uses hardware
+		 * estimate refined with one Newton-Raphson step, relative error is below 5e-7
+		 * (about 4 ulp) for every positive normal float. Without SSE exact 1.f / sqrt(val) is used.
+		 * For val equal to 0.f it returns infinity and for infinite val it returns 0.f. Denormal val
+		 * returns infinity with SSE (hardware estimate treats it as 0.f) and exact value without it.
+		 * \param val value, of which reciprocal square root will be computed
+		 * \return float - calculated 1 / sqrt(val)
+		 */
+		static float rsqrt(float val);
+
+		/**
+		 * \brief Calculates reciprocal square root of every value in array, with the same
+		 * precision as basic::rsqrt. Computes 4 values at once. In and out may be the same array.
+		 * \param in array of values
+		 * \param out array, to which results will be written
+		 * \param count count of values
+		 */
+		static void rsqrtMany(const float* in, float* out, size_t count);
+
 		/**
 		 * \brief Calculates power of given value.
 		 * 
@@ -0,0 +1,225 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "camera.h"
+#include "parallel.h"
+
+
+namespace marengine::maths {
+
+
+	static bool equalParameters(const float* left, const float* right, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			if (left[i] != right[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+	camera::camera() :
+		m_view(1.f),
+		m_projection(1.f),
+		m_viewProjection(1.f),
+		m_inverseView(1.f),
+		m_inverseProjection(1.f),
+		m_inverseViewProjection(1.f),
+		m_frustum(),
+		m_eye(),
+		m_center(),
+		m_up(),
+		m_projectionParameters(),
+		m_projectionKind(projectionKind::Custom),
+		m_dirty(DirtyFrustum),
+		m_rigidView(false),
+		m_zeroToOne(false)
+	{}
+
+	void camera::markDirty(uint32_t bits) {
+		m_dirty |= bits;
+	}
+
+	void camera::setPerspective(float fov, float aspectRatio, float near, float far) {
+		const float parameters[6]{ fov, aspectRatio, near, far, 0.f, 0.f };
+		if (m_projectionKind == projectionKind::Perspective && equalParameters(parameters, m_projectionParameters, 6)) {
+			return;
+		}
+		for (size_t i = 0; i < 6; i++) {
+			m_projectionParameters[i] = parameters[i];
+		}
+		m_projectionKind = projectionKind::Perspective;
+		m_zeroToOne = false;
+		markDirty(DirtyAfterProjection);
+	}
+
+	void camera::setOrthographic(float left, float right, float top, float bottom, float near, float far) {
+		const float parameters[6]{ left, right, top, bottom, near, far };
+		if (m_projectionKind == projectionKind::Orthographic && equalParameters(parameters, m_projectionParameters, 6)) {
+			return;
+		}
+		for (size_t i = 0; i < 6; i++) {
+			m_projectionParameters[i] = parameters[i];
+		}
+		m_projectionKind = projectionKind::Orthographic;
+		m_zeroToOne = false;
+		markDirty(DirtyAfterProjection);
+	}
+
+	void camera::setProjection(const mat4& projection, bool zeroToOne) {
+		const bool unchanged{ m_projectionKind == projectionKind::Custom && !(m_dirty & DirtyProjection) &&
+			m_zeroToOne == zeroToOne && equalParameters(projection.elements, m_projection.elements, 16) };
+		if (unchanged) {
+			return;
+		}
+		m_projection = projection;
+		m_projectionKind = projectionKind::Custom;
+		m_zeroToOne = zeroToOne;
+		markDirty(DirtyAfterProjection);
+		m_dirty &= ~(uint32_t)DirtyProjection;
+	}
+
+	void camera::setLookAt(vec3 eye, vec3 center, vec3 up) {
+		if (m_rigidView && eye == m_eye && center == m_center && up == m_up) {
+			return;
+		}
+		m_eye = eye;
+		m_center = center;
+		m_up = up;
+		m_rigidView = true;
+		markDirty(DirtyAfterView);
+	}
+
+	void camera::setView(const mat4& view) {
+		const bool unchanged{ !m_rigidView && !(m_dirty & DirtyView) && equalParameters(view.elements, m_view.elements, 16) };
+		if (unchanged) {
+			return;
+		}
+		m_view = view;
+		m_rigidView = false;
+		markDirty(DirtyAfterView);
+		m_dirty &= ~(uint32_t)DirtyView;
+	}
+
+	const mat4& camera::getView() {
+		if (m_dirty & DirtyView) {
+			m_view = mat4::lookAt(m_eye, m_center, m_up);
+			m_dirty &= ~(uint32_t)DirtyView;
+		}
+		return m_view;
+	}
+
+	const mat4& camera::getProjection() {
+		if (m_dirty & DirtyProjection) {
+			const float* p{ m_projectionParameters };
+			if (m_projectionKind == projectionKind::Perspective) {
+				m_projection = mat4::perspective(p[0], p[1], p[2], p[3]);
+			}
+			else if (m_projectionKind == projectionKind::Orthographic) {
+				m_projection = mat4::orthographic(p[0], p[1], p[2], p[3], p[4], p[5]);
+			}
+			m_dirty &= ~(uint32_t)DirtyProjection;
+		}
+		return m_projection;
+	}
+
+	const mat4& camera::getViewProjection() {
+		if (m_dirty & DirtyViewProjection) {
+			m_viewProjection = getProjection() * getView();
+			m_dirty &= ~(uint32_t)DirtyViewProjection;
+		}
+		return m_viewProjection;
+	}
+
+	const mat4& camera::getInverseView() {
+		if (m_dirty & DirtyInverseView) {
+			const mat4& v{ getView() };
+			if (m_rigidView) {
+				// orthonormal rotation, inverse is transposed rotation and rotated negative translation
+				mat4 inv(1.f);
+				for (size_t row = 0; row < 3; row++) {
+					for (size_t col = 0; col < 3; col++) {
+						inv.elements[row + col * 4] = v.elements[col + row * 4];
+					}
+				}
+				for (size_t row = 0; row < 3; row++) {
+					inv.elements[row + 3 * 4] = -(inv.elements[row + 0 * 4] * v.elements[0 + 3 * 4] +
+						inv.elements[row + 1 * 4] * v.elements[1 + 3 * 4] + inv.elements[row + 2 * 4] * v.elements[2 + 3 * 4]);
+				}
+				m_inverseView = inv;
+			}
+			else {
+				m_inverseView = mat4::inverse(v);
+			}
+			m_dirty &= ~(uint32_t)DirtyInverseView;
+		}
+		return m_inverseView;
+	}
+
+	const mat4& camera::getInverseProjection() {
+		if (m_dirty & DirtyInverseProjection) {
+			m_inverseProjection = mat4::inverse(getProjection());
+			m_dirty &= ~(uint32_t)DirtyInverseProjection;
+		}
+		return m_inverseProjection;
+	}
+
+	const mat4& camera::getInverseViewProjection() {
+		if (m_dirty & DirtyInverseViewProjection) {
+			m_inverseViewProjection = getInverseView() * getInverseProjection();
+			m_dirty &= ~(uint32_t)DirtyInverseViewProjection;
+		}
+		return m_inverseViewProjection;
+	}
+
+	const frustum& camera::getFrustum() {
+		if (m_dirty & DirtyFrustum) {
+			m_frustum = frustum::fromMatrix(getViewProjection(), m_zeroToOne);
+			m_dirty &= ~(uint32_t)DirtyFrustum;
+		}
+		return m_frustum;
+	}
+
+	void camera::update() {
+		if (m_dirty == 0) {
+			return;
+		}
+		getInverseViewProjection();
+		getFrustum();
+	}
+
+	bool camera::isDirty() const {
+		return m_dirty != 0;
+	}
+
+	void camera::updateMany(camera* cameras, size_t count) {
+		constexpr size_t camerasPerTask{ 16 };
+		parallel::forEach(count, camerasPerTask, [cameras](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				cameras[i].update();
+			}
+		});
+	}
+
+
+}
@@ -0,0 +1,164 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_CAMERA_H
+#define MAR_MATH_CAMERA_H
+
+
+#include "maths.h"
+#include "vec3.h"
+#include "mat4.h"
+#include "frustum.h"
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct camera camera.h "camera.h"
+	 * \brief camera keeps inputs of view and projection and caches matrices derived from them:
+	 * view, projection, view-projection, their inverses and frustum planes. Setters compare new
+	 * inputs with stored ones and mark dirty only what depends on changed inputs, getters
+	 * recompute dirty parts lazily. Calling setters every frame with unchanged values costs
+	 * only comparisons.
+	 */
+	struct camera {
+
+		/// \brief Default constructor, creates camera with identity view and projection.
+		camera();
+
+		/**
+		 * \brief Sets perspective projection, see mat4::perspective.
+		 * \param fov field of view in radians
+		 * \param aspectRatio aspect ratio
+		 * \param near near plane distance
+		 * \param far far plane distance
+		 */
+		void setPerspective(float fov, float aspectRatio, float near, float far);
+
+		/**
+		 * \brief Sets orthographic projection, see mat4::orthographic.
+		 * \param left distance left
+		 * \param right distance right
+		 * \param top distance up
+		 * \param bottom distance down
+		 * \param near near plane distance
+		 * \param far far plane distance
+		 */
+		void setOrthographic(float left, float right, float top, float bottom, float near, float far);
+
+		/**
+		 * \brief Sets custom projection matrix (ex: reversed-Z or jittered).
+		 * \param projection projection matrix
+		 * \param zeroToOne true, if projection maps depth to [0;1], used for frustum planes
+		 */
+		void setProjection(const mat4& projection, bool zeroToOne = false);
+
+		/**
+		 * \brief Sets view from eye position, target and up direction, see mat4::lookAt.
+		 * \param eye position of camera
+		 * \param center point, at which camera looks
+		 * \param up up direction
+		 */
+		void setLookAt(vec3 eye, vec3 center, vec3 up);
+
+		/**
+		 * \brief Sets custom view matrix.
+		 * \param view view matrix
+		 */
+		void setView(const mat4& view);
+
+		/// \brief Returns view matrix.
+		const mat4& getView();
+		/// \brief Returns projection matrix.
+		const mat4& getProjection();
+		/// \brief Returns projection * view matrix.
+		const mat4& getViewProjection();
+		/// \brief Returns inverse of view matrix (cheap transpose for lookAt views).
+		const mat4& getInverseView();
+		/// \brief Returns inverse of projection matrix.
+		const mat4& getInverseProjection();
+		/// \brief Returns inverse of view-projection matrix.
+		const mat4& getInverseViewProjection();
+		/// \brief Returns frustum planes in world space.
+		const frustum& getFrustum();
+
+		/// \brief Recomputes every dirty part, so that getters only return cached values.
+		void update();
+
+		/**
+		 * \brief Returns true, if any cached value has to be recomputed.
+		 * \return true, if update() would compute anything
+		 */
+		bool isDirty() const;
+
+		/**
+		 * \brief Updates many cameras, split across parallel::forEach.
+		 * \param cameras array of cameras
+		 * \param count count of cameras
+		 */
+		static void updateMany(camera* cameras, size_t count);
+
+	private:
+
+		enum dirtyBit : uint32_t {
+			DirtyView = 1 << 0,
+			DirtyProjection = 1 << 1,
+			DirtyViewProjection = 1 << 2,
+			DirtyInverseView = 1 << 3,
+			DirtyInverseProjection = 1 << 4,
+			DirtyInverseViewProjection = 1 << 5,
+			DirtyFrustum = 1 << 6,
+			DirtyAfterView = DirtyView | DirtyViewProjection | DirtyInverseView | DirtyInverseViewProjection | DirtyFrustum,
+			DirtyAfterProjection = DirtyProjection | DirtyViewProjection | DirtyInverseProjection | DirtyInverseViewProjection | DirtyFrustum
+		};
+
+		enum class projectionKind : uint32_t { Custom, Perspective, Orthographic };
+
+		void markDirty(uint32_t bits);
+
+		mat4 m_view;
+		mat4 m_projection;
+		mat4 m_viewProjection;
+		mat4 m_inverseView;
+		mat4 m_inverseProjection;
+		mat4 m_inverseViewProjection;
+		frustum m_frustum;
+
+		vec3 m_eye;
+		vec3 m_center;
+		vec3 m_up;
+		float m_projectionParameters[6];
+		projectionKind m_projectionKind;
+		uint32_t m_dirty;
+		bool m_rigidView;
+		bool m_zeroToOne;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_CAMERA_H
@@ -0,0 +1,150 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "convex.h"
+#include "mat4.h"
+#include "quat.h"
+#include <cmath>
+
+
+namespace marengine::maths {
+
+
+	convexShape::convexShape() :
+		type(Point),
+		halfExtents(0.f, 0.f, 0.f),
+		radius(0.f),
+		halfHeight(0.f),
+		points(nullptr),
+		pointCount(0),
+		localCenter(0.f, 0.f, 0.f),
+		linear(1.f),
+		translation(0.f, 0.f, 0.f)
+	{}
+
+	convexShape convexShape::sphere(float radius) {
+		convexShape rtn;
+		rtn.type = Sphere;
+		rtn.radius = radius;
+		return rtn;
+	}
+
+	convexShape convexShape::box(vec3 halfExtents) {
+		convexShape rtn;
+		rtn.type = Box;
+		rtn.halfExtents = halfExtents;
+		return rtn;
+	}
+
+	convexShape convexShape::capsule(float radius, float halfHeight) {
+		convexShape rtn;
+		rtn.type = Capsule;
+		rtn.radius = radius;
+		rtn.halfHeight = halfHeight;
+		return rtn;
+	}
+
+	convexShape convexShape::hull(const vec3* points, uint32_t count) {
+		convexShape rtn;
+		rtn.type = Hull;
+		rtn.points = points;
+		rtn.pointCount = count;
+		vec3 sum{ 0.f, 0.f, 0.f };
+		for (uint32_t i = 0; i < count; i++) {
+			sum = sum + points[i];
+		}
+		rtn.localCenter = count > 0 ? sum / (float)count : sum;
+		return rtn;
+	}
+
+	void convexShape::setTransform(const mat4& transform) {
+		linear = mat3(transform);
+		translation = transform.getColumn3(3);
+	}
+
+	void convexShape::setTransform(vec3 position, quat rotation) {
+		linear = mat3::fromQuat(rotation);
+		translation = position;
+	}
+
+	// Direction of length 0 gives zero vector, support of round part is then its center.
+	static vec3 scaledDirection(vec3 d, float length) {
+		const float lengthSquared{ d.x * d.x + d.y * d.y + d.z * d.z };
+		return lengthSquared > 0.f ? d * (length / std::sqrt(lengthSquared)) : vec3(0.f, 0.f, 0.f);
+	}
+
+	vec3 convexShape::support(vec3 direction) const {
+		// L^T * d, so that local support can be found.
+		const float* l{ linear.elements };
+		const vec3 d{
+			l[0] * direction.x + l[1] * direction.y + l[2] * direction.z,
+			l[3] * direction.x + l[4] * direction.y + l[5] * direction.z,
+			l[6] * direction.x + l[7] * direction.y + l[8] * direction.z
+		};
+
+		vec3 local{ 0.f, 0.f, 0.f };
+		switch (type) {
+		case Point:
+			break;
+		case Sphere:
+			local = scaledDirection(d, radius);
+			break;
+		case Box:
+			local = {
+				d.x < 0.f ? -halfExtents.x : halfExtents.x,
+				d.y < 0.f ? -halfExtents.y : halfExtents.y,
+				d.z < 0.f ? -halfExtents.z : halfExtents.z
+			};
+			break;
+		case Capsule:
+			local = scaledDirection(d, radius);
+			local.y += d.y < 0.f ? -halfHeight : halfHeight;
+			break;
+		case Hull: {
+			if (pointCount == 0) {
+				local = localCenter;
+				break;
+			}
+			float best{ vec3::dot(points[0], d) };
+			uint32_t bestIndex{ 0 };
+			for (uint32_t i = 1; i < pointCount; i++) {
+				const float projection{ vec3::dot(points[i], d) };
+				if (projection > best) {
+					best = projection;
+					bestIndex = i;
+				}
+			}
+			local = points[bestIndex];
+			break;
+		}
+		}
+
+		return linear * local + translation;
+	}
+
+	vec3 convexShape::center() const {
+		return linear * localCenter + translation;
+	}
+
+
+}
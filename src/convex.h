@@ -0,0 +1,140 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_CONVEX_H
+#define MAR_MATH_CONVEX_H
+
+
+#include "maths.h"
+#include "vec3.h"
+#include "mat3.h"
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+	struct mat4;
+	struct quat;
+
+
+	/**
+	 * \struct convexShape convex.h "convex.h"
+	 * \brief Convex shape described by its support function (the furthest point in given direction),
+	 * which is everything GJK and EPA need. Shape is defined in local space and placed in world with
+	 * linear part and translation, any linear part (rotation, scale, shear) is supported, as support
+	 * of transformed shape is L * support(L^T * d) + t.
+	 *
+	 * Shapes are plain values without virtual calls, so arrays of them can be passed to batch methods.
+	 * Hull only points to its vertices, which must outlive the shape.
+	 */
+	struct convexShape {
+
+		/// \brief Kinds of shapes.
+		enum kind : uint32_t { Point, Sphere, Box, Capsule, Hull };
+
+		/// \brief kind of shape
+		kind type;
+		/// \brief half extents of box
+		vec3 halfExtents;
+		/// \brief radius of sphere or capsule
+		float radius;
+		/// \brief half of distance between capsule sphere centers, capsule axis is local y
+		float halfHeight;
+		/// \brief local vertices of hull (not owned)
+		const vec3* points;
+		/// \brief count of hull vertices
+		uint32_t pointCount;
+		/// \brief any point inside of shape in local space
+		vec3 localCenter;
+		/// \brief linear part of local to world transform
+		mat3 linear;
+		/// \brief translation of local to world transform
+		vec3 translation;
+
+
+		/// \brief Default constructor, creates point at origin.
+		convexShape();
+
+		/**
+		 * \brief Creates sphere centered at origin.
+		 * \param radius radius of sphere
+		 * \return created shape
+		 */
+		static convexShape sphere(float radius);
+
+		/**
+		 * \brief Creates box centered at origin.
+		 * \param halfExtents half of box size along every axis
+		 * \return created shape
+		 */
+		static convexShape box(vec3 halfExtents);
+
+		/**
+		 * \brief Creates capsule centered at origin, its axis is y.
+		 * \param radius radius of capsule
+		 * \param halfHeight half of distance between centers of capsule spheres
+		 * \return created shape
+		 */
+		static convexShape capsule(float radius, float halfHeight);
+
+		/**
+		 * \brief Creates convex hull of given points (points inside of hull are allowed).
+		 * \param points array of local vertices, which must outlive the shape
+		 * \param count count of vertices, empty hull degenerates to point at local origin
+		 * \return created shape
+		 */
+		static convexShape hull(const vec3* points, uint32_t count);
+
+		/**
+		 * \brief Places shape in world with given transform.
+		 * \param transform affine local to world matrix
+		 */
+		void setTransform(const mat4& transform);
+
+		/**
+		 * \brief Places shape in world with given position and rotation.
+		 * \param position world position
+		 * \param rotation unit quaternion
+		 */
+		void setTransform(vec3 position, quat rotation);
+
+		/**
+		 * \brief Returns the furthest point of shape in given direction.
+		 * \param direction world space direction, doesn't have to be normalized
+		 * \return world space support point
+		 */
+		vec3 support(vec3 direction) const;
+
+		/**
+		 * \brief Returns world space point inside of shape.
+		 * \return center
+		 */
+		vec3 center() const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_CONVEX_H
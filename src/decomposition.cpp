@@ -0,0 +1,446 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "decomposition.h"
+#include "vec3.h"
+#include "mat3.h"
+#include "parallel.h"
+#include "diagnostics.h"
+#include "instrumentation.h"
+#include <cfloat>
+#include <cmath>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	// Cyclic Jacobi converges quadratically, five sweeps bring 3x3 float matrices to rounding level.
+	static constexpr size_t g_jacobiSweeps{ 5 };
+	static constexpr size_t g_batchElementCost{ 4 };
+
+	// Kernels below are templates over lane type. float is one matrix, float4 are four matrices in
+	// SSE registers. Both provide the same operations, so results of batches match scalar calls.
+	static bool greater(float a, float b) {
+		return a > b;
+	}
+
+	static float choose(bool mask, float a, float b) {
+		return mask ? a : b;
+	}
+
+	static float squareRoot(float f) {
+		return std::sqrt(f);
+	}
+
+	static float absolute(float f) {
+		return std::fabs(f);
+	}
+
+	static float maximum(float a, float b) {
+		return a > b ? a : b;
+	}
+
+	// Returns value with flipped sign, if s has sign bit set.
+	static float flipSign(float value, float s) {
+		return std::signbit(s) ? -value : value;
+	}
+
+#if MARMATH_SIMD_SSE
+	struct float4 {
+		__m128 v;
+
+		float4() = default;
+		float4(__m128 _v) : v(_v) {}
+		float4(float f) : v(_mm_set1_ps(f)) {}
+	};
+
+	static float4 operator+(float4 a, float4 b) { return _mm_add_ps(a.v, b.v); }
+	static float4 operator-(float4 a, float4 b) { return _mm_sub_ps(a.v, b.v); }
+	static float4 operator*(float4 a, float4 b) { return _mm_mul_ps(a.v, b.v); }
+	static float4 operator/(float4 a, float4 b) { return _mm_div_ps(a.v, b.v); }
+
+	static float4 greater(float4 a, float4 b) {
+		return _mm_cmpgt_ps(a.v, b.v);
+	}
+
+	static float4 choose(float4 mask, float4 a, float4 b) {
+		return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+	}
+
+	static float4 squareRoot(float4 f) {
+		return _mm_sqrt_ps(f.v);
+	}
+
+	static float4 absolute(float4 f) {
+		return _mm_andnot_ps(_mm_set1_ps(-0.f), f.v);
+	}
+
+	static float4 maximum(float4 a, float4 b) {
+		return _mm_max_ps(a.v, b.v);
+	}
+
+	static float4 flipSign(float4 value, float4 s) {
+		return _mm_xor_ps(value.v, _mm_and_ps(s.v, _mm_set1_ps(-0.f)));
+	}
+#endif
+
+	// Diagonalizes symmetric a in place, columns of v become eigenvectors. Eigenvalues are sorted
+	// from the largest and v is made proper rotation.
+	template<typename T>
+	static void jacobiKernel(T a[3][3], T v[3][3]) {
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				v[row][col] = T(row == col ? 1.f : 0.f);
+			}
+		}
+
+		static constexpr size_t pairs[3][2]{ { 0, 1 }, { 0, 2 }, { 1, 2 } };
+		for (size_t sweep = 0; sweep < g_jacobiSweeps; sweep++) {
+			for (const size_t* pair : pairs) {
+				const size_t p{ pair[0] };
+				const size_t q{ pair[1] };
+				// tangent of rotation angle, which zeroes a[p][q], written without division by a[p][q]
+				const T d{ a[q][q] - a[p][p] };
+				const T twice{ a[p][q] * T(2.f) };
+				const T denominator{ absolute(d) + squareRoot(d * d + twice * twice) };
+				const T t{ flipSign(twice, d) / maximum(denominator, T(FLT_MIN)) };
+				const T c{ T(1.f) / squareRoot(t * t + T(1.f)) };
+				const T s{ t * c };
+				for (size_t k = 0; k < 3; k++) {
+					const T kp{ a[k][p] };
+					const T kq{ a[k][q] };
+					a[k][p] = c * kp - s * kq;
+					a[k][q] = s * kp + c * kq;
+				}
+				for (size_t k = 0; k < 3; k++) {
+					const T pk{ a[p][k] };
+					const T qk{ a[q][k] };
+					a[p][k] = c * pk - s * qk;
+					a[q][k] = s * pk + c * qk;
+				}
+				for (size_t k = 0; k < 3; k++) {
+					const T kp{ v[k][p] };
+					const T kq{ v[k][q] };
+					v[k][p] = c * kp - s * kq;
+					v[k][q] = s * kp + c * kq;
+				}
+			}
+		}
+
+		static constexpr size_t swaps[3][2]{ { 0, 1 }, { 1, 2 }, { 0, 1 } };
+		for (const size_t* swap : swaps) {
+			const size_t i{ swap[0] };
+			const size_t j{ swap[1] };
+			const auto mask{ greater(a[j][j], a[i][i]) };
+			const T value{ a[i][i] };
+			a[i][i] = choose(mask, a[j][j], value);
+			a[j][j] = choose(mask, value, a[j][j]);
+			for (size_t k = 0; k < 3; k++) {
+				const T vi{ v[k][i] };
+				v[k][i] = choose(mask, v[k][j], vi);
+				v[k][j] = choose(mask, vi, v[k][j]);
+			}
+		}
+
+		v[0][2] = v[1][0] * v[2][1] - v[2][0] * v[1][1];
+		v[1][2] = v[2][0] * v[0][1] - v[0][0] * v[2][1];
+		v[2][2] = v[0][0] * v[1][1] - v[1][0] * v[0][1];
+	}
+
+	template<typename T>
+	static void eigenSymmetricKernel(const T m[3][3], T vectors[3][3], T values[3]) {
+		T a[3][3];
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				a[row][col] = (m[row][col] + m[col][row]) * T(0.5f);
+			}
+		}
+		jacobiKernel(a, vectors);
+		for (size_t i = 0; i < 3; i++) {
+			values[i] = a[i][i];
+		}
+	}
+
+	// Eigenvectors of transpose(m) * m give v, QR decomposition of m * v gives u and sigma
+	// (McAdams et al., Computing the Singular Value Decomposition of 3x3 matrices with minimal branching).
+	template<typename T>
+	static void svdKernel(const T m[3][3], T u[3][3], T sigma[3], T v[3][3]) {
+		T ata[3][3];
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				ata[row][col] = m[0][row] * m[0][col] + m[1][row] * m[1][col] + m[2][row] * m[2][col];
+			}
+		}
+		jacobiKernel(ata, v);
+
+		T b[3][3];
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				b[row][col] = m[row][0] * v[0][col] + m[row][1] * v[1][col] + m[row][2] * v[2][col];
+			}
+		}
+
+		// First column follows the largest singular direction, zero matrix gets x axis.
+		const T length0{ b[0][0] * b[0][0] + b[1][0] * b[1][0] + b[2][0] * b[2][0] };
+		const auto valid0{ greater(length0, T(FLT_MIN)) };
+		const T inv0{ T(1.f) / squareRoot(maximum(length0, T(FLT_MIN))) };
+		for (size_t k = 0; k < 3; k++) {
+			u[k][0] = choose(valid0, b[k][0] * inv0, T(k == 0 ? 1.f : 0.f));
+		}
+
+		// Second column is Gram-Schmidt of b1, for rank 1 matrices any perpendicular direction.
+		const T projection{ u[0][0] * b[0][1] + u[1][0] * b[1][1] + u[2][0] * b[2][1] };
+		T r[3];
+		for (size_t k = 0; k < 3; k++) {
+			r[k] = b[k][1] - u[k][0] * projection;
+		}
+		const T length1{ r[0] * r[0] + r[1] * r[1] + r[2] * r[2] };
+		const auto valid1{ greater(length1, length0 * T(1e-12f)) };
+		const auto crossX{ greater(u[1][0] * u[1][0], u[0][0] * u[0][0]) };
+		const T perpendicular[3]{
+			choose(crossX, T(0.f), T(0.f) - u[2][0]),
+			choose(crossX, u[2][0], T(0.f)),
+			choose(crossX, T(0.f) - u[1][0], u[0][0])
+		};
+		for (size_t k = 0; k < 3; k++) {
+			r[k] = choose(valid1, r[k], perpendicular[k]);
+		}
+		const T inv1{ T(1.f) / squareRoot(maximum(r[0] * r[0] + r[1] * r[1] + r[2] * r[2], T(FLT_MIN))) };
+		for (size_t k = 0; k < 3; k++) {
+			u[k][1] = r[k] * inv1;
+		}
+
+		u[0][2] = u[1][0] * u[2][1] - u[2][0] * u[1][1];
+		u[1][2] = u[2][0] * u[0][1] - u[0][0] * u[2][1];
+		u[2][2] = u[0][0] * u[1][1] - u[1][0] * u[0][1];
+
+		for (size_t col = 0; col < 3; col++) {
+			sigma[col] = u[0][col] * b[0][col] + u[1][col] * b[1][col] + u[2][col] * b[2][col];
+		}
+	}
+
+	static void load(const mat3& m, float out[3][3]) {
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				out[row][col] = m.elements[row + col * 3];
+			}
+		}
+	}
+
+	static void store(const float in[3][3], mat3& m) {
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				m.elements[row + col * 3] = in[row][col];
+			}
+		}
+	}
+
+#if MARMATH_SIMD_SSE
+	static void loadSSE(const mat3* m, float4 out[3][3]) {
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				const size_t i{ row + col * 3 };
+				out[row][col] = _mm_setr_ps(m[0].elements[i], m[1].elements[i], m[2].elements[i], m[3].elements[i]);
+			}
+		}
+	}
+
+	static void storeSSE(const float4 in[3][3], mat3* m) {
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				float lanes[4];
+				_mm_storeu_ps(lanes, in[row][col].v);
+				for (size_t k = 0; k < 4; k++) {
+					m[k].elements[row + col * 3] = lanes[k];
+				}
+			}
+		}
+	}
+
+	static void storeSSE(const float4 in[3], vec3* v) {
+		float lanes[3][4];
+		for (size_t i = 0; i < 3; i++) {
+			_mm_storeu_ps(lanes[i], in[i].v);
+		}
+		for (size_t k = 0; k < 4; k++) {
+			v[k] = { lanes[0][k], lanes[1][k], lanes[2][k] };
+		}
+	}
+#endif
+
+	void decomposition::eigenSymmetric(const mat3& m, mat3& vectors, vec3& values) {
+		float a[3][3];
+		float v[3][3];
+		float lambda[3];
+		load(m, a);
+		eigenSymmetricKernel(a, v, lambda);
+		store(v, vectors);
+		values = { lambda[0], lambda[1], lambda[2] };
+	}
+
+	void decomposition::eigenSymmetricMany(const mat3* m, mat3* vectors, vec3* values, size_t count) {
+		MARMATH_PROBE(DecompositionEigenSymmetricMany, count);
+		parallel::forEach(count, parallel::grainSize(g_batchElementCost), [m, vectors, values](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			for (; i + 4 <= end; i += 4) {
+				float4 a[3][3];
+				float4 v[3][3];
+				float4 lambda[3];
+				loadSSE(m + i, a);
+				eigenSymmetricKernel(a, v, lambda);
+				storeSSE(v, vectors + i);
+				storeSSE(lambda, values + i);
+			}
+#endif
+			for (; i < end; i++) {
+				eigenSymmetric(m[i], vectors[i], values[i]);
+			}
+			MARMATH_CHECK_FINITE(&values[begin].x, 3 * (end - begin), "decomposition::eigenSymmetricMany");
+		});
+	}
+
+	void decomposition::svd(const mat3& m, mat3& u, vec3& sigma, mat3& v) {
+		float a[3][3];
+		float left[3][3];
+		float right[3][3];
+		float s[3];
+		load(m, a);
+		svdKernel(a, left, s, right);
+		store(left, u);
+		store(right, v);
+		sigma = { s[0], s[1], s[2] };
+	}
+
+	void decomposition::svdMany(const mat3* m, mat3* u, vec3* sigma, mat3* v, size_t count) {
+		MARMATH_PROBE(DecompositionSvdMany, count);
+		parallel::forEach(count, parallel::grainSize(g_batchElementCost), [m, u, sigma, v](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			for (; i + 4 <= end; i += 4) {
+				float4 a[3][3];
+				float4 left[3][3];
+				float4 right[3][3];
+				float4 s[3];
+				loadSSE(m + i, a);
+				svdKernel(a, left, s, right);
+				storeSSE(left, u + i);
+				storeSSE(right, v + i);
+				storeSSE(s, sigma + i);
+			}
+#endif
+			for (; i < end; i++) {
+				svd(m[i], u[i], sigma[i], v[i]);
+			}
+			MARMATH_CHECK_FINITE(&sigma[begin].x, 3 * (end - begin), "decomposition::svdMany");
+		});
+	}
+
+	mat3 decomposition::polar(const mat3& m, mat3* stretch) {
+		mat3 u;
+		mat3 v;
+		vec3 sigma;
+		svd(m, u, sigma, v);
+
+		const float s[3]{ sigma.x, sigma.y, sigma.z };
+		mat3 rotation;
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				float r{ 0.f };
+				float p{ 0.f };
+				for (size_t k = 0; k < 3; k++) {
+					r += u[row + k * 3] * v[col + k * 3];
+					p += v[row + k * 3] * s[k] * v[col + k * 3];
+				}
+				rotation[row + col * 3] = r;
+				if (stretch) {
+					(*stretch)[row + col * 3] = p;
+				}
+			}
+		}
+		return rotation;
+	}
+
+	mat3 decomposition::kabsch(const vec3* from, const vec3* to, size_t count, vec3* translation) {
+		if (count == 0) {
+			if (translation) {
+				*translation = { 0.f, 0.f, 0.f };
+			}
+			return mat3::identity();
+		}
+
+		double centerFrom[3]{ 0.0, 0.0, 0.0 };
+		double centerTo[3]{ 0.0, 0.0, 0.0 };
+		for (size_t i = 0; i < count; i++) {
+			centerFrom[0] += from[i].x;
+			centerFrom[1] += from[i].y;
+			centerFrom[2] += from[i].z;
+			centerTo[0] += to[i].x;
+			centerTo[1] += to[i].y;
+			centerTo[2] += to[i].z;
+		}
+		for (size_t k = 0; k < 3; k++) {
+			centerFrom[k] /= (double)count;
+			centerTo[k] /= (double)count;
+		}
+
+		// Cross-covariance sum of (to - centerTo) * transpose(from - centerFrom), its polar rotation
+		// maximizes sum of dot(to, rotation * from).
+		double covariance[3][3]{};
+		for (size_t i = 0; i < count; i++) {
+			const double p[3]{ from[i].x - centerFrom[0], from[i].y - centerFrom[1], from[i].z - centerFrom[2] };
+			const double q[3]{ to[i].x - centerTo[0], to[i].y - centerTo[1], to[i].z - centerTo[2] };
+			for (size_t row = 0; row < 3; row++) {
+				for (size_t col = 0; col < 3; col++) {
+					covariance[row][col] += q[row] * p[col];
+				}
+			}
+		}
+		mat3 h;
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = 0; col < 3; col++) {
+				h[row + col * 3] = (float)(covariance[row][col] / (double)count);
+			}
+		}
+
+		const mat3 rotation{ polar(h) };
+		if (translation) {
+			const vec3 source{ (float)centerFrom[0], (float)centerFrom[1], (float)centerFrom[2] };
+			const vec3 target{ (float)centerTo[0], (float)centerTo[1], (float)centerTo[2] };
+			*translation = target - rotation * source;
+		}
+		return rotation;
+	}
+
+	mat3 decomposition::principalAxes(const mat3& inertia, vec3& moments) {
+		mat3 axes;
+		eigenSymmetric(inertia, axes, moments);
+		return axes;
+	}
+
+
+}
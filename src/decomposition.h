@@ -0,0 +1,117 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_DECOMPOSITION_H
+#define MAR_MATH_DECOMPOSITION_H
+
+
+#include "maths.h"
+
+
+namespace marengine::maths {
+
+	struct vec3;
+	struct mat3;
+
+
+	/**
+	 * \struct decomposition decomposition.h "decomposition.h"
+	 * \brief Decompositions of 3x3 matrices built on fixed count of cyclic Jacobi sweeps, so that every
+	 * matrix costs the same and batches can run four matrices at once in SSE registers without branches.
+	 * Returned rotations are always proper (determinant +1), reflections end up in signs of values.
+	 */
+	struct decomposition {
+
+		/**
+		 * \brief Eigen-decomposition of symmetric matrix, m = vectors * diag(values) * transpose(vectors).
+		 * \param m symmetric matrix (only its symmetric part is used)
+		 * \param vectors reference, to which rotation with unit eigenvectors in columns will be written
+		 * \param values reference, to which eigenvalues sorted from the largest will be written
+		 */
+		static void eigenSymmetric(const mat3& m, mat3& vectors, vec3& values);
+
+		/**
+		 * \brief Runs eigenSymmetric() for every matrix (four at once with SSE), large arrays are split with parallel::forEach.
+		 * \param m array of symmetric matrices
+		 * \param vectors array, to which count rotations will be written
+		 * \param values array, to which count eigenvalue triples will be written
+		 * \param count count of matrices
+		 */
+		static void eigenSymmetricMany(const mat3* m, mat3* vectors, vec3* values, size_t count);
+
+		/**
+		 * \brief Singular value decomposition, m = u * diag(sigma) * transpose(v), where u and v are rotations.
+		 * Singular values are sorted by magnitude from the largest and only the last one is negative,
+		 * if determinant of m is negative.
+		 * \param m decomposed matrix
+		 * \param u reference, to which left rotation will be written
+		 * \param sigma reference, to which singular values will be written
+		 * \param v reference, to which right rotation will be written
+		 */
+		static void svd(const mat3& m, mat3& u, vec3& sigma, mat3& v);
+
+		/**
+		 * \brief Runs svd() for every matrix (four at once with SSE), large arrays are split with parallel::forEach.
+		 * \param m array of decomposed matrices
+		 * \param u array, to which count left rotations will be written
+		 * \param sigma array, to which count singular value triples will be written
+		 * \param v array, to which count right rotations will be written
+		 * \param count count of matrices
+		 */
+		static void svdMany(const mat3* m, mat3* u, vec3* sigma, mat3* v, size_t count);
+
+		/**
+		 * \brief Polar decomposition m = rotation * stretch, where stretch is symmetric. Rotation is
+		 * the closest rotation to m, also for sheared or nearly singular matrices.
+		 * \param m decomposed matrix
+		 * \param stretch optional pointer, to which symmetric stretch will be written
+		 * \return rotation part of m
+		 */
+		static mat3 polar(const mat3& m, mat3* stretch = nullptr);
+
+		/**
+		 * \brief Finds rotation and translation, which map points from onto points to with the least squared
+		 * error (Kabsch algorithm), so that to[i] ~ rotation * from[i] + translation. Used for shape matching.
+		 * \param from array of source points
+		 * \param to array of target points
+		 * \param count count of point pairs
+		 * \param translation optional pointer, to which translation will be written
+		 * \return best-fit rotation
+		 */
+		static mat3 kabsch(const vec3* from, const vec3* to, size_t count, vec3* translation = nullptr);
+
+		/**
+		 * \brief Diagonalizes inertia tensor, inertia = axes * diag(moments) * transpose(axes).
+		 * \param inertia inertia tensor
+		 * \param moments reference, to which principal moments of inertia will be written
+		 * \return rotation from principal (body) frame to frame of given tensor
+		 */
+		static mat3 principalAxes(const mat3& inertia, vec3& moments);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_DECOMPOSITION_H
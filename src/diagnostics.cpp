@@ -0,0 +1,198 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "diagnostics.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if MARMATH_SIMD_SSE
+	#include <emmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	static constexpr size_t g_diagnosticCount{ (size_t)diagnostic::Count };
+
+	static const char* const g_diagnosticNames[g_diagnosticCount]{
+		"division by zero",
+		"zero length normalize",
+		"singular inverse",
+		"non-finite output",
+		"denormal input",
+		"out of bounds"
+	};
+
+	static std::atomic<uint64_t> g_counters[g_diagnosticCount]{};
+	static std::atomic<const char*> g_lastWhere[g_diagnosticCount]{};
+	static std::atomic<uint32_t> g_trapMask{ 0 };
+	static std::atomic<diagnostics::handler> g_handler{ nullptr };
+	static std::atomic<bool> g_flushDenormals{ false };
+
+	static constexpr uint32_t g_exponentMask{ 0x7F800000 };
+	static constexpr uint32_t g_mantissaMask{ 0x007FFFFF };
+
+	static uint32_t bitsOf(float f) {
+		uint32_t bits;
+		std::memcpy(&bits, &f, sizeof(float));
+		return bits;
+	}
+
+	static void defaultHandler(diagnostic kind, const char* where, uint64_t count) {
+		std::fprintf(stderr, "MARMaths diagnostics: %s (%llu) at %s\n", g_diagnosticNames[(size_t)kind],
+			(unsigned long long)count, where ? where : "?");
+		std::abort();
+	}
+
+
+	void diagnostics::raise(diagnostic kind, const char* where, uint64_t count) {
+		const size_t index{ (size_t)kind };
+		g_counters[index].fetch_add(count, std::memory_order_relaxed);
+		g_lastWhere[index].store(where, std::memory_order_relaxed);
+
+		if (g_trapMask.load(std::memory_order_relaxed) & (1u << index)) {
+			const handler function{ g_handler.load(std::memory_order_acquire) };
+			(function ? function : defaultHandler)(kind, where, count);
+		}
+	}
+
+	uint64_t diagnostics::count(diagnostic kind) {
+		return g_counters[(size_t)kind].load(std::memory_order_relaxed);
+	}
+
+	const char* diagnostics::lastWhere(diagnostic kind) {
+		return g_lastWhere[(size_t)kind].load(std::memory_order_relaxed);
+	}
+
+	void diagnostics::reset() {
+		for (size_t i = 0; i < g_diagnosticCount; i++) {
+			g_counters[i].store(0, std::memory_order_relaxed);
+			g_lastWhere[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	void diagnostics::setTrap(diagnostic kind, bool trap) {
+		const uint32_t bit{ 1u << (uint32_t)kind };
+		if (trap) {
+			g_trapMask.fetch_or(bit, std::memory_order_relaxed);
+		}
+		else {
+			g_trapMask.fetch_and(~bit, std::memory_order_relaxed);
+		}
+	}
+
+	void diagnostics::setHandler(handler function) {
+		g_handler.store(function, std::memory_order_release);
+	}
+
+	size_t diagnostics::countNonFinite(const float* values, size_t count) {
+		// checks bits instead of comparing floats, so result is the same with DAZ enabled
+		size_t found{ 0 };
+		size_t i{ 0 };
+#if MARMATH_SIMD_SSE
+		const __m128i exponent{ _mm_set1_epi32((int)g_exponentMask) };
+		for (; i + 4 <= count; i += 4) {
+			const __m128i bits{ _mm_and_si128(_mm_loadu_si128((const __m128i*)(values + i)), exponent) };
+			const int mask{ _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(bits, exponent))) };
+			found += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+		}
+#endif
+		for (; i < count; i++) {
+			found += (bitsOf(values[i]) & g_exponentMask) == g_exponentMask;
+		}
+		return found;
+	}
+
+	size_t diagnostics::countDenormals(const float* values, size_t count) {
+		size_t found{ 0 };
+		size_t i{ 0 };
+#if MARMATH_SIMD_SSE
+		const __m128i exponent{ _mm_set1_epi32((int)g_exponentMask) };
+		const __m128i mantissa{ _mm_set1_epi32((int)g_mantissaMask) };
+		const __m128i zero{ _mm_setzero_si128() };
+		for (; i + 4 <= count; i += 4) {
+			const __m128i bits{ _mm_loadu_si128((const __m128i*)(values + i)) };
+			const __m128i zeroExponent{ _mm_cmpeq_epi32(_mm_and_si128(bits, exponent), zero) };
+			const __m128i zeroMantissa{ _mm_cmpeq_epi32(_mm_and_si128(bits, mantissa), zero) };
+			const int mask{ _mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(zeroMantissa, zeroExponent))) };
+			found += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+		}
+#endif
+		for (; i < count; i++) {
+			const uint32_t bits{ bitsOf(values[i]) };
+			found += (bits & g_exponentMask) == 0 && (bits & g_mantissaMask) != 0;
+		}
+		return found;
+	}
+
+	void diagnostics::checkFinite(const float* values, size_t count, const char* where) {
+		const size_t found{ countNonFinite(values, count) };
+		if (found != 0) {
+			raise(diagnostic::NonFiniteOutput, where, found);
+		}
+	}
+
+	void diagnostics::checkDenormals(const float* values, size_t count, const char* where) {
+		const size_t found{ countDenormals(values, count) };
+		if (found != 0) {
+			raise(diagnostic::DenormalInput, where, found);
+		}
+	}
+
+	void diagnostics::setFlushDenormals(bool enable) {
+		g_flushDenormals.store(enable, std::memory_order_relaxed);
+	}
+
+	bool diagnostics::flushDenormals() {
+		return g_flushDenormals.load(std::memory_order_relaxed);
+	}
+
+
+	denormalScope::denormalScope() :
+		m_previous(0),
+		m_changed(false)
+	{
+#if MARMATH_SIMD_SSE
+		if (diagnostics::flushDenormals()) {
+			constexpr unsigned int flushToZero{ 0x8000 };
+			constexpr unsigned int denormalsAreZero{ 0x0040 };
+			m_previous = _mm_getcsr();
+			_mm_setcsr(m_previous | flushToZero | denormalsAreZero);
+			m_changed = true;
+		}
+#endif
+	}
+
+	denormalScope::~denormalScope() {
+#if MARMATH_SIMD_SSE
+		if (m_changed) {
+			_mm_setcsr(m_previous);
+		}
+#endif
+	}
+
+
+}
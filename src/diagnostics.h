@@ -0,0 +1,207 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_DIAGNOSTICS_H
+#define MAR_MATH_DIAGNOSTICS_H
+
+
+#include "maths.h"
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \brief Kinds of numerical problems detected in diagnostics mode.
+	 */
+	enum class diagnostic : uint32_t {
+		/// \brief divide() or other method divided by zero
+		DivisionByZero,
+		/// \brief normalize() of vector with zero length
+		ZeroLengthNormalize,
+		/// \brief mat4::inverse() of matrix with zero determinant
+		SingularInverse,
+		/// \brief NaN or Inf written to output (count of floats)
+		NonFiniteOutput,
+		/// \brief denormal float passed as input (count of floats)
+		DenormalInput,
+		/// \brief index out of bound
+		OutOfBounds,
+		Count
+	};
+
+
+	/**
+	 * \struct diagnostics diagnostics.h "diagnostics.h"
+	 * \brief Opt-in numerical robustness checks. Define MARMATH_DIAGNOSTICS to 1 for whole build to
+	 * enable them, otherwise MARMATH_DIAGNOSE and MARMATH_CHECK_* expand to nothing.
+	 *
+	 * Every detected problem increments counter of its kind. If trap is enabled for the kind,
+	 * handler is called (default handler prints message to stderr and aborts, so that debugger
+	 * stops at the first NaN). Counters are global atomics, as problems are rare.
+	 *
+	 * Flushing denormals (FTZ / DAZ) works in every build, as it is not a check but a mode.
+	 */
+	struct diagnostics {
+
+		/// \brief Function called, when trapped problem is detected.
+		using handler = void(*)(diagnostic kind, const char* where, uint64_t count);
+
+		/// \brief True, if library is built with MARMATH_DIAGNOSTICS.
+		static constexpr bool enabled{
+#ifdef MARMATH_DIAGNOSTICS
+			MARMATH_DIAGNOSTICS != 0
+#else
+			false
+#endif
+		};
+
+		/**
+		 * \brief Counts problem and traps, if it is enabled for its kind. Use MARMATH_DIAGNOSE instead of calling it directly.
+		 * \param kind kind of problem
+		 * \param where message describing place of problem, ex: "mat4::inverse"
+		 * \param count count of problematic values
+		 */
+		static void raise(diagnostic kind, const char* where, uint64_t count = 1);
+
+		/**
+		 * \brief Returns counter of given kind.
+		 * \param kind kind of problem
+		 * \return count of detected problems since last reset()
+		 */
+		static uint64_t count(diagnostic kind);
+
+		/**
+		 * \brief Returns place of last detected problem of given kind.
+		 * \param kind kind of problem
+		 * \return message passed to raise() or nullptr, if nothing was detected
+		 */
+		static const char* lastWhere(diagnostic kind);
+
+		/// \brief Clears all counters.
+		static void reset();
+
+		/**
+		 * \brief Enables or disables trapping of given kind.
+		 * \param kind kind of problem
+		 * \param trap if true, handler is called on every problem of that kind
+		 */
+		static void setTrap(diagnostic kind, bool trap);
+
+		/**
+		 * \brief Sets handler called on trapped problems.
+		 * \param function handler, nullptr restores default one (print and abort)
+		 */
+		static void setHandler(handler function);
+
+		/**
+		 * \brief Counts NaN and Inf values (vectorized).
+		 * \param values array of floats
+		 * \param count count of floats
+		 * \return count of non-finite values
+		 */
+		static size_t countNonFinite(const float* values, size_t count);
+
+		/**
+		 * \brief Counts denormal values, zero is not denormal (vectorized).
+		 * \param values array of floats
+		 * \param count count of floats
+		 * \return count of denormal values
+		 */
+		static size_t countDenormals(const float* values, size_t count);
+
+		/**
+		 * \brief Raises NonFiniteOutput, if any of given values is NaN or Inf.
+		 * \param values array of floats
+		 * \param count count of floats
+		 * \param where message describing place of check
+		 */
+		static void checkFinite(const float* values, size_t count, const char* where);
+
+		/**
+		 * \brief Raises DenormalInput, if any of given values is denormal.
+		 * \param values array of floats
+		 * \param count count of floats
+		 * \param where message describing place of check
+		 */
+		static void checkDenormals(const float* values, size_t count, const char* where);
+
+		/**
+		 * \brief Enables flush-to-zero and denormals-are-zero for batch methods (everything run through
+		 * parallel::forEach). MXCSR is set only for duration of batch and restored after it, on every
+		 * thread that processes it. No-op without SSE.
+		 * \param enable true to flush denormals in batch methods
+		 */
+		static void setFlushDenormals(bool enable);
+
+		/**
+		 * \brief Returns true, if batch methods flush denormals.
+		 * \return value set by setFlushDenormals (false by default)
+		 */
+		static bool flushDenormals();
+
+	};
+
+
+	/**
+	 * \struct denormalScope diagnostics.h "diagnostics.h"
+	 * \brief Sets FTZ / DAZ on calling thread for its lifetime, if diagnostics::flushDenormals()
+	 * is enabled, then restores previous mode.
+	 */
+	struct denormalScope {
+
+		/// \brief self-explanatory
+		denormalScope();
+		/// \brief self-explanatory
+		~denormalScope();
+
+		denormalScope(const denormalScope&) = delete;
+		denormalScope& operator=(const denormalScope&) = delete;
+
+	private:
+
+		unsigned int m_previous;
+		bool m_changed;
+
+	};
+
+
+}
+
+
+#if defined(MARMATH_DIAGNOSTICS) && MARMATH_DIAGNOSTICS
+	#define MARMATH_DIAGNOSE(kind, where) \
+		::marengine::maths::diagnostics::raise(::marengine::maths::diagnostic::kind, where)
+	#define MARMATH_CHECK_FINITE(values, count, where) \
+		::marengine::maths::diagnostics::checkFinite(values, count, where)
+	#define MARMATH_CHECK_DENORMALS(values, count, where) \
+		::marengine::maths::diagnostics::checkDenormals(values, count, where)
+#else
+	#define MARMATH_DIAGNOSE(kind, where) ((void)0)
+	#define MARMATH_CHECK_FINITE(values, count, where) ((void)0)
+	#define MARMATH_CHECK_DENORMALS(values, count, where) ((void)0)
+#endif
+
+
+#endif // !MAR_MATH_DIAGNOSTICS_H
@@ -0,0 +1,116 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "dvec3.h"
+#include "vec3.h"
+#include <cmath>
+
+
+namespace marengine::maths {
+
+
+	dvec3::dvec3() :
+		x(0.0),
+		y(0.0),
+		z(0.0)
+	{}
+
+	dvec3::dvec3(double _x, double _y, double _z) :
+		x(_x),
+		y(_y),
+		z(_z)
+	{}
+
+	dvec3::dvec3(const vec3& v) :
+		x((double)v.x),
+		y((double)v.y),
+		z((double)v.z)
+	{}
+
+	dvec3 dvec3::add(dvec3 other) const {
+		return {
+			x + other.x,
+			y + other.y,
+			z + other.z
+		};
+	}
+
+	dvec3 dvec3::subtract(dvec3 other) const {
+		return {
+			x - other.x,
+			y - other.y,
+			z - other.z
+		};
+	}
+
+	dvec3 dvec3::multiply(double d) const {
+		return {
+			x * d,
+			y * d,
+			z * d
+		};
+	}
+
+	double dvec3::dot(dvec3 left, dvec3 right) {
+		return left.x * right.x + left.y * right.y + left.z * right.z;
+	}
+
+	double dvec3::length(dvec3 v) {
+		return sqrt(dot(v, v));
+	}
+
+	vec3 dvec3::toVec3() const {
+		return {
+			(float)x,
+			(float)y,
+			(float)z
+		};
+	}
+
+	void dvec3::split(dvec3 v, vec3& high, vec3& low) {
+		high = v.toVec3();
+		low = v.subtract(dvec3(high)).toVec3();
+	}
+
+	dvec3 operator+(dvec3 left, dvec3 right) {
+		return left.add(right);
+	}
+
+	dvec3 operator-(dvec3 left, dvec3 right) {
+		return left.subtract(right);
+	}
+
+	dvec3 operator*(dvec3 left, double right) {
+		return left.multiply(right);
+	}
+
+	bool dvec3::operator==(dvec3 other) const {
+		return x == other.x && y == other.y && z == other.z;
+	}
+
+	bool dvec3::operator!=(dvec3 other) const {
+		return !(*this == other);
+	}
+
+
+}
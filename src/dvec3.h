@@ -0,0 +1,137 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+#ifndef MAR_MATH_DVEC3_H
+#define MAR_MATH_DVEC3_H
+
+
+#include "maths.h"
+
+
+namespace marengine::maths {
+
+	struct vec3;
+
+
+	/**
+	 * \struct dvec3 dvec3.h "dvec3.h"
+	 * \brief 3-dimensional vector with double precision. Meant for storing world positions,
+	 * which are too far from origin to be kept in vec3 without visible jitter.
+	 */
+	struct dvec3 {
+
+		/// \brief x value of dvec3
+		double x;
+		/// \brief y value of dvec3
+		double y;
+		/// \brief z value of dvec3
+		double z;
+
+
+		/// \brief Default constructor, creates dvec3(0.0, 0.0, 0.0).
+		dvec3();
+
+		/**
+		 * \brief Constructor, that can create dvec3 from given 3 doubles.
+		 * \param _x x value, that will be prescribed to dvec3(x, y, z)
+		 * \param _y y value, that will be prescribed to dvec3(x, y, z)
+		 * \param _z z value, that will be prescribed to dvec3(x, y, z)
+		 */
+		dvec3(double _x, double _y, double _z);
+
+		/**
+		 * \brief Constructor, that widens given vec3 to double precision.
+		 * \param v vec3, which values x,y,z will be prescribed to new dvec3
+		 */
+		dvec3(const vec3& v);
+
+		/**
+		 * \brief Addition method of dvec3 and dvec3.
+		 * \param other second dvec3, which will be added to *this
+		 * \return computed dvec3
+		 */
+		dvec3 add(dvec3 other) const;
+
+		/**
+		 * \brief Subtraction method of dvec3 and dvec3.
+		 * \param other second dvec3, which will be subtracted from *this
+		 * \return computed dvec3
+		 */
+		dvec3 subtract(dvec3 other) const;
+
+		/**
+		 * \brief Multiplication method of dvec3 and double value.
+		 * \param d double value, which will be multiplied
+		 * \return computed dvec3
+		 */
+		dvec3 multiply(double d) const;
+
+		/**
+		 * \brief Static method, which computes dot product of 2 given dvec3's.
+		 * \param left first dvec3
+		 * \param right second dvec3
+		 * \return calculated dot product
+		 */
+		static double dot(dvec3 left, dvec3 right);
+
+		/**
+		 * \brief Computes length of given vector as a paramater.
+		 * \param v dvec3, which length will be calculated
+		 * \return calculated length
+		 */
+		static double length(dvec3 v);
+
+		/**
+		 * \brief Narrows dvec3 to vec3. Use it only on values, which are already
+		 * relative to some nearby origin, otherwise precision is lost.
+		 * \return vec3 with rounded values
+		 */
+		vec3 toVec3() const;
+
+		/**
+		 * \brief Splits dvec3 into two vec3's, so that high + low reproduces given value
+		 * with ~48 bits of mantissa. Such pairs can be uploaded to GPU and subtracted there
+		 * from camera high / low pair (relative-to-eye rendering).
+		 * \param v dvec3, which will be split
+		 * \param high reference, to which high part will be written
+		 * \param low reference, to which low part (the rounding error of high) will be written
+		 */
+		static void split(dvec3 v, vec3& high, vec3& low);
+
+		/// \brief self-explanatory
+		friend dvec3 operator+(dvec3 left, dvec3 right);
+		/// \brief self-explanatory
+		friend dvec3 operator-(dvec3 left, dvec3 right);
+		/// \brief self-explanatory
+		friend dvec3 operator*(dvec3 left, double right);
+		/// \brief self-explanatory
+		bool operator==(dvec3 other) const;
+		/// \brief self-explanatory
+		bool operator!=(dvec3 other) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_DVEC3_H
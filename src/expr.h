@@ -0,0 +1,323 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_EXPR_H
+#define MAR_MATH_EXPR_H
+
+
+#include "maths.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+#include <type_traits>
+
+
+/**
+ * \namespace marengine::maths::expr
+ * \brief Expression templates for vec2 / vec3 / vec4. Wrap any operand with expr::lazy(),
+ * then every +, -, *, / builds a node instead of computing temporary vector. Whole
+ * expression is evaluated in one place, when it is converted to vector (or by
+ * expr::evaluate), or for every element of SoA arrays by expr::assign in one fused loop.
+ *
+ * \code
+ *   const vec3 r = expr::lazy(v1) * v2 + expr::lazy(v3) * s - v4; // no temporaries
+ *   expr::assign(out, expr::lazy(positions) + expr::lazy(velocities) * dt); // one loop over arrays
+ * \endcode
+ */
+namespace marengine::maths::expr {
+
+
+	/**
+	 * \struct soa expr.h "expr.h"
+	 * \brief Structure of arrays view, that holds pointer to every component array (lane)
+	 * of N-dimensional vectors. It doesn't own memory.
+	 */
+	template<size_t N>
+	struct soa {
+		/// \brief pointers to component arrays, lanes[0] is x, lanes[1] is y and so on
+		float* lanes[N];
+		/// \brief count of elements in every lane
+		size_t count;
+	};
+
+	/// \brief self-explanatory
+	using soa2 = soa<2>;
+	/// \brief self-explanatory
+	using soa3 = soa<3>;
+	/// \brief self-explanatory
+	using soa4 = soa<4>;
+
+
+	/// \brief Maps dimension to vector type and allows generic access to its components.
+	template<size_t N> struct vecOf;
+
+	template<> struct vecOf<2> {
+		using type = vec2;
+		static float get(const vec2& v, size_t lane) { return (&v.x)[lane]; }
+	};
+
+	template<> struct vecOf<3> {
+		using type = vec3;
+		static float get(const vec3& v, size_t lane) { return (&v.x)[lane]; }
+	};
+
+	template<> struct vecOf<4> {
+		using type = vec4;
+		static float get(const vec4& v, size_t lane) { return (&v.x)[lane]; }
+	};
+
+
+	/**
+	 * \brief Base of every vector node. Node must implement float at(size_t index, size_t lane),
+	 * where index is ignored by nodes, which are not arrays.
+	 */
+	template<typename Derived, size_t N>
+	struct node {
+
+		/// \brief dimension of vectors produced by node
+		static constexpr size_t dimension{ N };
+
+		/// \brief Evaluates node (element 0 for arrays) to vector.
+		operator typename vecOf<N>::type() const {
+			const Derived& self{ static_cast<const Derived&>(*this) };
+			typename vecOf<N>::type rtn;
+			for (size_t lane = 0; lane < N; lane++) {
+				(&rtn.x)[lane] = self.at(0, lane);
+			}
+			return rtn;
+		}
+
+	};
+
+	/// \brief Leaf node holding single vector by value.
+	template<size_t N>
+	struct value : node<value<N>, N> {
+		float lanes[N];
+
+		explicit value(const typename vecOf<N>::type& v) {
+			for (size_t lane = 0; lane < N; lane++) {
+				lanes[lane] = vecOf<N>::get(v, lane);
+			}
+		}
+
+		float at(size_t, size_t lane) const { return lanes[lane]; }
+	};
+
+	/// \brief Leaf node, that reads SoA arrays.
+	template<size_t N>
+	struct array : node<array<N>, N> {
+		const float* lanes[N];
+
+		explicit array(const soa<N>& arrays) {
+			for (size_t lane = 0; lane < N; lane++) {
+				lanes[lane] = arrays.lanes[lane];
+			}
+		}
+
+		float at(size_t index, size_t lane) const { return lanes[lane][index]; }
+	};
+
+	/// \brief Leaf node, that broadcasts float to every lane. It has no dimension on its own.
+	struct scalar {
+		static constexpr size_t dimension{ 0 };
+		float f;
+
+		float at(size_t, size_t) const { return f; }
+	};
+
+	/// \brief self-explanatory
+	struct addOp { static float apply(float l, float r) { return l + r; } };
+	/// \brief self-explanatory
+	struct subtractOp { static float apply(float l, float r) { return l - r; } };
+	/// \brief self-explanatory
+	struct multiplyOp { static float apply(float l, float r) { return l * r; } };
+	/// \brief self-explanatory
+	struct divideOp { static float apply(float l, float r) { return l / r; } };
+
+	/// \brief Returns dimension of binary node, scalar (0) takes dimension of other operand.
+	constexpr size_t binaryDimension(size_t l, size_t r) {
+		return l == 0 ? r : l;
+	}
+
+	/// \brief Node, that combines two nodes component-wise.
+	template<typename L, typename R, typename Op>
+	struct binary : node<binary<L, R, Op>, binaryDimension(L::dimension, R::dimension)> {
+		static_assert(L::dimension == 0 || R::dimension == 0 || L::dimension == R::dimension,
+			"expr: cannot combine vectors of different dimensions!");
+
+		L left;
+		R right;
+
+		binary(const L& l, const R& r) : left(l), right(r) {}
+
+		float at(size_t index, size_t lane) const {
+			return Op::apply(left.at(index, lane), right.at(index, lane));
+		}
+	};
+
+	/// \brief Node, that negates its child.
+	template<typename E>
+	struct negate : node<negate<E>, E::dimension> {
+		E child;
+
+		explicit negate(const E& e) : child(e) {}
+
+		float at(size_t index, size_t lane) const { return -child.at(index, lane); }
+	};
+
+
+	/// \brief True for vector nodes (scalar, vectors and floats are not nodes).
+	template<typename T, typename = void>
+	struct isNode : std::false_type {};
+
+	template<typename T>
+	struct isNode<T, std::void_t<decltype(T::dimension)>> : std::bool_constant<std::is_base_of_v<node<T, T::dimension>, T>> {};
+
+	/// \brief Wraps operand of expression into node.
+	template<typename T, typename = void> struct wrap;
+
+	template<typename T> struct wrap<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+		using type = scalar;
+		static scalar make(T f) { return { (float)f }; }
+	};
+
+	template<> struct wrap<vec2> {
+		using type = value<2>;
+		static value<2> make(const vec2& v) { return value<2>(v); }
+	};
+
+	template<> struct wrap<vec3> {
+		using type = value<3>;
+		static value<3> make(const vec3& v) { return value<3>(v); }
+	};
+
+	template<> struct wrap<vec4> {
+		using type = value<4>;
+		static value<4> make(const vec4& v) { return value<4>(v); }
+	};
+
+	template<typename T> struct wrap<T, std::enable_if_t<isNode<T>::value>> {
+		using type = T;
+		static const T& make(const T& e) { return e; }
+	};
+
+	template<typename T>
+	using wrapped = typename wrap<std::decay_t<T>>::type;
+
+	/// \brief Operators are enabled only, if at least one operand is already a node.
+	template<typename L, typename R>
+	constexpr bool anyNode() {
+		return isNode<std::decay_t<L>>::value || isNode<std::decay_t<R>>::value;
+	}
+
+	template<typename L, typename R, typename Op>
+	using binaryOf = binary<wrapped<L>, wrapped<R>, Op>;
+
+
+	/**
+	 * \brief Starts lazy expression from single vector.
+	 * \param v vector, that will be wrapped
+	 * \return leaf node
+	 */
+	inline value<2> lazy(const vec2& v) { return value<2>(v); }
+	/// \brief self-explanatory
+	inline value<3> lazy(const vec3& v) { return value<3>(v); }
+	/// \brief self-explanatory
+	inline value<4> lazy(const vec4& v) { return value<4>(v); }
+
+	/**
+	 * \brief Starts lazy expression from SoA arrays.
+	 * \param arrays arrays, that will be read, when expression is assigned
+	 * \return leaf node
+	 */
+	template<size_t N>
+	array<N> lazy(const soa<N>& arrays) { return array<N>(arrays); }
+
+	/// \brief self-explanatory
+	template<typename L, typename R, typename = std::enable_if_t<anyNode<L, R>()>>
+	binaryOf<L, R, addOp> operator+(const L& left, const R& right) {
+		return { wrap<std::decay_t<L>>::make(left), wrap<std::decay_t<R>>::make(right) };
+	}
+
+	/// \brief self-explanatory
+	template<typename L, typename R, typename = std::enable_if_t<anyNode<L, R>()>>
+	binaryOf<L, R, subtractOp> operator-(const L& left, const R& right) {
+		return { wrap<std::decay_t<L>>::make(left), wrap<std::decay_t<R>>::make(right) };
+	}
+
+	/// \brief self-explanatory
+	template<typename L, typename R, typename = std::enable_if_t<anyNode<L, R>()>>
+	binaryOf<L, R, multiplyOp> operator*(const L& left, const R& right) {
+		return { wrap<std::decay_t<L>>::make(left), wrap<std::decay_t<R>>::make(right) };
+	}
+
+	/// \brief self-explanatory
+	template<typename L, typename R, typename = std::enable_if_t<anyNode<L, R>()>>
+	binaryOf<L, R, divideOp> operator/(const L& left, const R& right) {
+		return { wrap<std::decay_t<L>>::make(left), wrap<std::decay_t<R>>::make(right) };
+	}
+
+	/// \brief self-explanatory
+	template<typename E, typename = std::enable_if_t<anyNode<E, E>()>>
+	negate<E> operator-(const E& e) {
+		return negate<E>(e);
+	}
+
+	/**
+	 * \brief Evaluates expression to vector. For expressions containing arrays it evaluates element at index.
+	 * \param e expression
+	 * \param index index of element, used only by array nodes
+	 * \return computed vector
+	 */
+	template<typename E>
+	typename vecOf<E::dimension>::type evaluate(const E& e, size_t index = 0) {
+		typename vecOf<E::dimension>::type rtn;
+		for (size_t lane = 0; lane < E::dimension; lane++) {
+			(&rtn.x)[lane] = e.at(index, lane);
+		}
+		return rtn;
+	}
+
+	/**
+	 * \brief Evaluates expression for every element of out in one fused loop per lane.
+	 * Every node is component-wise, so out lanes may alias the same lanes of input arrays.
+	 * Make sure, that every array in expression has at least out.count elements!
+	 * \param out arrays, to which result will be written
+	 * \param e expression
+	 */
+	template<size_t N, typename E>
+	void assign(const soa<N>& out, const E& e) {
+		static_assert(E::dimension == N, "expr::assign - dimension of expression differs from output!");
+		for (size_t lane = 0; lane < N; lane++) {
+			float* const dst{ out.lanes[lane] };
+			for (size_t i = 0; i < out.count; i++) {
+				dst[i] = e.at(i, lane);
+			}
+		}
+	}
+
+
+}
+
+
+#endif // !MAR_MATH_EXPR_H
@@ -0,0 +1,236 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "fixed.h"
+#include "diagnostics.h"
+
+
+namespace marengine::maths {
+
+
+	// pi, pi/2 and 2pi rounded to Q16.16
+	static constexpr int64_t g_piRaw{ 205887 };
+	static constexpr int64_t g_halfPiRaw{ 102944 };
+	static constexpr int64_t g_twoPiRaw{ 411775 };
+
+	// Right shifts of negative values are arithmetic on every supported compiler (and defined so since C++20).
+	static int32_t saturate(int64_t value) {
+		if (value > INT32_MAX) {
+			return INT32_MAX;
+		}
+		if (value < INT32_MIN) {
+			return INT32_MIN;
+		}
+		return (int32_t)value;
+	}
+
+
+	fixed::fixed() :
+		raw(0)
+	{}
+
+	fixed fixed::fromInt(int32_t value) {
+		return fromRaw(saturate((int64_t)value * rawOne));
+	}
+
+	fixed fixed::fromRaw(int32_t value) {
+		fixed f;
+		f.raw = value;
+		return f;
+	}
+
+	fixed fixed::fromFloat(float value) {
+		const double scaled{ (double)value * (double)rawOne };
+		if (!(scaled == scaled)) {
+			return fixed();
+		}
+		if (scaled >= (double)INT32_MAX) {
+			return fromRaw(INT32_MAX);
+		}
+		if (scaled <= (double)INT32_MIN) {
+			return fromRaw(INT32_MIN);
+		}
+		return fromRaw((int32_t)(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5));
+	}
+
+	float fixed::toFloat() const {
+		return (float)raw / (float)rawOne;
+	}
+
+	fixed fixed::add(fixed other) const {
+		return fromRaw(saturate((int64_t)raw + other.raw));
+	}
+
+	fixed fixed::subtract(fixed other) const {
+		return fromRaw(saturate((int64_t)raw - other.raw));
+	}
+
+	fixed fixed::multiply(fixed other) const {
+		const int64_t product{ (int64_t)raw * other.raw };
+		return fromRaw(saturate((product + (1 << (fractionBits - 1))) >> fractionBits));
+	}
+
+	fixed fixed::divide(fixed other) const {
+		if (other.raw == 0) {
+			MARMATH_DIAGNOSE(DivisionByZero, "fixed::divide(0) - cannot divide by zero!");
+			return fromRaw(raw >= 0 ? INT32_MAX : INT32_MIN);
+		}
+		return fromRaw(saturate(((int64_t)raw * rawOne) / other.raw));
+	}
+
+	fixed fixed::abs(fixed f) {
+		return fromRaw(saturate(f.raw < 0 ? -(int64_t)f.raw : (int64_t)f.raw));
+	}
+
+	fixed fixed::min(fixed left, fixed right) {
+		return left.raw < right.raw ? left : right;
+	}
+
+	fixed fixed::max(fixed left, fixed right) {
+		return left.raw > right.raw ? left : right;
+	}
+
+	fixed fixed::sumOfProducts(const fixed* left, const fixed* right, size_t count) {
+		// Single product fits into int64_t (at most 2^62), but sum of four does not,
+		// so high and low 32 bits of products are accumulated separately.
+		int64_t high{ 0 };
+		int64_t low{ 0 };
+		for (size_t i = 0; i < count; i++) {
+			const int64_t product{ (int64_t)left[i].raw * right[i].raw };
+			high += product >> 32;
+			low += product & 0xFFFFFFFF;
+		}
+		// sum = high * 2^32 + low, high part is multiple of 2^fractionBits, so rounding affects only low
+		const int64_t rounded{ high * ((int64_t)1 << (32 - fractionBits)) + ((low + (1 << (fractionBits - 1))) >> fractionBits) };
+		return fromRaw(saturate(rounded));
+	}
+
+	fixed fixed::sqrt(fixed f) {
+		if (f.raw <= 0) {
+			return fixed();
+		}
+		uint64_t value{ (uint64_t)f.raw << fractionBits };
+		uint64_t result{ 0 };
+		uint64_t bit{ (uint64_t)1 << 62 };
+		while (bit > value) {
+			bit >>= 2;
+		}
+		while (bit != 0) {
+			if (value >= result + bit) {
+				value -= result + bit;
+				result = (result >> 1) + bit;
+			}
+			else {
+				result >>= 1;
+			}
+			bit >>= 2;
+		}
+		return fromRaw((int32_t)result);
+	}
+
+	fixed fixed::sine(fixed radians) {
+		// reduce to [-pi; pi], then to [-pi/2; pi/2] with sin(pi - a) = sin(a)
+		int64_t a{ radians.raw % g_twoPiRaw };
+		if (a > g_piRaw) {
+			a -= g_twoPiRaw;
+		}
+		else if (a < -g_piRaw) {
+			a += g_twoPiRaw;
+		}
+		if (a > g_halfPiRaw) {
+			a = g_piRaw - a;
+		}
+		else if (a < -g_halfPiRaw) {
+			a = -g_piRaw - a;
+		}
+
+		// Taylor series up to x^9 in Q2.30, x * (1 - x2/6 * (1 - x2/20 * (1 - x2/42 * (1 - x2/72))))
+		constexpr int64_t one30{ (int64_t)1 << 30 };
+		const int64_t x{ a * ((int64_t)1 << (30 - fractionBits)) };
+		const int64_t x2{ (x * x) >> 30 };
+		int64_t p{ one30 - x2 / 72 };
+		p = one30 - ((x2 * p) >> 30) / 42;
+		p = one30 - ((x2 * p) >> 30) / 20;
+		p = one30 - ((x2 * p) >> 30) / 6;
+		const int64_t s{ (x * p) >> 30 };
+		return fromRaw((int32_t)((s + ((int64_t)1 << (29 - fractionBits))) >> (30 - fractionBits)));
+	}
+
+	fixed fixed::cosine(fixed radians) {
+		return sine(fromRaw(saturate((int64_t)radians.raw % g_twoPiRaw + g_halfPiRaw)));
+	}
+
+	fixed fixed::pi() {
+		return fromRaw((int32_t)g_piRaw);
+	}
+
+	fixed fixed::one() {
+		return fromRaw(rawOne);
+	}
+
+	fixed operator+(fixed left, fixed right) {
+		return left.add(right);
+	}
+
+	fixed operator-(fixed left, fixed right) {
+		return left.subtract(right);
+	}
+
+	fixed operator*(fixed left, fixed right) {
+		return left.multiply(right);
+	}
+
+	fixed operator/(fixed left, fixed right) {
+		return left.divide(right);
+	}
+
+	fixed operator-(fixed f) {
+		return fixed::fromRaw(saturate(-(int64_t)f.raw));
+	}
+
+	bool fixed::operator==(fixed other) const {
+		return raw == other.raw;
+	}
+
+	bool fixed::operator!=(fixed other) const {
+		return raw != other.raw;
+	}
+
+	bool fixed::operator<(fixed other) const {
+		return raw < other.raw;
+	}
+
+	bool fixed::operator>(fixed other) const {
+		return raw > other.raw;
+	}
+
+	bool fixed::operator<=(fixed other) const {
+		return raw <= other.raw;
+	}
+
+	bool fixed::operator>=(fixed other) const {
+		return raw >= other.raw;
+	}
+
+
+}
@@ -0,0 +1,168 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_FIXED_H
+#define MAR_MATH_FIXED_H
+
+
+#include "maths.h"
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct fixed fixed.h "fixed.h"
+	 * \brief Q16.16 fixed-point number for deterministic (lockstep) simulation. Every operation is
+	 * done on integers with specified rounding, so results are bit-identical on every compiler and CPU.
+	 * Floats are used only in fromFloat / toFloat, which are meant for loading data and rendering.
+	 *
+	 * Range is [-32768; 32768) with resolution 1/65536. Multiplication rounds to nearest, division
+	 * truncates toward zero, division by zero saturates. Trigonometry uses integer polynomials
+	 * (error about 2 / 65536 for |angle| < 32), not libm.
+	 */
+	struct fixed {
+
+		/// \brief raw Q16.16 value, 65536 means 1.0
+		int32_t raw;
+
+		/// \brief count of fraction bits
+		static constexpr int32_t fractionBits{ 16 };
+		/// \brief raw value of 1.0
+		static constexpr int32_t rawOne{ 1 << fractionBits };
+
+		/// \brief Default constructor, creates fixed equal to 0.
+		fixed();
+
+		/**
+		 * \brief Creates fixed from integer value.
+		 * \param value integer value, ex: 3 creates 3.0
+		 * \return created fixed
+		 */
+		static fixed fromInt(int32_t value);
+
+		/**
+		 * \brief Creates fixed from raw Q16.16 value.
+		 * \param value raw value
+		 * \return created fixed
+		 */
+		static fixed fromRaw(int32_t value);
+
+		/**
+		 * \brief Creates fixed from float, rounding to nearest representable value.
+		 * \param value float value
+		 * \return created fixed
+		 */
+		static fixed fromFloat(float value);
+
+		/**
+		 * \brief Converts fixed to float (exact for |value| < 256).
+		 * \return float value
+		 */
+		float toFloat() const;
+
+		/// \brief self-explanatory
+		fixed add(fixed other) const;
+		/// \brief self-explanatory
+		fixed subtract(fixed other) const;
+		/// \brief Multiplication rounded to nearest.
+		fixed multiply(fixed other) const;
+		/// \brief Division truncated toward zero, division by zero saturates to min / max.
+		fixed divide(fixed other) const;
+
+		/// \brief self-explanatory
+		static fixed abs(fixed f);
+		/// \brief self-explanatory
+		static fixed min(fixed left, fixed right);
+		/// \brief self-explanatory
+		static fixed max(fixed left, fixed right);
+
+		/**
+		 * \brief Sum of left[i] * right[i] rounded once to nearest, as in dot products and matrix
+		 * multiplication. Products are accumulated exactly, so the result saturates instead of
+		 * overflowing, even when every raw value is near INT32_MIN / INT32_MAX.
+		 * \param left array of count values
+		 * \param right array of count values
+		 * \param count count of products (small, at most a few thousands)
+		 * \return saturated sum of products
+		 */
+		static fixed sumOfProducts(const fixed* left, const fixed* right, size_t count);
+
+		/**
+		 * \brief Square root computed bit by bit, rounded down. Negative values return 0.
+		 * \param f value
+		 * \return square root
+		 */
+		static fixed sqrt(fixed f);
+
+		/**
+		 * \brief Deterministic sine. Angle is reduced to [-pi/2; pi/2] and evaluated
+		 * with 9th order polynomial in Q2.30.
+		 * \param radians angle
+		 * \return sine of angle
+		 */
+		static fixed sine(fixed radians);
+
+		/**
+		 * \brief Deterministic cosine, computed as sine(radians + pi/2).
+		 * \param radians angle
+		 * \return cosine of angle
+		 */
+		static fixed cosine(fixed radians);
+
+		/// \brief Returns pi rounded to Q16.16.
+		static fixed pi();
+		/// \brief Returns 1.0.
+		static fixed one();
+
+		/// \brief self-explanatory
+		friend fixed operator+(fixed left, fixed right);
+		/// \brief self-explanatory
+		friend fixed operator-(fixed left, fixed right);
+		/// \brief self-explanatory
+		friend fixed operator*(fixed left, fixed right);
+		/// \brief self-explanatory
+		friend fixed operator/(fixed left, fixed right);
+		/// \brief self-explanatory
+		friend fixed operator-(fixed f);
+		/// \brief self-explanatory
+		bool operator==(fixed other) const;
+		/// \brief self-explanatory
+		bool operator!=(fixed other) const;
+		/// \brief self-explanatory
+		bool operator<(fixed other) const;
+		/// \brief self-explanatory
+		bool operator>(fixed other) const;
+		/// \brief self-explanatory
+		bool operator<=(fixed other) const;
+		/// \brief self-explanatory
+		bool operator>=(fixed other) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_FIXED_H
@@ -0,0 +1,167 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "fixedmat4.h"
+#include "mat4.h"
+
+
+namespace marengine::maths {
+
+
+	fixedMat4::fixedMat4() :
+		elements()
+	{}
+
+	fixedMat4::fixedMat4(fixed diagonal) :
+		elements()
+	{
+		elements[0 + 0 * 4] = diagonal;
+		elements[1 + 1 * 4] = diagonal;
+		elements[2 + 2 * 4] = diagonal;
+		elements[3 + 3 * 4] = diagonal;
+	}
+
+	fixedMat4 fixedMat4::identity() {
+		return fixedMat4(fixed::one());
+	}
+
+	fixedMat4 fixedMat4::fromMat4(const mat4& m) {
+		fixedMat4 result;
+		for (size_t i = 0; i < 16; i++) {
+			result.elements[i] = fixed::fromFloat(m.elements[i]);
+		}
+		return result;
+	}
+
+	mat4 fixedMat4::toMat4() const {
+		mat4 result;
+		for (size_t i = 0; i < 16; i++) {
+			result.elements[i] = elements[i].toFloat();
+		}
+		return result;
+	}
+
+	fixedMat4 fixedMat4::translation(fixedVec3 trans) {
+		fixedMat4 result{ identity() };
+		result.elements[0 + 3 * 4] = trans.x;
+		result.elements[1 + 3 * 4] = trans.y;
+		result.elements[2 + 3 * 4] = trans.z;
+		return result;
+	}
+
+	fixedMat4 fixedMat4::scale(fixedVec3 scal) {
+		fixedMat4 result{ identity() };
+		result.elements[0 + 0 * 4] = scal.x;
+		result.elements[1 + 1 * 4] = scal.y;
+		result.elements[2 + 2 * 4] = scal.z;
+		return result;
+	}
+
+	fixedMat4 fixedMat4::rotation(fixedQuat q) {
+		const fixed one{ fixed::one() };
+		const fixed two{ fixed::fromInt(2) };
+		const fixed xx{ q.x * q.x }, yy{ q.y * q.y }, zz{ q.z * q.z };
+		const fixed xy{ q.x * q.y }, xz{ q.x * q.z }, yz{ q.y * q.z };
+		const fixed wx{ q.w * q.x }, wy{ q.w * q.y }, wz{ q.w * q.z };
+
+		fixedMat4 result{ identity() };
+		result.elements[0 + 0 * 4] = one - two * (yy + zz);
+		result.elements[1 + 0 * 4] = two * (xy + wz);
+		result.elements[2 + 0 * 4] = two * (xz - wy);
+
+		result.elements[0 + 1 * 4] = two * (xy - wz);
+		result.elements[1 + 1 * 4] = one - two * (xx + zz);
+		result.elements[2 + 1 * 4] = two * (yz + wx);
+
+		result.elements[0 + 2 * 4] = two * (xz + wy);
+		result.elements[1 + 2 * 4] = two * (yz - wx);
+		result.elements[2 + 2 * 4] = one - two * (xx + yy);
+		return result;
+	}
+
+	fixedMat4 fixedMat4::transform(fixedVec3 trans, fixedQuat q, fixedVec3 scal) {
+		fixedMat4 result{ rotation(q) };
+		for (size_t col = 0; col < 3; col++) {
+			const fixed s{ col == 0 ? scal.x : col == 1 ? scal.y : scal.z };
+			for (size_t row = 0; row < 3; row++) {
+				result.elements[row + col * 4] = result.elements[row + col * 4] * s;
+			}
+		}
+		result.elements[0 + 3 * 4] = trans.x;
+		result.elements[1 + 3 * 4] = trans.y;
+		result.elements[2 + 3 * 4] = trans.z;
+		return result;
+	}
+
+	fixedMat4 fixedMat4::multiply(const fixedMat4& other) const {
+		fixedMat4 result;
+		for (size_t col = 0; col < 4; col++) {
+			for (size_t row = 0; row < 4; row++) {
+				const fixed rowValues[4]{ elements[row + 0 * 4], elements[row + 1 * 4], elements[row + 2 * 4], elements[row + 3 * 4] };
+				result.elements[row + col * 4] = fixed::sumOfProducts(rowValues, other.elements + col * 4, 4);
+			}
+		}
+		return result;
+	}
+
+	fixedVec3 fixedMat4::transformPoint(fixedVec3 point) const {
+		fixedVec3 result;
+		transformPoints(*this, &point, &result, 1);
+		return result;
+	}
+
+	void fixedMat4::transformPoints(const fixedMat4& m, const fixedVec3* in, fixedVec3* out, size_t count) {
+		const fixed rows[3][4]{
+			{ m.elements[0], m.elements[4], m.elements[8], m.elements[12] },
+			{ m.elements[1], m.elements[5], m.elements[9], m.elements[13] },
+			{ m.elements[2], m.elements[6], m.elements[10], m.elements[14] }
+		};
+		for (size_t i = 0; i < count; i++) {
+			const fixed point[4]{ in[i].x, in[i].y, in[i].z, fixed::one() };
+			out[i] = {
+				fixed::sumOfProducts(rows[0], point, 4),
+				fixed::sumOfProducts(rows[1], point, 4),
+				fixed::sumOfProducts(rows[2], point, 4)
+			};
+		}
+	}
+
+	fixedMat4 operator*(const fixedMat4& left, const fixedMat4& right) {
+		return left.multiply(right);
+	}
+
+	bool fixedMat4::operator==(const fixedMat4& other) const {
+		for (size_t i = 0; i < 16; i++) {
+			if (elements[i] != other.elements[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool fixedMat4::operator!=(const fixedMat4& other) const {
+		return !(*this == other);
+	}
+
+
+}
@@ -0,0 +1,114 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_FIXEDMAT4_H
+#define MAR_MATH_FIXEDMAT4_H
+
+
+#include "maths.h"
+#include "fixed.h"
+#include "fixedvec3.h"
+#include "fixedquat.h"
+
+
+namespace marengine::maths {
+
+	struct mat4;
+
+
+	/**
+	 * \struct fixedMat4 fixedmat4.h "fixedmat4.h"
+	 * \brief 4x4 matrix of Q16.16 fixed values for deterministic simulation. Elements are
+	 * stored in column major order as in mat4, as 16 packed int32_t. Every output element is
+	 * accumulated in 64 bits and rounded once, so scalar and batch methods return the same bits.
+	 */
+	struct fixedMat4 {
+
+		/// \brief elements of matrix in column major order
+		fixed elements[4 * 4];
+
+		/// \brief Default constructor, creates zero matrix.
+		fixedMat4();
+
+		/**
+		 * \brief Constructor, that creates diagonal matrix.
+		 * \param diagonal value placed on diagonal
+		 */
+		fixedMat4(fixed diagonal);
+
+		/// \brief self-explanatory
+		static fixedMat4 identity();
+		/// \brief self-explanatory
+		static fixedMat4 fromMat4(const mat4& m);
+		/// \brief self-explanatory
+		mat4 toMat4() const;
+
+		/// \brief self-explanatory
+		static fixedMat4 translation(fixedVec3 trans);
+		/// \brief self-explanatory
+		static fixedMat4 scale(fixedVec3 scal);
+		/// \brief Creates rotation matrix from unit quaternion.
+		static fixedMat4 rotation(fixedQuat q);
+
+		/**
+		 * \brief Creates translation * rotation * scale matrix.
+		 * \param trans translation
+		 * \param q unit quaternion
+		 * \param scal scale
+		 * \return created matrix
+		 */
+		static fixedMat4 transform(fixedVec3 trans, fixedQuat q, fixedVec3 scal);
+
+		/// \brief self-explanatory
+		fixedMat4 multiply(const fixedMat4& other) const;
+
+		/**
+		 * \brief Transforms point (w = 1).
+		 * \param point fixedVec3
+		 * \return transformed point
+		 */
+		fixedVec3 transformPoint(fixedVec3 point) const;
+
+		/**
+		 * \brief Transforms count points by the same matrix. Integer loops only, so it vectorizes.
+		 * \param m matrix
+		 * \param in array of count points
+		 * \param out array of count points, can be equal to in
+		 * \param count count of points
+		 */
+		static void transformPoints(const fixedMat4& m, const fixedVec3* in, fixedVec3* out, size_t count);
+
+		/// \brief self-explanatory
+		friend fixedMat4 operator*(const fixedMat4& left, const fixedMat4& right);
+		/// \brief self-explanatory
+		bool operator==(const fixedMat4& other) const;
+		/// \brief self-explanatory
+		bool operator!=(const fixedMat4& other) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_FIXEDMAT4_H
@@ -0,0 +1,100 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "fixedquat.h"
+#include "quat.h"
+
+
+namespace marengine::maths {
+
+
+	fixedQuat::fixedQuat() :
+		w(fixed::one()),
+		x(),
+		y(),
+		z()
+	{}
+
+	fixedQuat::fixedQuat(fixed _w, fixed _x, fixed _y, fixed _z) :
+		w(_w),
+		x(_x),
+		y(_y),
+		z(_z)
+	{}
+
+	fixedQuat fixedQuat::fromAxisAngle(fixedVec3 axis, fixed radians) {
+		const fixed half{ fixed::fromRaw(radians.raw / 2) };
+		const fixed s{ fixed::sine(half) };
+		return { fixed::cosine(half), axis.x * s, axis.y * s, axis.z * s };
+	}
+
+	fixedQuat fixedQuat::fromQuat(const quat& q) {
+		return { fixed::fromFloat(q.w), fixed::fromFloat(q.x), fixed::fromFloat(q.y), fixed::fromFloat(q.z) };
+	}
+
+	quat fixedQuat::toQuat() const {
+		return { w.toFloat(), x.toFloat(), y.toFloat(), z.toFloat() };
+	}
+
+	fixedQuat fixedQuat::multiply(fixedQuat other) const {
+		return {
+			w * other.w - x * other.x - y * other.y - z * other.z,
+			w * other.x + x * other.w + y * other.z - z * other.y,
+			w * other.y - x * other.z + y * other.w + z * other.x,
+			w * other.z + x * other.y - y * other.x + z * other.w
+		};
+	}
+
+	fixedQuat fixedQuat::conjugate(fixedQuat q) {
+		return { q.w, -q.x, -q.y, -q.z };
+	}
+
+	fixedQuat fixedQuat::normalize(fixedQuat q) {
+		const fixed len{ fixed::sqrt(q.w * q.w + fixedVec3::dot({ q.x, q.y, q.z }, { q.x, q.y, q.z })) };
+		if (len.raw == 0) {
+			return fixedQuat();
+		}
+		return { q.w / len, q.x / len, q.y / len, q.z / len };
+	}
+
+	fixedVec3 fixedQuat::rotate(fixedQuat q, fixedVec3 v) {
+		// v + 2w(u x v) + 2u x (u x v)
+		const fixedVec3 u{ q.x, q.y, q.z };
+		const fixedVec3 t{ fixedVec3::cross(u, v) * fixed::fromInt(2) };
+		return v + t * q.w + fixedVec3::cross(u, t);
+	}
+
+	fixedQuat operator*(fixedQuat left, fixedQuat right) {
+		return left.multiply(right);
+	}
+
+	bool fixedQuat::operator==(fixedQuat other) const {
+		return w == other.w && x == other.x && y == other.y && z == other.z;
+	}
+
+	bool fixedQuat::operator!=(fixedQuat other) const {
+		return !(*this == other);
+	}
+
+
+}
@@ -0,0 +1,117 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_FIXEDQUAT_H
+#define MAR_MATH_FIXEDQUAT_H
+
+
+#include "maths.h"
+#include "fixed.h"
+#include "fixedvec3.h"
+
+
+namespace marengine::maths {
+
+	struct quat;
+
+
+	/**
+	 * \struct fixedQuat fixedquat.h "fixedquat.h"
+	 * \brief Quaternion of Q16.16 fixed values for deterministic simulation. Members are
+	 * ordered w, x, y, z as in quat.
+	 */
+	struct fixedQuat {
+
+		/// \brief w value of fixedQuat
+		fixed w;
+		/// \brief x value of fixedQuat
+		fixed x;
+		/// \brief y value of fixedQuat
+		fixed y;
+		/// \brief z value of fixedQuat
+		fixed z;
+
+		/// \brief Default constructor, creates identity fixedQuat(1, 0, 0, 0).
+		fixedQuat();
+
+		/**
+		 * \brief Constructor, that can create fixedQuat from given 4 fixed values.
+		 * \param _w w value
+		 * \param _x x value
+		 * \param _y y value
+		 * \param _z z value
+		 */
+		fixedQuat(fixed _w, fixed _x, fixed _y, fixed _z);
+
+		/**
+		 * \brief Creates rotation around given axis with deterministic sine / cosine.
+		 * \param axis normalized rotation axis
+		 * \param radians angle of rotation
+		 * \return created fixedQuat
+		 */
+		static fixedQuat fromAxisAngle(fixedVec3 axis, fixed radians);
+
+		/// \brief self-explanatory
+		static fixedQuat fromQuat(const quat& q);
+		/// \brief self-explanatory
+		quat toQuat() const;
+
+		/**
+		 * \brief Hamilton product, applies right rotation first.
+		 * \param other second fixedQuat
+		 * \return computed fixedQuat
+		 */
+		fixedQuat multiply(fixedQuat other) const;
+
+		/// \brief self-explanatory
+		static fixedQuat conjugate(fixedQuat q);
+
+		/**
+		 * \brief Normalizes quaternion, zero quaternion returns identity.
+		 * \param q fixedQuat
+		 * \return normalized fixedQuat
+		 */
+		static fixedQuat normalize(fixedQuat q);
+
+		/**
+		 * \brief Rotates vector by given unit quaternion.
+		 * \param q unit fixedQuat
+		 * \param v vector, which will be rotated
+		 * \return rotated vector
+		 */
+		static fixedVec3 rotate(fixedQuat q, fixedVec3 v);
+
+		/// \brief self-explanatory
+		friend fixedQuat operator*(fixedQuat left, fixedQuat right);
+		/// \brief self-explanatory
+		bool operator==(fixedQuat other) const;
+		/// \brief self-explanatory
+		bool operator!=(fixedQuat other) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_FIXEDQUAT_H
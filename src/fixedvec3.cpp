@@ -0,0 +1,114 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "fixedvec3.h"
+#include "vec3.h"
+
+
+namespace marengine::maths {
+
+
+	fixedVec3::fixedVec3() :
+		x(),
+		y(),
+		z()
+	{}
+
+	fixedVec3::fixedVec3(fixed _x, fixed _y, fixed _z) :
+		x(_x),
+		y(_y),
+		z(_z)
+	{}
+
+	fixedVec3 fixedVec3::fromVec3(const vec3& v) {
+		return { fixed::fromFloat(v.x), fixed::fromFloat(v.y), fixed::fromFloat(v.z) };
+	}
+
+	vec3 fixedVec3::toVec3() const {
+		return { x.toFloat(), y.toFloat(), z.toFloat() };
+	}
+
+	fixedVec3 fixedVec3::add(fixedVec3 other) const {
+		return { x + other.x, y + other.y, z + other.z };
+	}
+
+	fixedVec3 fixedVec3::subtract(fixedVec3 other) const {
+		return { x - other.x, y - other.y, z - other.z };
+	}
+
+	fixedVec3 fixedVec3::multiply(fixed f) const {
+		return { x * f, y * f, z * f };
+	}
+
+	fixed fixedVec3::dot(fixedVec3 left, fixedVec3 right) {
+		const fixed l[3]{ left.x, left.y, left.z };
+		const fixed r[3]{ right.x, right.y, right.z };
+		return fixed::sumOfProducts(l, r, 3);
+	}
+
+	fixedVec3 fixedVec3::cross(fixedVec3 left, fixedVec3 right) {
+		return {
+			left.y * right.z - left.z * right.y,
+			left.z * right.x - left.x * right.z,
+			left.x * right.y - left.y * right.x
+		};
+	}
+
+	fixed fixedVec3::length(fixedVec3 v) {
+		return fixed::sqrt(dot(v, v));
+	}
+
+	fixedVec3 fixedVec3::normalize(fixedVec3 v) {
+		const fixed len{ length(v) };
+		if (len.raw == 0) {
+			return fixedVec3();
+		}
+		return { v.x / len, v.y / len, v.z / len };
+	}
+
+	fixedVec3 operator+(fixedVec3 left, fixedVec3 right) {
+		return left.add(right);
+	}
+
+	fixedVec3 operator-(fixedVec3 left, fixedVec3 right) {
+		return left.subtract(right);
+	}
+
+	fixedVec3 operator*(fixedVec3 left, fixed right) {
+		return left.multiply(right);
+	}
+
+	fixedVec3 operator-(fixedVec3 v) {
+		return { -v.x, -v.y, -v.z };
+	}
+
+	bool fixedVec3::operator==(fixedVec3 other) const {
+		return x == other.x && y == other.y && z == other.z;
+	}
+
+	bool fixedVec3::operator!=(fixedVec3 other) const {
+		return !(*this == other);
+	}
+
+
+}
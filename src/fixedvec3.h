@@ -0,0 +1,116 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_FIXEDVEC3_H
+#define MAR_MATH_FIXEDVEC3_H
+
+
+#include "maths.h"
+#include "fixed.h"
+
+
+namespace marengine::maths {
+
+	struct vec3;
+
+
+	/**
+	 * \struct fixedVec3 fixedvec3.h "fixedvec3.h"
+	 * \brief 3-dimensional vector of Q16.16 fixed values for deterministic simulation.
+	 * Layout is 3 packed int32_t, so arrays of fixedVec3 are plain integer streams.
+	 */
+	struct fixedVec3 {
+
+		/// \brief x value of fixedVec3
+		fixed x;
+		/// \brief y value of fixedVec3
+		fixed y;
+		/// \brief z value of fixedVec3
+		fixed z;
+
+
+		/// \brief Default constructor, creates fixedVec3(0, 0, 0).
+		fixedVec3();
+
+		/**
+		 * \brief Constructor, that can create fixedVec3 from given 3 fixed values.
+		 * \param _x x value
+		 * \param _y y value
+		 * \param _z z value
+		 */
+		fixedVec3(fixed _x, fixed _y, fixed _z);
+
+		/**
+		 * \brief Converts vec3 to fixedVec3, rounding every value to nearest.
+		 * \param v vec3
+		 * \return converted fixedVec3
+		 */
+		static fixedVec3 fromVec3(const vec3& v);
+
+		/**
+		 * \brief Converts fixedVec3 to vec3, ex: for rendering.
+		 * \return converted vec3
+		 */
+		vec3 toVec3() const;
+
+		/// \brief self-explanatory
+		fixedVec3 add(fixedVec3 other) const;
+		/// \brief self-explanatory
+		fixedVec3 subtract(fixedVec3 other) const;
+		/// \brief self-explanatory
+		fixedVec3 multiply(fixed f) const;
+
+		/// \brief self-explanatory
+		static fixed dot(fixedVec3 left, fixedVec3 right);
+		/// \brief self-explanatory
+		static fixedVec3 cross(fixedVec3 left, fixedVec3 right);
+		/// \brief self-explanatory
+		static fixed length(fixedVec3 v);
+
+		/**
+		 * \brief Normalizes given vector. Zero vector stays zero.
+		 * \param v fixedVec3
+		 * \return normalized vector
+		 */
+		static fixedVec3 normalize(fixedVec3 v);
+
+		/// \brief self-explanatory
+		friend fixedVec3 operator+(fixedVec3 left, fixedVec3 right);
+		/// \brief self-explanatory
+		friend fixedVec3 operator-(fixedVec3 left, fixedVec3 right);
+		/// \brief self-explanatory
+		friend fixedVec3 operator*(fixedVec3 left, fixed right);
+		/// \brief self-explanatory
+		friend fixedVec3 operator-(fixedVec3 v);
+		/// \brief self-explanatory
+		bool operator==(fixedVec3 other) const;
+		/// \brief self-explanatory
+		bool operator!=(fixedVec3 other) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_FIXEDVEC3_H
@@ -0,0 +1,78 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "frustum.h"
+#include "vec3.h"
+#include "mat4.h"
+#include <cmath>
+
+
+namespace marengine::maths {
+
+
+	static vec4 normalizePlane(vec4 plane) {
+		const float len{ std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z) };
+		if (len == 0.f) {
+			return plane;
+		}
+		return plane * (1.f / len);
+	}
+
+
+	frustum frustum::fromMatrix(const mat4& viewProjection, bool zeroToOne) {
+		const float* m{ viewProjection.elements };
+		const vec4 row0{ m[0], m[4], m[8], m[12] };
+		const vec4 row1{ m[1], m[5], m[9], m[13] };
+		const vec4 row2{ m[2], m[6], m[10], m[14] };
+		const vec4 row3{ m[3], m[7], m[11], m[15] };
+
+		frustum result;
+		result.planes[Left] = normalizePlane(row3 + row0);
+		result.planes[Right] = normalizePlane(row3 - row0);
+		result.planes[Bottom] = normalizePlane(row3 + row1);
+		result.planes[Top] = normalizePlane(row3 - row1);
+		result.planes[Near] = normalizePlane(zeroToOne ? row2 : row3 + row2);
+		result.planes[Far] = normalizePlane(row3 - row2);
+		return result;
+	}
+
+	bool frustum::containsPoint(vec3 point) const {
+		for (const vec4& p : planes) {
+			if (p.x * point.x + p.y * point.y + p.z * point.z + p.w < 0.f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool frustum::intersectsSphere(vec3 center, float radius) const {
+		for (const vec4& p : planes) {
+			if (p.x * center.x + p.y * center.y + p.z * center.z + p.w < -radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+}
@@ -0,0 +1,80 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_FRUSTUM_H
+#define MAR_MATH_FRUSTUM_H
+
+
+#include "maths.h"
+#include "vec4.h"
+
+
+namespace marengine::maths {
+
+	struct vec3;
+	struct mat4;
+
+
+	/**
+	 * \struct frustum frustum.h "frustum.h"
+	 * \brief Six planes of view frustum. Every plane is stored as vec4(normal, distance) with
+	 * normalized normal pointing inside, so point p is inside, if dot(normal, p) + distance >= 0.
+	 */
+	struct frustum {
+
+		/// \brief Indexes of planes.
+		enum plane : size_t { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+		/// \brief planes of frustum
+		vec4 planes[Count];
+
+		/**
+		 * \brief Extracts planes from view-projection matrix (Gribb / Hartmann method).
+		 * \param viewProjection projection * view matrix
+		 * \param zeroToOne true, if projection maps depth to [0;1] (Direct3D / Vulkan), false for OpenGL [-1;1]
+		 * \return extracted frustum
+		 */
+		static frustum fromMatrix(const mat4& viewProjection, bool zeroToOne = false);
+
+		/**
+		 * \brief Checks, if point lies inside frustum.
+		 * \param point point in world space
+		 * \return true, if point is inside
+		 */
+		bool containsPoint(vec3 point) const;
+
+		/**
+		 * \brief Conservative test of sphere against frustum.
+		 * \param center center of sphere in world space
+		 * \param radius radius of sphere
+		 * \return false, if sphere is fully outside of any plane
+		 */
+		bool intersectsSphere(vec3 center, float radius) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_FRUSTUM_H
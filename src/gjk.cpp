@@ -0,0 +1,564 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "gjk.h"
+#include "convex.h"
+#include "parallel.h"
+#include "instrumentation.h"
+#include <cfloat>
+#include <cmath>
+#include <initializer_list>
+
+
+namespace marengine::maths {
+
+
+	static constexpr uint32_t g_gjkMaxIterations{ 64 };
+	static constexpr uint32_t g_epaMaxIterations{ 64 };
+	static constexpr uint32_t g_epaMaxVertices{ 4 + g_epaMaxIterations };
+	static constexpr uint32_t g_epaMaxFaces{ 256 };
+	static constexpr uint32_t g_epaMaxEdges{ 128 };
+	static constexpr size_t g_pairElementCost{ 16 };
+
+	/// Vertex of Minkowski difference A - B together with points of A and B, that produced it.
+	struct gjkVertex {
+		vec3 w;
+		vec3 a;
+		vec3 b;
+		vec3 direction;
+	};
+
+	struct gjkSimplex {
+		gjkVertex vertices[4];
+		float lambda[4];
+		uint32_t count;
+	};
+
+	struct epaFace {
+		uint32_t indices[3];
+		vec3 normal;
+		float distance;
+	};
+
+	static float lengthSquared(vec3 v) {
+		return v.x * v.x + v.y * v.y + v.z * v.z;
+	}
+
+	static gjkVertex supportVertex(const convexShape& a, const convexShape& b, vec3 direction) {
+		const vec3 pointA{ a.support(direction) };
+		const vec3 pointB{ b.support(direction * -1.f) };
+		return { pointA - pointB, pointA, pointB, direction };
+	}
+
+	// Keeps given vertices of simplex with given barycentric weights and returns closest point.
+	static vec3 reduce(gjkSimplex& s, std::initializer_list<uint32_t> keep, std::initializer_list<float> weights) {
+		gjkVertex kept[4];
+		uint32_t count{ 0 };
+		for (uint32_t index : keep) {
+			kept[count++] = s.vertices[index];
+		}
+		vec3 closest{ 0.f, 0.f, 0.f };
+		count = 0;
+		for (float weight : weights) {
+			s.vertices[count] = kept[count];
+			s.lambda[count] = weight;
+			closest = closest + kept[count].w * weight;
+			count++;
+		}
+		s.count = count;
+		return closest;
+	}
+
+	static vec3 solveSegment(gjkSimplex& s) {
+		const vec3 a{ s.vertices[0].w };
+		const vec3 ab{ s.vertices[1].w - a };
+		const float t{ -vec3::dot(a, ab) };
+		if (t <= 0.f) {
+			return reduce(s, { 0 }, { 1.f });
+		}
+		const float denominator{ lengthSquared(ab) };
+		if (t >= denominator) {
+			return reduce(s, { 1 }, { 1.f });
+		}
+		return reduce(s, { 0, 1 }, { 1.f - t / denominator, t / denominator });
+	}
+
+	// Closest point of triangle to origin by Voronoi regions (Ericson, Real-Time Collision Detection 5.1.5).
+	static vec3 solveTriangle(gjkSimplex& s) {
+		const vec3 a{ s.vertices[0].w };
+		const vec3 b{ s.vertices[1].w };
+		const vec3 c{ s.vertices[2].w };
+		const vec3 ab{ b - a };
+		const vec3 ac{ c - a };
+
+		const float d1{ -vec3::dot(ab, a) };
+		const float d2{ -vec3::dot(ac, a) };
+		if (d1 <= 0.f && d2 <= 0.f) {
+			return reduce(s, { 0 }, { 1.f });
+		}
+
+		const float d3{ -vec3::dot(ab, b) };
+		const float d4{ -vec3::dot(ac, b) };
+		if (d3 >= 0.f && d4 <= d3) {
+			return reduce(s, { 1 }, { 1.f });
+		}
+
+		const float vc{ d1 * d4 - d3 * d2 };
+		if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
+			const float t{ d1 / (d1 - d3) };
+			return reduce(s, { 0, 1 }, { 1.f - t, t });
+		}
+
+		const float d5{ -vec3::dot(ab, c) };
+		const float d6{ -vec3::dot(ac, c) };
+		if (d6 >= 0.f && d5 <= d6) {
+			return reduce(s, { 2 }, { 1.f });
+		}
+
+		const float vb{ d5 * d2 - d1 * d6 };
+		if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
+			const float t{ d2 / (d2 - d6) };
+			return reduce(s, { 0, 2 }, { 1.f - t, t });
+		}
+
+		const float va{ d3 * d6 - d5 * d4 };
+		if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f) {
+			const float t{ (d4 - d3) / ((d4 - d3) + (d5 - d6)) };
+			return reduce(s, { 1, 2 }, { 1.f - t, t });
+		}
+
+		const float sum{ va + vb + vc };
+		if (!(sum > 0.f)) {
+			// Degenerate (collinear) triangle, closest point lies on its longest edge.
+			const float ab2{ lengthSquared(ab) };
+			const float ac2{ lengthSquared(ac) };
+			const float bc2{ lengthSquared(c - b) };
+			if (ab2 >= ac2 && ab2 >= bc2) {
+				reduce(s, { 0, 1 }, { 0.f, 0.f });
+			}
+			else if (ac2 >= bc2) {
+				reduce(s, { 0, 2 }, { 0.f, 0.f });
+			}
+			else {
+				reduce(s, { 1, 2 }, { 0.f, 0.f });
+			}
+			return solveSegment(s);
+		}
+
+		const float v{ vb / sum };
+		const float w{ vc / sum };
+		return reduce(s, { 0, 1, 2 }, { 1.f - v - w, v, w });
+	}
+
+	// Returns false, if origin is inside of tetrahedron, otherwise reduces simplex to closest face.
+	static bool solveTetrahedron(gjkSimplex& s, vec3& closest) {
+		static constexpr uint32_t faces[4][4]{ { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+		bool outsideAny{ false };
+		float best{ FLT_MAX };
+		gjkSimplex bestSimplex{};
+		for (const uint32_t* face : faces) {
+			const vec3 p{ s.vertices[face[0]].w };
+			const vec3 normal{ vec3::cross(s.vertices[face[1]].w - p, s.vertices[face[2]].w - p) };
+			const vec3 toOpposite{ s.vertices[face[3]].w - p };
+			const float signOrigin{ -vec3::dot(p, normal) };
+			const float signOpposite{ vec3::dot(toOpposite, normal) };
+			const bool degenerate{ signOpposite * signOpposite <= FLT_EPSILON * lengthSquared(normal) * lengthSquared(toOpposite) };
+			if (!degenerate && signOrigin * signOpposite >= 0.f) {
+				continue;
+			}
+
+			outsideAny = true;
+			gjkSimplex triangle{};
+			triangle.vertices[0] = s.vertices[face[0]];
+			triangle.vertices[1] = s.vertices[face[1]];
+			triangle.vertices[2] = s.vertices[face[2]];
+			triangle.count = 3;
+			const vec3 candidate{ solveTriangle(triangle) };
+			const float distance{ lengthSquared(candidate) };
+			if (distance < best) {
+				best = distance;
+				bestSimplex = triangle;
+				closest = candidate;
+			}
+		}
+
+		if (outsideAny) {
+			s = bestSimplex;
+		}
+		return outsideAny;
+	}
+
+	// Reduces simplex to the smallest subset containing closest point to origin. Returns false,
+	// if origin is inside of simplex (shapes intersect).
+	static bool solve(gjkSimplex& s, vec3& closest) {
+		switch (s.count) {
+		case 1:
+			s.lambda[0] = 1.f;
+			closest = s.vertices[0].w;
+			return true;
+		case 2:
+			closest = solveSegment(s);
+			return true;
+		case 3:
+			closest = solveTriangle(s);
+			return true;
+		default:
+			return solveTetrahedron(s, closest);
+		}
+	}
+
+	static void storeCache(const gjkSimplex& s, gjkCache* cache) {
+		if (cache) {
+			cache->count = s.count;
+			for (uint32_t i = 0; i < s.count; i++) {
+				cache->directions[i] = s.vertices[i].direction;
+			}
+		}
+	}
+
+	// Returns true, if shapes intersect. With earlyOut it stops at first separating direction,
+	// otherwise iterates until closest point v of A - B is found.
+	static bool runGjk(const convexShape& a, const convexShape& b, gjkCache* cache, bool earlyOut, gjkSimplex& s,
+		vec3& v, uint32_t& iterations)
+	{
+		s.count = 0;
+		if (cache) {
+			for (uint32_t i = 0; i < cache->count && i < 4; i++) {
+				const gjkVertex vertex{ supportVertex(a, b, cache->directions[i]) };
+				bool duplicate{ false };
+				for (uint32_t j = 0; j < s.count; j++) {
+					duplicate = duplicate || lengthSquared(vertex.w - s.vertices[j].w) <= FLT_EPSILON * FLT_EPSILON;
+				}
+				if (!duplicate) {
+					s.vertices[s.count++] = vertex;
+				}
+			}
+		}
+		if (s.count == 0) {
+			vec3 direction{ b.center() - a.center() };
+			if (lengthSquared(direction) == 0.f) {
+				direction = { 1.f, 0.f, 0.f };
+			}
+			s.vertices[s.count++] = supportVertex(a, b, direction);
+		}
+
+		iterations = 0;
+		bool intersecting{ !solve(s, v) };
+		while (!intersecting && iterations < g_gjkMaxIterations) {
+			iterations++;
+			float scale{ 0.f };
+			for (uint32_t i = 0; i < s.count; i++) {
+				const float w2{ lengthSquared(s.vertices[i].w) };
+				scale = w2 > scale ? w2 : scale;
+			}
+			const float v2{ lengthSquared(v) };
+			if (v2 <= FLT_EPSILON * scale) {
+				intersecting = true; // origin lies on simplex, shapes touch
+				break;
+			}
+
+			const gjkVertex w{ supportVertex(a, b, v * -1.f) };
+			const float vw{ vec3::dot(v, w.w) };
+			if (earlyOut && vw > 0.f) {
+				break; // -v is separating direction
+			}
+			if (v2 - vw <= 1e-6f * v2) {
+				break; // w doesn't get closer to origin than v, v is the closest point
+			}
+			bool duplicate{ false };
+			for (uint32_t i = 0; i < s.count; i++) {
+				duplicate = duplicate || s.vertices[i].w == w.w;
+			}
+			if (duplicate) {
+				break;
+			}
+
+			const gjkSimplex previous{ s };
+			s.vertices[s.count++] = w;
+			vec3 next;
+			if (!solve(s, next)) {
+				intersecting = true;
+				break;
+			}
+			if (lengthSquared(next) >= v2) {
+				s = previous; // no progress, numerical limit is reached, keep simplex and weights matching v
+				break;
+			}
+			v = next;
+		}
+
+		storeCache(s, cache);
+		return intersecting;
+	}
+
+	static void witnessPoints(const gjkSimplex& s, vec3& pointA, vec3& pointB) {
+		pointA = { 0.f, 0.f, 0.f };
+		pointB = { 0.f, 0.f, 0.f };
+		for (uint32_t i = 0; i < s.count; i++) {
+			pointA = pointA + s.vertices[i].a * s.lambda[i];
+			pointB = pointB + s.vertices[i].b * s.lambda[i];
+		}
+	}
+
+	static vec3 fallbackNormal(const convexShape& a, const convexShape& b) {
+		const vec3 direction{ b.center() - a.center() };
+		const float length{ std::sqrt(lengthSquared(direction)) };
+		return length > 0.f ? direction / length : vec3(0.f, 1.f, 0.f);
+	}
+
+	// Adds support vertices, until simplex is non-degenerate tetrahedron.
+	static bool blowUp(const convexShape& a, const convexShape& b, gjkSimplex& s) {
+		const vec3 axes[6]{ { 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f } };
+		if (s.count == 1) {
+			for (const vec3& axis : axes) {
+				const gjkVertex vertex{ supportVertex(a, b, axis) };
+				if (lengthSquared(vertex.w - s.vertices[0].w) > FLT_EPSILON) {
+					s.vertices[s.count++] = vertex;
+					break;
+				}
+			}
+		}
+		if (s.count == 2) {
+			const vec3 line{ s.vertices[1].w - s.vertices[0].w };
+			for (const vec3& axis : axes) {
+				const vec3 direction{ vec3::cross(line, axis) };
+				if (lengthSquared(direction) <= FLT_EPSILON * lengthSquared(line)) {
+					continue;
+				}
+				const gjkVertex vertex{ supportVertex(a, b, direction) };
+				if (lengthSquared(vec3::cross(vertex.w - s.vertices[0].w, line)) > FLT_EPSILON * lengthSquared(line)) {
+					s.vertices[s.count++] = vertex;
+					break;
+				}
+			}
+		}
+		if (s.count == 3) {
+			const vec3 normal{ vec3::cross(s.vertices[1].w - s.vertices[0].w, s.vertices[2].w - s.vertices[0].w) };
+			for (const vec3& direction : { normal, normal * -1.f }) {
+				const gjkVertex vertex{ supportVertex(a, b, direction) };
+				const float height{ vec3::dot(vertex.w - s.vertices[0].w, normal) };
+				if (height * height > FLT_EPSILON * lengthSquared(normal)) {
+					s.vertices[s.count++] = vertex;
+					break;
+				}
+			}
+		}
+		return s.count == 4;
+	}
+
+	static bool makeFace(const gjkVertex* vertices, uint32_t i, uint32_t j, uint32_t k, epaFace& face) {
+		const vec3 normal{ vec3::cross(vertices[j].w - vertices[i].w, vertices[k].w - vertices[i].w) };
+		const float length{ std::sqrt(lengthSquared(normal)) };
+		if (!(length > 0.f)) {
+			return false;
+		}
+		face.indices[0] = i;
+		face.indices[1] = j;
+		face.indices[2] = k;
+		face.normal = normal / length;
+		face.distance = vec3::dot(face.normal, vertices[i].w);
+		return true;
+	}
+
+	// Expanding polytope algorithm, simplex must be tetrahedron containing origin.
+	static bool runEpa(const convexShape& a, const convexShape& b, const gjkSimplex& s, convexResult& result) {
+		gjkVertex vertices[g_epaMaxVertices];
+		epaFace faces[g_epaMaxFaces];
+		uint32_t edges[g_epaMaxEdges][2];
+		uint32_t vertexCount{ 4 };
+		uint32_t faceCount{ 0 };
+		for (uint32_t i = 0; i < 4; i++) {
+			vertices[i] = s.vertices[i];
+		}
+
+		// Faces of tetrahedron with normals pointing away from opposite vertex.
+		static constexpr uint32_t tetrahedron[4][4]{ { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+		for (const uint32_t* t : tetrahedron) {
+			epaFace face;
+			if (!makeFace(vertices, t[0], t[1], t[2], face)) {
+				return false;
+			}
+			if (vec3::dot(face.normal, vertices[t[3]].w - vertices[t[0]].w) > 0.f) {
+				makeFace(vertices, t[0], t[2], t[1], face);
+			}
+			faces[faceCount++] = face;
+		}
+
+		uint32_t closest{ 0 };
+		for (uint32_t iteration = 0; iteration < g_epaMaxIterations; iteration++) {
+			closest = 0;
+			for (uint32_t i = 1; i < faceCount; i++) {
+				if (faces[i].distance < faces[closest].distance) {
+					closest = i;
+				}
+			}
+
+			const epaFace best{ faces[closest] };
+			const gjkVertex w{ supportVertex(a, b, best.normal) };
+			const float growth{ vec3::dot(w.w, best.normal) - best.distance };
+			if (growth <= 1e-4f * (best.distance > 1.f ? best.distance : 1.f) || vertexCount == g_epaMaxVertices) {
+				break;
+			}
+
+			// Remove faces visible from w, their boundary (horizon) is made of edges,
+			// which are not shared by two removed faces.
+			const uint32_t newIndex{ vertexCount };
+			vertices[vertexCount++] = w;
+			uint32_t edgeCount{ 0 };
+			uint32_t kept{ 0 };
+			bool overflow{ false };
+			for (uint32_t i = 0; i < faceCount; i++) {
+				const epaFace& face{ faces[i] };
+				if (vec3::dot(face.normal, w.w - vertices[face.indices[0]].w) <= 0.f) {
+					faces[kept++] = face;
+					continue;
+				}
+				for (uint32_t e = 0; e < 3; e++) {
+					const uint32_t from{ face.indices[e] };
+					const uint32_t to{ face.indices[(e + 1) % 3] };
+					bool shared{ false };
+					for (uint32_t j = 0; j < edgeCount; j++) {
+						if (edges[j][0] == to && edges[j][1] == from) {
+							edges[j][0] = edges[edgeCount - 1][0];
+							edges[j][1] = edges[edgeCount - 1][1];
+							edgeCount--;
+							shared = true;
+							break;
+						}
+					}
+					if (!shared) {
+						if (edgeCount == g_epaMaxEdges) {
+							overflow = true;
+							break;
+						}
+						edges[edgeCount][0] = from;
+						edges[edgeCount][1] = to;
+						edgeCount++;
+					}
+				}
+			}
+			faceCount = kept;
+			if (overflow || faceCount + edgeCount > g_epaMaxFaces) {
+				faces[faceCount++] = best;
+				closest = faceCount - 1;
+				break;
+			}
+			for (uint32_t e = 0; e < edgeCount; e++) {
+				epaFace face;
+				if (makeFace(vertices, edges[e][0], edges[e][1], newIndex, face)) {
+					faces[faceCount++] = face;
+				}
+			}
+			if (faceCount == 0) {
+				return false;
+			}
+		}
+
+		closest = 0;
+		for (uint32_t i = 1; i < faceCount; i++) {
+			if (faces[i].distance < faces[closest].distance) {
+				closest = i;
+			}
+		}
+		const epaFace& face{ faces[closest] };
+
+		// Barycentric coordinates of origin projected on the closest face give contact points.
+		const gjkVertex& v0{ vertices[face.indices[0]] };
+		const gjkVertex& v1{ vertices[face.indices[1]] };
+		const gjkVertex& v2{ vertices[face.indices[2]] };
+		const vec3 p{ face.normal * face.distance };
+		const vec3 e0{ v1.w - v0.w };
+		const vec3 e1{ v2.w - v0.w };
+		const vec3 e2{ p - v0.w };
+		const float d00{ vec3::dot(e0, e0) };
+		const float d01{ vec3::dot(e0, e1) };
+		const float d11{ vec3::dot(e1, e1) };
+		const float d20{ vec3::dot(e2, e0) };
+		const float d21{ vec3::dot(e2, e1) };
+		const float denominator{ d00 * d11 - d01 * d01 };
+		const float l1{ denominator != 0.f ? (d11 * d20 - d01 * d21) / denominator : 0.f };
+		const float l2{ denominator != 0.f ? (d00 * d21 - d01 * d20) / denominator : 0.f };
+		const float l0{ 1.f - l1 - l2 };
+
+		result.intersecting = true;
+		result.distance = -face.distance;
+		result.normal = face.normal;
+		result.pointA = v0.a * l0 + v1.a * l1 + v2.a * l2;
+		result.pointB = v0.b * l0 + v1.b * l1 + v2.b * l2;
+		return true;
+	}
+
+	static convexResult query(const convexShape& a, const convexShape& b, gjkCache* cache, bool penetration) {
+		gjkSimplex s{};
+		vec3 v;
+		convexResult result{};
+		const bool intersecting{ runGjk(a, b, cache, false, s, v, result.iterations) };
+		if (!intersecting) {
+			witnessPoints(s, result.pointA, result.pointB);
+			result.intersecting = false;
+			result.distance = std::sqrt(lengthSquared(v));
+			result.normal = result.distance > 0.f ? v / -result.distance : fallbackNormal(a, b);
+			return result;
+		}
+
+		if (penetration && blowUp(a, b, s) && runEpa(a, b, s, result)) {
+			return result;
+		}
+
+		// Touching shapes, degenerate simplex or distance query: report contact without depth.
+		for (uint32_t i = 0; i < s.count; i++) {
+			s.lambda[i] = 1.f / (float)s.count;
+		}
+		witnessPoints(s, result.pointA, result.pointB);
+		result.intersecting = true;
+		result.distance = 0.f;
+		result.normal = fallbackNormal(a, b);
+		return result;
+	}
+
+	bool gjk::intersect(const convexShape& a, const convexShape& b, gjkCache* cache) {
+		gjkSimplex s{};
+		vec3 v;
+		uint32_t iterations;
+		return runGjk(a, b, cache, true, s, v, iterations);
+	}
+
+	convexResult gjk::distance(const convexShape& a, const convexShape& b, gjkCache* cache) {
+		return query(a, b, cache, false);
+	}
+
+	convexResult gjk::penetration(const convexShape& a, const convexShape& b, gjkCache* cache) {
+		return query(a, b, cache, true);
+	}
+
+	void gjk::penetrationMany(const convexShape* shapes, const convexPair* pairs, size_t count, convexResult* out, gjkCache* caches) {
+		MARMATH_PROBE(GjkPenetrationMany, count);
+		parallel::forEach(count, parallel::grainSize(g_pairElementCost), [shapes, pairs, out, caches](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				out[i] = penetration(shapes[pairs[i].a], shapes[pairs[i].b], caches ? caches + i : nullptr);
+			}
+		});
+	}
+
+
+}
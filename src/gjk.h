@@ -0,0 +1,139 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_GJK_H
+#define MAR_MATH_GJK_H
+
+
+#include "maths.h"
+#include "vec3.h"
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+	struct convexShape;
+
+
+	/**
+	 * \struct gjkCache gjk.h "gjk.h"
+	 * \brief Support directions of last simplex of shape pair. Keep one cache per pair between
+	 * frames, GJK then starts from simplex re-evaluated in these directions, which is usually
+	 * close to the final one, as shapes move only a little per frame. Zero-initialized cache is empty.
+	 */
+	struct gjkCache {
+		/// \brief support directions of simplex vertices
+		vec3 directions[4];
+		/// \brief count of used directions, 0 means no warm start
+		uint32_t count;
+	};
+
+
+	/**
+	 * \struct convexPair gjk.h "gjk.h"
+	 * \brief Indices of two shapes, that should be tested against each other.
+	 */
+	struct convexPair {
+		/// \brief index of first shape
+		uint32_t a;
+		/// \brief index of second shape
+		uint32_t b;
+	};
+
+
+	/**
+	 * \struct convexResult gjk.h "gjk.h"
+	 * \brief Result of query between shapes A and B.
+	 */
+	struct convexResult {
+		/// \brief distance between shapes, negative penetration depth if they intersect (0 if EPA didn't run)
+		float distance;
+		/// \brief unit direction from A to B, moving B by normal * -distance separates intersecting shapes
+		vec3 normal;
+		/// \brief closest (or deepest) point on A in world space
+		vec3 pointA;
+		/// \brief closest (or deepest) point on B in world space
+		vec3 pointB;
+		/// \brief true, if shapes intersect
+		bool intersecting;
+		/// \brief count of GJK iterations (without EPA), useful to check warm starting
+		uint32_t iterations;
+	};
+
+
+	/**
+	 * \struct gjk gjk.h "gjk.h"
+	 * \brief GJK distance / intersection and EPA penetration queries between convexShape's.
+	 * Everything is computed on stack, there are no allocations, so queries are safe to run
+	 * for many pairs on parallel pool.
+	 */
+	struct gjk {
+
+		/**
+		 * \brief Checks, if shapes intersect (touching shapes intersect). Stops as soon as
+		 * separating direction is found, so it is cheaper than distance().
+		 * \param a first shape
+		 * \param b second shape
+		 * \param cache optional cache for warm starting, updated by query
+		 * \return true, if shapes intersect
+		 */
+		static bool intersect(const convexShape& a, const convexShape& b, gjkCache* cache = nullptr);
+
+		/**
+		 * \brief Computes distance and closest points of separated shapes. If shapes intersect,
+		 * distance is 0 and only intersecting flag is meaningful.
+		 * \param a first shape
+		 * \param b second shape
+		 * \param cache optional cache for warm starting, updated by query
+		 * \return query result
+		 */
+		static convexResult distance(const convexShape& a, const convexShape& b, gjkCache* cache = nullptr);
+
+		/**
+		 * \brief Computes distance of separated shapes like distance() and penetration depth, normal
+		 * and deepest points of intersecting shapes with EPA.
+		 * \param a first shape
+		 * \param b second shape
+		 * \param cache optional cache for warm starting, updated by query
+		 * \return query result
+		 */
+		static convexResult penetration(const convexShape& a, const convexShape& b, gjkCache* cache = nullptr);
+
+		/**
+		 * \brief Runs penetration() for every pair on parallel pool.
+		 * \param shapes array of shapes
+		 * \param pairs array of count pairs of indices into shapes
+		 * \param count count of pairs
+		 * \param out array, to which count results will be written
+		 * \param caches optional array of count caches (one per pair), may be nullptr
+		 */
+		static void penetrationMany(const convexShape* shapes, const convexPair* pairs, size_t count, convexResult* out,
+			gjkCache* caches = nullptr);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_GJK_H
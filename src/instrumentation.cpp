@@ -0,0 +1,222 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "instrumentation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define MARMATH_HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+	#define MARMATH_HAS_RDTSC 1
+#endif
+
+
+namespace marengine::maths {
+
+
+	static constexpr size_t g_probeCount{ (size_t)probe::Count };
+
+	static const char* const g_probeNames[]{
+		"mat4::inverse",
+		"mat4::decompose",
+		"mat4::multiply",
+		"mat4::multiplyMany",
+		"mat4::multiplyPairwise",
+		"vec2::normalize",
+		"vec3::normalize",
+		"vec4::normalize",
+		"vec2::normalizeFastMany",
+		"vec3::normalizeFastMany",
+		"vec4::normalizeFastMany",
+		"world::modelViewMany",
+		"world::modelViewManySplit",
+		"mat3::normalMatrixMany",
+		"sprite::quadVerticesMany",
+		"spatialCode::morton30Many",
+		"radixSort::sort",
+		"spatialHash::build",
+		"spatialHash::queryRadiusMany",
+		"spatialHash::queryNearestMany",
+		"kdTree::build",
+		"kdTree::nearestMany",
+		"kdTree::radiusMany",
+		"gjk::penetrationMany",
+		"obb::intersectsMany",
+		"obb::intersectsRayMany",
+		"obb::intersectsFrustumMany",
+		"decomposition::eigenSymmetricMany",
+		"decomposition::svdMany",
+		"sweepAndPrune::update",
+		"sweepAndPrune::findPairs",
+		"rigidBody::integrate"
+	};
+	static_assert(sizeof(g_probeNames) / sizeof(*g_probeNames) == g_probeCount, "every probe needs its name");
+
+
+	/**
+	 * Counters of single thread. Only owning thread writes to them (relaxed load + store, no RMW),
+	 * report() reads them from any thread. Reset bumps global generation and every owner clears
+	 * its block lazily on next record, so that reset never races with writes.
+	 */
+	struct threadCounters {
+
+		struct counter {
+			std::atomic<uint64_t> calls{ 0 };
+			std::atomic<uint64_t> elements{ 0 };
+			std::atomic<uint64_t> maxBatch{ 0 };
+			std::atomic<uint64_t> ticks{ 0 };
+		};
+
+		counter counters[g_probeCount];
+		std::atomic<uint64_t> generation{ 0 };
+		std::atomic<bool> used{ true };
+		threadCounters* next{ nullptr };
+
+	};
+
+	static std::atomic<threadCounters*> g_blocks{ nullptr };
+	static std::atomic<uint64_t> g_generation{ 1 };
+
+	static threadCounters* acquireBlock() {
+		// reuse block of finished thread, its counters stay as they were
+		for (threadCounters* block = g_blocks.load(std::memory_order_acquire); block; block = block->next) {
+			bool expected{ false };
+			if (block->used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+				return block;
+			}
+		}
+
+		threadCounters* block{ new threadCounters };
+		threadCounters* head{ g_blocks.load(std::memory_order_relaxed) };
+		do {
+			block->next = head;
+		} while (!g_blocks.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+		return block;
+	}
+
+	struct threadBlockOwner {
+
+		threadCounters* block{ acquireBlock() };
+
+		~threadBlockOwner() {
+			block->used.store(false, std::memory_order_release);
+		}
+
+	};
+
+	static thread_local threadBlockOwner t_owner;
+
+
+	uint64_t instrumentation::ticks() {
+#ifdef MARMATH_HAS_RDTSC
+		return __rdtsc();
+#else
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	void instrumentation::record(probe function, uint64_t elements, uint64_t elapsed) {
+		threadCounters& block{ *t_owner.block };
+		const uint64_t generation{ g_generation.load(std::memory_order_relaxed) };
+		if (block.generation.load(std::memory_order_relaxed) != generation) {
+			for (threadCounters::counter& c : block.counters) {
+				c.calls.store(0, std::memory_order_relaxed);
+				c.elements.store(0, std::memory_order_relaxed);
+				c.maxBatch.store(0, std::memory_order_relaxed);
+				c.ticks.store(0, std::memory_order_relaxed);
+			}
+			block.generation.store(generation, std::memory_order_release);
+		}
+
+		threadCounters::counter& c{ block.counters[(size_t)function] };
+		c.calls.store(c.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		c.elements.store(c.elements.load(std::memory_order_relaxed) + elements, std::memory_order_relaxed);
+		c.ticks.store(c.ticks.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+		if (elements > c.maxBatch.load(std::memory_order_relaxed)) {
+			c.maxBatch.store(elements, std::memory_order_relaxed);
+		}
+	}
+
+	void instrumentation::reset() {
+		g_generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	size_t instrumentation::report(probeRecord* out) {
+		for (size_t i = 0; i < g_probeCount; i++) {
+			out[i] = { g_probeNames[i], 0, 0, 0, 0 };
+		}
+
+		const uint64_t generation{ g_generation.load(std::memory_order_relaxed) };
+		for (threadCounters* block = g_blocks.load(std::memory_order_acquire); block; block = block->next) {
+			if (block->generation.load(std::memory_order_acquire) != generation) {
+				continue;
+			}
+			for (size_t i = 0; i < g_probeCount; i++) {
+				const threadCounters::counter& c{ block->counters[i] };
+				out[i].calls += c.calls.load(std::memory_order_relaxed);
+				out[i].elements += c.elements.load(std::memory_order_relaxed);
+				out[i].ticks += c.ticks.load(std::memory_order_relaxed);
+				const uint64_t maxBatch{ c.maxBatch.load(std::memory_order_relaxed) };
+				if (maxBatch > out[i].maxBatch) {
+					out[i].maxBatch = maxBatch;
+				}
+			}
+		}
+
+		return g_probeCount;
+	}
+
+	void instrumentation::dump(std::FILE* file) {
+		probeRecord records[g_probeCount];
+		report(records);
+
+		int nameWidth{ (int)std::strlen("function") };
+		for (const char* name : g_probeNames) {
+			nameWidth = std::max(nameWidth, (int)std::strlen(name));
+		}
+
+		std::fprintf(file, "%-*s %14s %14s %12s %10s %16s %12s\n", nameWidth,
+			"function", "calls", "elements", "avg batch", "max batch", "ticks", "ticks/elem");
+		for (const probeRecord& r : records) {
+			if (r.calls == 0) {
+				continue;
+			}
+			std::fprintf(file, "%-*s %14llu %14llu %12.1f %10llu %16llu %12.1f\n", nameWidth, r.name,
+				(unsigned long long)r.calls, (unsigned long long)r.elements, (double)r.elements / (double)r.calls,
+				(unsigned long long)r.maxBatch, (unsigned long long)r.ticks,
+				r.elements != 0 ? (double)r.ticks / (double)r.elements : 0.0);
+		}
+	}
+
+	const char* instrumentation::name(probe function) {
+		return g_probeNames[(size_t)function];
+	}
+
+
+}
@@ -0,0 +1,198 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_INSTRUMENTATION_H
+#define MAR_MATH_INSTRUMENTATION_H
+
+
+#include "maths.h"
+#include <cstdint>
+#include <cstdio>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \brief Instrumented functions. Every probe collects count of calls, count of processed
+	 * elements, largest batch and elapsed ticks.
+	 */
+	enum class probe : uint32_t {
+		Mat4Inverse,
+		Mat4Decompose,
+		Mat4Multiply,
+		Mat4MultiplyMany,
+		Mat4MultiplyPairwise,
+		Vec2Normalize,
+		Vec3Normalize,
+		Vec4Normalize,
+		Vec2NormalizeFastMany,
+		Vec3NormalizeFastMany,
+		Vec4NormalizeFastMany,
+		WorldModelViewMany,
+		WorldModelViewManySplit,
+		Mat3NormalMatrixMany,
+		SpriteQuadVerticesMany,
+		SpatialCodeMorton30Many,
+		RadixSortSort,
+		SpatialHashBuild,
+		SpatialHashQueryRadiusMany,
+		SpatialHashQueryNearestMany,
+		KdTreeBuild,
+		KdTreeNearestMany,
+		KdTreeRadiusMany,
+		GjkPenetrationMany,
+		ObbIntersectsMany,
+		ObbIntersectsRayMany,
+		ObbIntersectsFrustumMany,
+		DecompositionEigenSymmetricMany,
+		DecompositionSvdMany,
+		SweepAndPruneUpdate,
+		SweepAndPruneFindPairs,
+		RigidBodyIntegrate,
+		Count
+	};
+
+
+	/**
+	 * \struct probeRecord instrumentation.h "instrumentation.h"
+	 * \brief Counters of single probe summed over all threads.
+	 */
+	struct probeRecord {
+		/// \brief name of instrumented function, ex: "mat4::inverse"
+		const char* name;
+		/// \brief count of calls
+		uint64_t calls;
+		/// \brief count of processed elements (1 for scalar calls, count for batch calls)
+		uint64_t elements;
+		/// \brief largest element count passed in single call
+		uint64_t maxBatch;
+		/// \brief elapsed ticks (CPU cycles on x86, nanoseconds elsewhere)
+		uint64_t ticks;
+	};
+
+
+	/**
+	 * \struct instrumentation instrumentation.h "instrumentation.h"
+	 * \brief Opt-in per-function counters. Define MARMATH_INSTRUMENTATION to 1 for whole build
+	 * to enable them, otherwise MARMATH_PROBE expands to nothing and costs nothing.
+	 *
+	 * Every thread writes only to its own block of counters, so recording needs no locks.
+	 * Blocks are never freed, counters of finished threads stay in report until reset().
+	 * Report compares scalar and batch call sites, ex: millions of mat4::inverse calls with
+	 * elements == calls are a candidate for batch API. Batch functions built on scalar ones
+	 * (ex: world::modelViewMany on mat4::multiply) count those calls too.
+	 */
+	struct instrumentation {
+
+		/// \brief True, if library is built with MARMATH_INSTRUMENTATION.
+		static constexpr bool enabled{
+#ifdef MARMATH_INSTRUMENTATION
+			MARMATH_INSTRUMENTATION != 0
+#else
+			false
+#endif
+		};
+
+		/**
+		 * \brief Returns current timestamp in ticks (rdtsc on x86, steady_clock nanoseconds elsewhere).
+		 * \return timestamp
+		 */
+		static uint64_t ticks();
+
+		/**
+		 * \brief Adds call to counters of calling thread. Use MARMATH_PROBE instead of calling it directly.
+		 * \param function instrumented function
+		 * \param elements count of processed elements
+		 * \param elapsed ticks spent in call
+		 */
+		static void record(probe function, uint64_t elements, uint64_t elapsed);
+
+		/// \brief Clears counters of all threads.
+		static void reset();
+
+		/**
+		 * \brief Sums counters of all threads.
+		 * \param out array of at least probe::Count records, which is filled in probe order
+		 * \return count of written records (probe::Count)
+		 */
+		static size_t report(probeRecord* out);
+
+		/**
+		 * \brief Writes report of called functions as table, sorted in probe order.
+		 * \param file file, to which report is written (ex: stdout)
+		 */
+		static void dump(std::FILE* file);
+
+		/**
+		 * \brief Returns name of instrumented function.
+		 * \param function probe
+		 * \return name, ex: "mat4::inverse"
+		 */
+		static const char* name(probe function);
+
+	};
+
+
+	/**
+	 * \struct probeScope instrumentation.h "instrumentation.h"
+	 * \brief Records call in destructor, measuring ticks spent in scope.
+	 */
+	struct probeScope {
+
+		/// \brief self-explanatory
+		probeScope(probe function, uint64_t elements) :
+			m_start(instrumentation::ticks()),
+			m_elements(elements),
+			m_function(function)
+		{}
+
+		/// \brief self-explanatory
+		~probeScope() {
+			instrumentation::record(m_function, m_elements, instrumentation::ticks() - m_start);
+		}
+
+		probeScope(const probeScope&) = delete;
+		probeScope& operator=(const probeScope&) = delete;
+
+	private:
+
+		uint64_t m_start;
+		uint64_t m_elements;
+		probe m_function;
+
+	};
+
+
+}
+
+
+#if defined(MARMATH_INSTRUMENTATION) && MARMATH_INSTRUMENTATION
+	#define MARMATH_PROBE(function, elements) \
+		const ::marengine::maths::probeScope marmathProbeScope{ ::marengine::maths::probe::function, (uint64_t)(elements) }
+#else
+	#define MARMATH_PROBE(function, elements) ((void)0)
+#endif
+
+
+#endif // !MAR_MATH_INSTRUMENTATION_H
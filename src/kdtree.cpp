@@ -0,0 +1,327 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "kdtree.h"
+#include "parallel.h"
+#include "kernels.h"
+#include "instrumentation.h"
+#include <algorithm>
+#include <cfloat>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	// Queries are heavier than element-wise batch methods, so they use smaller chunks.
+	static constexpr size_t g_queryElementCost{ 16 };
+
+	template<size_t N>
+	void kdTree<N>::build(const point* points, size_t count, size_t leafSize) {
+		MARMATH_PROBE(KdTreeBuild, count);
+		leafSize = leafSize < 1 ? 1 : (leafSize > maxLeafSize ? maxLeafSize : leafSize);
+
+		// Node at depth d holds ceil(count / 2^d) points at most.
+		m_depth = 0;
+		while (((count + ((size_t)1 << m_depth) - 1) >> m_depth) > leafSize) {
+			m_depth++;
+		}
+		const size_t internalCount{ ((size_t)1 << m_depth) - 1 };
+		m_splitValues.assign(internalCount, 0.f);
+		m_splitAxes.assign(internalCount, 0);
+
+		struct item {
+			point p;
+			uint32_t index;
+		};
+		std::vector<item> items(count);
+		for (size_t i = 0; i < count; i++) {
+			items[i] = { points[i], (uint32_t)i };
+		}
+
+		std::vector<size_t> nodeBegin(internalCount);
+		std::vector<size_t> nodeEnd(internalCount);
+		if (internalCount > 0) {
+			nodeBegin[0] = 0;
+			nodeEnd[0] = count;
+		}
+
+		// Nodes of one level own disjoint ranges, so every level is split in parallel.
+		for (size_t level = 0; level < m_depth; level++) {
+			const size_t first{ ((size_t)1 << level) - 1 };
+			const size_t levelCount{ (size_t)1 << level };
+			parallel::forEach(levelCount, 1, [this, first, internalCount, &items, &nodeBegin, &nodeEnd](size_t begin, size_t end) {
+				for (size_t node = first + begin; node < first + end; node++) {
+					const size_t rangeBegin{ nodeBegin[node] };
+					const size_t rangeEnd{ nodeEnd[node] };
+					const size_t middle{ rangeBegin + (rangeEnd - rangeBegin) / 2 };
+
+					float lower[N];
+					float upper[N];
+					for (size_t axis = 0; axis < N; axis++) {
+						lower[axis] = FLT_MAX;
+						upper[axis] = -FLT_MAX;
+					}
+					for (size_t i = rangeBegin; i < rangeEnd; i++) {
+						for (size_t axis = 0; axis < N; axis++) {
+							const float value{ (&items[i].p.x)[axis] };
+							lower[axis] = value < lower[axis] ? value : lower[axis];
+							upper[axis] = value > upper[axis] ? value : upper[axis];
+						}
+					}
+					uint8_t splitAxis{ 0 };
+					for (size_t axis = 1; axis < N; axis++) {
+						if (upper[axis] - lower[axis] > upper[splitAxis] - lower[splitAxis]) {
+							splitAxis = (uint8_t)axis;
+						}
+					}
+
+					std::nth_element(items.begin() + rangeBegin, items.begin() + middle, items.begin() + rangeEnd,
+						[splitAxis](const item& left, const item& right) {
+							const float l{ (&left.p.x)[splitAxis] };
+							const float r{ (&right.p.x)[splitAxis] };
+							return l < r || (l == r && left.index < right.index);
+						});
+					m_splitAxes[node] = splitAxis;
+					m_splitValues[node] = rangeBegin < rangeEnd ? (&items[middle].p.x)[splitAxis] : 0.f;
+
+					if (2 * node + 2 < internalCount) {
+						nodeBegin[2 * node + 1] = rangeBegin;
+						nodeEnd[2 * node + 1] = middle;
+						nodeBegin[2 * node + 2] = middle;
+						nodeEnd[2 * node + 2] = rangeEnd;
+					}
+				}
+			});
+		}
+
+		m_indices.resize(count);
+		for (size_t axis = 0; axis < N; axis++) {
+			m_lanes[axis].resize(count);
+		}
+		parallel::forEach(count, [this, &items](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				m_indices[i] = items[i].index;
+				for (size_t axis = 0; axis < N; axis++) {
+					m_lanes[axis][i] = (&items[i].p.x)[axis];
+				}
+			}
+		});
+	}
+
+	template<size_t N>
+	void kdTree<N>::leafDistances(const float* query, size_t begin, size_t end, float* out) const {
+		size_t i{ begin };
+#if MARMATH_SIMD_SSE
+		for (; i + 4 <= end; i += 4) {
+			__m128 sum{ _mm_setzero_ps() };
+			for (size_t axis = 0; axis < N; axis++) {
+				const __m128 d{ _mm_sub_ps(_mm_loadu_ps(m_lanes[axis].data() + i), _mm_set1_ps(query[axis])) };
+				sum = _mm_add_ps(sum, _mm_mul_ps(d, d));
+			}
+			_mm_storeu_ps(out + (i - begin), sum);
+		}
+#endif
+		for (; i < end; i++) {
+			float sum{ 0.f };
+			for (size_t axis = 0; axis < N; axis++) {
+				const float d{ m_lanes[axis][i] - query[axis] };
+				sum += d * d;
+			}
+			out[i - begin] = sum;
+		}
+	}
+
+	template<size_t N>
+	size_t kdTree<N>::search(const float* query, size_t k, float epsilon, std::vector<candidate>& heap, uint32_t* out) const {
+		heap.clear();
+		if (k == 0 || m_indices.empty()) {
+			return 0;
+		}
+
+		// Max-heap of the best k candidates, worse is greater distance or greater index.
+		const auto worse = [](const candidate& left, const candidate& right) {
+			return left.distanceSquared < right.distanceSquared ||
+				(left.distanceSquared == right.distanceSquared && left.index < right.index);
+		};
+		const float pruneScale{ (1.f + epsilon) * (1.f + epsilon) };
+
+		struct frame {
+			size_t node;
+			size_t begin;
+			size_t end;
+			float bound;
+		};
+		frame stack[64];
+		size_t stackSize{ 0 };
+		stack[stackSize++] = { 0, 0, m_indices.size(), 0.f };
+		float distances[maxLeafSize];
+
+		while (stackSize > 0) {
+			const frame f{ stack[--stackSize] };
+			if (heap.size() == k && f.bound * pruneScale > heap.front().distanceSquared) {
+				continue;
+			}
+
+			if (f.node >= m_splitAxes.size()) {
+				leafDistances(query, f.begin, f.end, distances);
+				for (size_t i = f.begin; i < f.end; i++) {
+					const candidate c{ distances[i - f.begin], m_indices[i] };
+					if (heap.size() < k) {
+						heap.push_back(c);
+						std::push_heap(heap.begin(), heap.end(), worse);
+					}
+					else if (worse(c, heap.front())) {
+						std::pop_heap(heap.begin(), heap.end(), worse);
+						heap.back() = c;
+						std::push_heap(heap.begin(), heap.end(), worse);
+					}
+				}
+				continue;
+			}
+
+			// Far child is pushed first, so that near child is visited first and tightens the bound.
+			const size_t middle{ f.begin + (f.end - f.begin) / 2 };
+			const float difference{ query[m_splitAxes[f.node]] - m_splitValues[f.node] };
+			const float farBound{ difference * difference > f.bound ? difference * difference : f.bound };
+			const frame left{ 2 * f.node + 1, f.begin, middle, difference < 0.f ? f.bound : farBound };
+			const frame right{ 2 * f.node + 2, middle, f.end, difference < 0.f ? farBound : f.bound };
+			stack[stackSize++] = difference < 0.f ? right : left;
+			stack[stackSize++] = difference < 0.f ? left : right;
+		}
+
+		std::sort_heap(heap.begin(), heap.end(), worse);
+		for (size_t i = 0; i < heap.size(); i++) {
+			out[i] = heap[i].index;
+		}
+		return heap.size();
+	}
+
+	template<size_t N>
+	template<typename TFunction>
+	void kdTree<N>::forEachInRadius(const float* query, float radius, TFunction function) const {
+		if (m_indices.empty()) {
+			return;
+		}
+
+		const float radiusSquared{ radius * radius };
+		struct frame {
+			size_t node;
+			size_t begin;
+			size_t end;
+		};
+		frame stack[64];
+		size_t stackSize{ 0 };
+		stack[stackSize++] = { 0, 0, m_indices.size() };
+		float distances[maxLeafSize];
+
+		while (stackSize > 0) {
+			const frame f{ stack[--stackSize] };
+			if (f.node >= m_splitAxes.size()) {
+				leafDistances(query, f.begin, f.end, distances);
+				for (size_t i = f.begin; i < f.end; i++) {
+					if (distances[i - f.begin] <= radiusSquared) {
+						function(m_indices[i]);
+					}
+				}
+				continue;
+			}
+
+			const size_t middle{ f.begin + (f.end - f.begin) / 2 };
+			const float difference{ query[m_splitAxes[f.node]] - m_splitValues[f.node] };
+			const bool visitLeft{ difference <= 0.f || difference * difference <= radiusSquared };
+			const bool visitRight{ difference >= 0.f || difference * difference <= radiusSquared };
+			if (visitRight) {
+				stack[stackSize++] = { 2 * f.node + 2, middle, f.end };
+			}
+			if (visitLeft) {
+				stack[stackSize++] = { 2 * f.node + 1, f.begin, middle };
+			}
+		}
+	}
+
+	template<size_t N>
+	size_t kdTree<N>::nearest(point query, size_t k, uint32_t* out) const {
+		std::vector<candidate> heap;
+		return search(&query.x, k, 0.f, heap, out);
+	}
+
+	template<size_t N>
+	size_t kdTree<N>::nearestApproximate(point query, size_t k, float epsilon, uint32_t* out) const {
+		std::vector<candidate> heap;
+		return search(&query.x, k, epsilon, heap, out);
+	}
+
+	template<size_t N>
+	size_t kdTree<N>::radius(point query, float radius, uint32_t* out, size_t capacity) const {
+		size_t found{ 0 };
+		forEachInRadius(&query.x, radius, [&found, out, capacity](uint32_t index) {
+			if (found < capacity) {
+				out[found] = index;
+			}
+			found++;
+		});
+		return found;
+	}
+
+	template<size_t N>
+	void kdTree<N>::nearestMany(const point* queries, size_t count, size_t k, uint32_t* out, float epsilon) const {
+		MARMATH_PROBE(KdTreeNearestMany, count);
+		parallel::forEach(count, parallel::grainSize(g_queryElementCost), [this, queries, k, out, epsilon](size_t begin, size_t end) {
+			std::vector<candidate> heap;
+			heap.reserve(k);
+			for (size_t i = begin; i < end; i++) {
+				const size_t found{ search(&queries[i].x, k, epsilon, heap, out + i * k) };
+				for (size_t j = found; j < k; j++) {
+					out[i * k + j] = invalid;
+				}
+			}
+		});
+	}
+
+	template<size_t N>
+	void kdTree<N>::radiusMany(const point* queries, size_t count, float radius, std::vector<uint32_t>& offsets,
+		std::vector<uint32_t>& neighbors) const
+	{
+		MARMATH_PROBE(KdTreeRadiusMany, count);
+		kernels::gatherMany(count, parallel::grainSize(g_queryElementCost), offsets, neighbors, [this, queries, radius](size_t i, std::vector<uint32_t>& found) {
+			forEachInRadius(&queries[i].x, radius, [&found](uint32_t index) {
+				found.push_back(index);
+			});
+		});
+	}
+
+	template<size_t N>
+	size_t kdTree<N>::size() const {
+		return m_indices.size();
+	}
+
+
+	template struct kdTree<2>;
+	template struct kdTree<3>;
+
+
+}
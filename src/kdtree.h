@@ -0,0 +1,163 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_KDTREE_H
+#define MAR_MATH_KDTREE_H
+
+
+#include "maths.h"
+#include "vec2.h"
+#include "vec3.h"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct kdTree kdtree.h "kdtree.h"
+	 * \brief k-d tree over static set of N-dimensional points (use kdTree2 for vec2, kdTree3 for vec3).
+	 * Tree is implicit: every internal node splits its range of points at the middle, so ranges
+	 * and children (2i + 1, 2i + 2) follow from node index alone and only split axis and value
+	 * are stored per node. All leaves are at the same depth and hold at most leafSize points,
+	 * which are stored as SoA lanes, so that leaves are scanned 4 points at once with SIMD.
+	 *
+	 * Levels are built on parallel pool, queries return indices of points as given to build().
+	 * Equal distances are ordered by index, so results are deterministic.
+	 */
+	template<size_t N>
+	struct kdTree {
+
+		static_assert(N == 2 || N == 3, "kdTree is implemented for 2 and 3 dimensions");
+
+		/// \brief type of points, vec2 or vec3
+		using point = std::conditional_t<N == 2, vec2, vec3>;
+
+		/// \brief Returned by nearestMany in place of missing neighbours.
+		static constexpr uint32_t invalid{ 0xFFFFFFFF };
+		/// \brief Largest allowed count of points in leaf.
+		static constexpr size_t maxLeafSize{ 64 };
+
+
+		/**
+		 * \brief Builds tree from given points, which are copied.
+		 * \param points array of points
+		 * \param count count of points, must be less than 2^32 - 1
+		 * \param leafSize maximal count of points in leaf, clamped to <1;maxLeafSize>
+		 */
+		void build(const point* points, size_t count, size_t leafSize = 16);
+
+		/**
+		 * \brief Finds exactly k nearest points.
+		 * \param query query point
+		 * \param k count of wanted points
+		 * \param out array, to which at most k indices will be written, sorted from the nearest
+		 * \return count of found points (less than k only if tree has less than k points)
+		 */
+		size_t nearest(point query, size_t k, uint32_t* out) const;
+
+		/**
+		 * \brief Finds k approximately nearest points. Subtree is skipped, if it can't contain point
+		 * closer than (distance to current k-th point) / (1 + epsilon), so every returned distance
+		 * is at most (1 + epsilon) times the true one. Epsilon equal to 0 gives exact search.
+		 * \param query query point
+		 * \param k count of wanted points
+		 * \param epsilon allowed relative error
+		 * \param out array, to which at most k indices will be written, sorted from the nearest
+		 * \return count of found points
+		 */
+		size_t nearestApproximate(point query, size_t k, float epsilon, uint32_t* out) const;
+
+		/**
+		 * \brief Finds every point within radius (boundary included) of query.
+		 * \param query query point
+		 * \param radius radius of query
+		 * \param out array, to which at most capacity indices will be written
+		 * \param capacity size of out array
+		 * \return count of found points, may be greater than capacity
+		 */
+		size_t radius(point query, float radius, uint32_t* out, size_t capacity) const;
+
+		/**
+		 * \brief Runs (approximate) k nearest query for every query point on parallel pool.
+		 * \param queries array of query points
+		 * \param count count of queries
+		 * \param k count of wanted points
+		 * \param out array of count * k indices, missing neighbours are set to kdTree::invalid
+		 * \param epsilon allowed relative error, 0 for exact search
+		 */
+		void nearestMany(const point* queries, size_t count, size_t k, uint32_t* out, float epsilon = 0.f) const;
+
+		/**
+		 * \brief Runs radius query for every query point on parallel pool. Result is compressed,
+		 * neighbours of queries[i] are neighbors[offsets[i]] ... neighbors[offsets[i + 1] - 1].
+		 * \param queries array of query points
+		 * \param count count of queries
+		 * \param radius radius of every query
+		 * \param offsets vector, which is resized to count + 1 offsets
+		 * \param neighbors vector, which is resized to count of all found points
+		 */
+		void radiusMany(const point* queries, size_t count, float radius, std::vector<uint32_t>& offsets,
+			std::vector<uint32_t>& neighbors) const;
+
+		/**
+		 * \brief Returns count of points given to last build().
+		 * \return count of points
+		 */
+		size_t size() const;
+
+	private:
+
+		struct candidate {
+			float distanceSquared;
+			uint32_t index;
+		};
+
+		size_t search(const float* query, size_t k, float epsilon, std::vector<candidate>& heap, uint32_t* out) const;
+
+		template<typename TFunction>
+		void forEachInRadius(const float* query, float radius, TFunction function) const;
+
+		void leafDistances(const float* query, size_t begin, size_t end, float* out) const;
+
+		std::vector<float> m_lanes[N];
+		std::vector<uint32_t> m_indices;
+		std::vector<float> m_splitValues;
+		std::vector<uint8_t> m_splitAxes;
+		size_t m_depth{ 0 };
+
+	};
+
+
+	/// \brief self-explanatory
+	using kdTree2 = kdTree<2>;
+	/// \brief self-explanatory
+	using kdTree3 = kdTree<3>;
+
+
+}
+
+
+#endif // !MAR_MATH_KDTREE_H
@@ -0,0 +1,156 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_KERNELS_H
+#define MAR_MATH_KERNELS_H
+
+
+#include "maths.h"
+#include "basic.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct kernels kernels.h "kernels.h"
+	 * \brief Internal building blocks shared by batch methods of several types. It is included only
+	 * from translation units of library and is not part of MARMaths.h.
+	 */
+	struct kernels {
+
+#if MARMATH_SIMD_SSE
+		/**
+		 * \brief Dot product of x, y, z lanes of single vectors, w lane is ignored.
+		 * \param a first vector
+		 * \param b second vector
+		 * \return dot product in lowest lane, other lanes are unspecified
+		 */
+		static __m128 dot3SSE(__m128 a, __m128 b) {
+			const __m128 p{ _mm_mul_ps(a, b) };
+			const __m128 sum{ _mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))) };
+			return _mm_add_ss(sum, _mm_movehl_ps(p, p));
+		}
+
+		/**
+		 * \brief Dot products of four vectors stored as x, y, z lanes with single vector (a, b, c).
+		 * \param x x components of four vectors
+		 * \param y y components of four vectors
+		 * \param z z components of four vectors
+		 * \param a x component of single vector
+		 * \param b y component of single vector
+		 * \param c z component of single vector
+		 * \return four dot products
+		 */
+		static __m128 dot3LanesSSE(__m128 x, __m128 y, __m128 z, float a, float b, float c) {
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a), x), _mm_mul_ps(_mm_set1_ps(b), y)), _mm_mul_ps(_mm_set1_ps(c), z));
+		}
+#endif
+
+		/**
+		 * \brief Normalizes in[begin;end) with basic::rsqrtMany, body of vec2 / vec3 / vec4 normalizeFastMany.
+		 * Squared lengths are gathered to blocks of 64 floats, so reciprocal square roots are computed
+		 * 4 at once without heap allocation. In and out may be the same array.
+		 * \param in array of vectors with N consecutive float components starting at x
+		 * \param out array, to which normalized vectors will be written
+		 * \param begin first index (inclusive)
+		 * \param end last index (exclusive)
+		 */
+		template<size_t N, typename T>
+		static void normalizeFastRange(const T* in, T* out, size_t begin, size_t end) {
+			constexpr size_t blockSize{ 64 };
+			float inverse[blockSize];
+			for (size_t i = begin; i < end; i += blockSize) {
+				const size_t block{ end - i < blockSize ? end - i : blockSize };
+				for (size_t j = 0; j < block; j++) {
+					const float* v{ &in[i + j].x };
+					float lengthSquared{ v[0] * v[0] };
+					for (size_t k = 1; k < N; k++) {
+						lengthSquared += v[k] * v[k];
+					}
+					inverse[j] = lengthSquared;
+				}
+				basic::rsqrtMany(inverse, inverse, block);
+				for (size_t j = 0; j < block; j++) {
+					const T v{ in[i + j] };
+					float* o{ &out[i + j].x };
+					for (size_t k = 0; k < N; k++) {
+						o[k] = (&v.x)[k] * inverse[j];
+					}
+				}
+			}
+		}
+
+		/**
+		 * \brief Runs query for every index of [0;count) with parallel::forEach and packs variable count
+		 * of results per index, so that results of index i are results[offsets[i]; offsets[i + 1]).
+		 * Chunk boundaries are multiples of grain size, so every chunk appends to its own vector and
+		 * vectors are concatenated in chunk order, output does not depend on thread count.
+		 * \param count count of queries
+		 * \param grainSize count of queries in single chunk
+		 * \param offsets resized to count + 1 offsets
+		 * \param results resized to total count of results
+		 * \param query callable query(size_t index, std::vector<T>& found), which appends results of index
+		 */
+		template<typename T, typename TQuery>
+		static void gatherMany(size_t count, size_t grainSize, std::vector<uint32_t>& offsets, std::vector<T>& results, const TQuery& query) {
+			grainSize = grainSize != 0 ? grainSize : 1;
+			offsets.resize(count + 1);
+			offsets[0] = 0;
+
+			std::vector<std::vector<T>> chunkResults((count + grainSize - 1) / grainSize);
+			parallel::forEach(count, grainSize, [grainSize, &offsets, &chunkResults, &query](size_t begin, size_t end) {
+				std::vector<T>& found{ chunkResults[begin / grainSize] };
+				for (size_t i = begin; i < end; i++) {
+					const size_t before{ found.size() };
+					query(i, found);
+					offsets[i + 1] = (uint32_t)(found.size() - before);
+				}
+			});
+
+			for (size_t i = 0; i < count; i++) {
+				offsets[i + 1] += offsets[i];
+			}
+			results.resize(offsets[count]);
+			parallel::forEach(chunkResults.size(), 1, [grainSize, &offsets, &results, &chunkResults](size_t begin, size_t end) {
+				for (size_t chunk = begin; chunk < end; chunk++) {
+					std::copy(chunkResults[chunk].begin(), chunkResults[chunk].end(), results.begin() + offsets[chunk * grainSize]);
+				}
+			});
+		}
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_KERNELS_H
@@ -0,0 +1,330 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "mat3.h"
+#include "mat4.h"
+#include "vec3.h"
+#include "quat.h"
+#include "parallel.h"
+#include "kernels.h"
+#include "diagnostics.h"
+#include "instrumentation.h"
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	mat3::mat3() {
+		for (int i = 0; i < 3 * 3; i++) {
+			elements[i] = 0.0f;
+		}
+	}
+
+	mat3::mat3(float diagonal) {
+		for (int i = 0; i < 3 * 3; i++) {
+			elements[i] = 0.0f;
+		}
+		for (int i = 0; i < 3; i++) {
+			elements[i + i * 3] = diagonal;
+		}
+	}
+
+	mat3::mat3(const mat4& m) {
+		for (size_t col = 0; col < 3; col++) {
+			for (size_t row = 0; row < 3; row++) {
+				elements[row + col * 3] = m.elements[row + col * 4];
+			}
+		}
+	}
+
+	vec3 mat3::getColumn3(size_t index) const {
+		return {
+			elements[0 + index * 3],
+			elements[1 + index * 3],
+			elements[2 + index * 3]
+		};
+	}
+
+	vec3 mat3::getRow3(size_t index) const {
+		return {
+			elements[index + 0 * 3],
+			elements[index + 1 * 3],
+			elements[index + 2 * 3]
+		};
+	}
+
+	mat3 mat3::identity() {
+		return mat3(1.0f);
+	}
+
+	mat3 mat3::fromQuat(quat q) {
+		const float qxx(q.x * q.x);
+		const float qyy(q.y * q.y);
+		const float qzz(q.z * q.z);
+		const float qxz(q.x * q.z);
+		const float qxy(q.x * q.y);
+		const float qyz(q.y * q.z);
+		const float qwx(q.w * q.x);
+		const float qwy(q.w * q.y);
+		const float qwz(q.w * q.z);
+		mat3 rtn;
+
+		rtn[0 + 0 * 3] = 1.f - 2.f * (qyy + qzz);
+		rtn[1 + 0 * 3] = 2.f * (qxy + qwz);
+		rtn[2 + 0 * 3] = 2.f * (qxz - qwy);
+
+		rtn[0 + 1 * 3] = 2.f * (qxy - qwz);
+		rtn[1 + 1 * 3] = 1.f - 2.f * (qxx + qzz);
+		rtn[2 + 1 * 3] = 2.f * (qyz + qwx);
+
+		rtn[0 + 2 * 3] = 2.f * (qxz + qwy);
+		rtn[1 + 2 * 3] = 2.f * (qyz - qwx);
+		rtn[2 + 2 * 3] = 1.f - 2.f * (qxx + qyy);
+		return rtn;
+	}
+
+	mat4 mat3::toMat4() const {
+		mat4 rtn(1.f);
+		for (size_t col = 0; col < 3; col++) {
+			for (size_t row = 0; row < 3; row++) {
+				rtn.elements[row + col * 4] = elements[row + col * 3];
+			}
+		}
+		return rtn;
+	}
+
+	mat3 mat3::multiply(const mat3& other) const {
+		mat3 rtn;
+		for (size_t col = 0; col < 3; col++) {
+			for (size_t row = 0; row < 3; row++) {
+				rtn.elements[row + col * 3] =
+					elements[row + 0 * 3] * other.elements[0 + col * 3] +
+					elements[row + 1 * 3] * other.elements[1 + col * 3] +
+					elements[row + 2 * 3] * other.elements[2 + col * 3];
+			}
+		}
+		return rtn;
+	}
+
+	vec3 mat3::multiply(const vec3& other) const {
+		return {
+			elements[0 + 0 * 3] * other.x + elements[0 + 1 * 3] * other.y + elements[0 + 2 * 3] * other.z,
+			elements[1 + 0 * 3] * other.x + elements[1 + 1 * 3] * other.y + elements[1 + 2 * 3] * other.z,
+			elements[2 + 0 * 3] * other.x + elements[2 + 1 * 3] * other.y + elements[2 + 2 * 3] * other.z
+		};
+	}
+
+	mat3 mat3::multiply(float other) const {
+		mat3 rtn{ *this };
+		for (size_t i = 0; i < 9; i++) {
+			rtn.elements[i] *= other;
+		}
+		return rtn;
+	}
+
+	float mat3::determinant(const mat3& m) {
+		return vec3::dot(m.getColumn3(0), vec3::cross(m.getColumn3(1), m.getColumn3(2)));
+	}
+
+	// Columns of inverse-transpose of 3x3 are c1 x c2, c2 x c0, c0 x c1 divided by determinant,
+	// as dot(ci, cj x ck) is equal to det only for i == j. Columns are read with given stride,
+	// so the same kernel takes upper 3x3 of mat4 (stride 4) and mat3 (stride 3). Returns determinant.
+	static float inverseTransposeKernel(const float* m, size_t stride, float* out) {
+		const vec3 c0{ m[0 + 0 * stride], m[1 + 0 * stride], m[2 + 0 * stride] };
+		const vec3 c1{ m[0 + 1 * stride], m[1 + 1 * stride], m[2 + 1 * stride] };
+		const vec3 c2{ m[0 + 2 * stride], m[1 + 2 * stride], m[2 + 2 * stride] };
+		const vec3 r[3]{ vec3::cross(c1, c2), vec3::cross(c2, c0), vec3::cross(c0, c1) };
+		const float det{ vec3::dot(c0, r[0]) };
+		const float invDet{ 1.f / det };
+		for (size_t col = 0; col < 3; col++) {
+			out[0 + col * 3] = r[col].x * invDet;
+			out[1 + col * 3] = r[col].y * invDet;
+			out[2 + col * 3] = r[col].z * invDet;
+		}
+		return det;
+	}
+
+#if MARMATH_SIMD_SSE
+	static __m128 crossSSE(__m128 a, __m128 b) {
+		const __m128 ayzx{ _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m128 byzx{ _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1)) };
+		const __m128 c{ _mm_sub_ps(_mm_mul_ps(a, byzx), _mm_mul_ps(ayzx, b)) };
+		return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	// mat3 is 9 floats, so last column is stored as pair + single to not write past it.
+	// Second store overwrites w lane of first one.
+	static void storeMat3SSE(float* out, __m128 c0, __m128 c1, __m128 c2) {
+		_mm_storeu_ps(out + 0, c0);
+		_mm_storeu_ps(out + 3, c1);
+		_mm_storel_pi((__m64*)(out + 6), c2);
+		_mm_store_ss(out + 8, _mm_movehl_ps(c2, c2));
+	}
+#endif
+
+	static void normalMatrixKernel(const float* model, float* out) {
+#if MARMATH_SIMD_SSE
+		const __m128 c0{ _mm_loadu_ps(model + 0) };
+		const __m128 c1{ _mm_loadu_ps(model + 4) };
+		const __m128 c2{ _mm_loadu_ps(model + 8) };
+		const __m128 r0{ crossSSE(c1, c2) };
+		const __m128 r1{ crossSSE(c2, c0) };
+		const __m128 r2{ crossSSE(c0, c1) };
+		const __m128 det{ kernels::dot3SSE(c0, r0) };
+		const __m128 invDet{ _mm_div_ps(_mm_set1_ps(1.f), _mm_shuffle_ps(det, det, _MM_SHUFFLE(0, 0, 0, 0))) };
+		storeMat3SSE(out, _mm_mul_ps(r0, invDet), _mm_mul_ps(r1, invDet), _mm_mul_ps(r2, invDet));
+#else
+		inverseTransposeKernel(model, 4, out);
+#endif
+	}
+
+	// For rotation R with uniform scale s, (sR)^-T = R / s = (sR) / s^2.
+	static void normalMatrixUniformScaleKernel(const float* model, float* out) {
+#if MARMATH_SIMD_SSE
+		const __m128 c0{ _mm_loadu_ps(model + 0) };
+		const __m128 c1{ _mm_loadu_ps(model + 4) };
+		const __m128 c2{ _mm_loadu_ps(model + 8) };
+		const __m128 lengthSquared{ kernels::dot3SSE(c0, c0) };
+		const __m128 invScale{ _mm_div_ps(_mm_set1_ps(1.f), _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(0, 0, 0, 0))) };
+		storeMat3SSE(out, _mm_mul_ps(c0, invScale), _mm_mul_ps(c1, invScale), _mm_mul_ps(c2, invScale));
+#else
+		const float invScale{ 1.f / (model[0] * model[0] + model[1] * model[1] + model[2] * model[2]) };
+		for (size_t col = 0; col < 3; col++) {
+			for (size_t row = 0; row < 3; row++) {
+				out[row + col * 3] = model[row + col * 4] * invScale;
+			}
+		}
+#endif
+	}
+
+	mat3 mat3::inverse(const mat3& m) {
+		mat3 inv;
+		const float det{ inverseTransposeKernel(m.elements, 3, inv.elements) };
+		if (det == 0.f) {
+			MARMATH_DIAGNOSE(SingularInverse, "mat3::inverse - determinant is equal to 0!");
+		}
+
+		inv.transpose();
+		MARMATH_CHECK_FINITE(inv.elements, 9, "mat3::inverse");
+		return inv;
+	}
+
+	mat3 mat3::transpose(const mat3& m) {
+		mat3 rtn;
+		for (size_t col = 0; col < 3; col++) {
+			for (size_t row = 0; row < 3; row++) {
+				rtn.elements[col + row * 3] = m.elements[row + col * 3];
+			}
+		}
+		return rtn;
+	}
+
+	void mat3::transpose() {
+		*this = transpose(*this);
+	}
+
+	mat3 mat3::normalMatrix(const mat4& model) {
+		mat3 rtn;
+		const float det{ inverseTransposeKernel(model.elements, 4, rtn.elements) };
+		if (det == 0.f) {
+			MARMATH_DIAGNOSE(SingularInverse, "mat3::normalMatrix - determinant is equal to 0!");
+		}
+
+		MARMATH_CHECK_FINITE(rtn.elements, 9, "mat3::normalMatrix");
+		return rtn;
+	}
+
+	void mat3::normalMatrixMany(const mat4* models, mat3* out, size_t count, bool uniformScale) {
+		MARMATH_PROBE(Mat3NormalMatrixMany, count);
+		parallel::forEach(count, [models, out, uniformScale](size_t begin, size_t end) {
+			MARMATH_CHECK_DENORMALS(models[begin].elements, 16 * (end - begin), "mat3::normalMatrixMany");
+			if (uniformScale) {
+				for (size_t i = begin; i < end; i++) {
+					normalMatrixUniformScaleKernel(models[i].elements, out[i].elements);
+				}
+			}
+			else {
+				for (size_t i = begin; i < end; i++) {
+					normalMatrixKernel(models[i].elements, out[i].elements);
+				}
+			}
+			MARMATH_CHECK_FINITE(out[begin].elements, 9 * (end - begin), "mat3::normalMatrixMany");
+		});
+	}
+
+	bool mat3::compare(const mat3& left, const mat3& right) {
+		for (size_t i = 0; i < 9; i++) {
+			if (left[i] != right[i]) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const float* mat3::value_ptr(const mat3& matrix3x3) {
+		return matrix3x3.elements;
+	}
+
+	mat3 operator*(const mat3& left, const mat3& right) {
+		return left.multiply(right);
+	}
+
+	vec3 operator*(const mat3& left, const vec3& right) {
+		return left.multiply(right);
+	}
+
+	mat3 operator*(const mat3& left, float right) {
+		return left.multiply(right);
+	}
+
+	const float& mat3::operator[](unsigned int index) const {
+		if (index >= 3 * 3) {
+			MARMATH_DIAGNOSE(OutOfBounds, "mat3::operator[] - index out of bound!");
+		}
+
+		return elements[index];
+	}
+
+	float& mat3::operator[](unsigned int index) {
+		if (index >= 3 * 3) {
+			MARMATH_DIAGNOSE(OutOfBounds, "mat3::operator[] - index out of bound!");
+		}
+
+		return elements[index];
+	}
+
+	bool mat3::operator==(const mat3& right) const {
+		return compare(*this, right);
+	}
+
+	bool mat3::operator!=(const mat3& right) const {
+		return !compare(*this, right);
+	}
+
+
+}
@@ -0,0 +1,210 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_MAT3_H
+#define MAR_MATH_MAT3_H
+
+
+#include "maths.h"
+
+
+namespace marengine::maths {
+
+	struct vec3;
+	struct mat4;
+	struct quat;
+
+
+	/**
+	 * \struct mat3 mat3.h "mat3.h"
+	 * \brief mat3 is 3x3 matrix stored in column-major order, the same way as mat4 is (element
+	 * at given row and column is elements[row + column * 3]). Main use case is normal matrix
+	 * (inverse-transpose of upper 3x3 of model matrix), which is 36 bytes per object instead of 64.
+	 */
+	struct mat3 {
+
+		/// \brief elements of mat3, column-major
+		float elements[3 * 3];
+
+
+		/// \brief Default constructor for 3x3 matrix. Initializes all elements to 0.f.
+		mat3();
+
+		/**
+		 * \brief Constructor, that allows user to create identity mat3 with specified diagonal.
+		 * \param diagonal value that will be placed on the diagonal
+		 */
+		mat3(float diagonal);
+
+		/**
+		 * \brief Constructor, that copies upper 3x3 (rotation and scale part) of given mat4.
+		 * \param m mat4, from which upper 3x3 will be taken
+		 */
+		explicit mat3(const mat4& m);
+
+		/**
+		 * \brief Returns column at given index.
+		 * \param index index of column <0;2>
+		 * \return column as vec3
+		 */
+		vec3 getColumn3(size_t index) const;
+
+		/**
+		 * \brief Returns row at given index.
+		 * \param index index of row <0;2>
+		 * \return row as vec3
+		 */
+		vec3 getRow3(size_t index) const;
+
+		/**
+		 * \brief Static method to create identity matrix. It simply calls mat3(1.f) constructor and returns it.
+		 * \return identity matrix
+		 */
+		static mat3 identity();
+
+		/**
+		 * \brief Creates rotation matrix from given quaternion, same as upper 3x3 of quat::rotationFromQuat.
+		 * \param q unit quaternion
+		 * \return rotation matrix
+		 */
+		static mat3 fromQuat(quat q);
+
+		/**
+		 * \brief Widens mat3 to mat4, last row and column are set as in identity.
+		 * \return created mat4
+		 */
+		mat4 toMat4() const;
+
+		/**
+		 * \brief Multiplication method of mat3 and mat3.
+		 * \param other mat3 on the right side
+		 * \return *this * other
+		 */
+		mat3 multiply(const mat3& other) const;
+
+		/**
+		 * \brief Multiplication method of mat3 and vec3.
+		 * \param other vec3 on the right side
+		 * \return *this * other
+		 */
+		vec3 multiply(const vec3& other) const;
+
+		/**
+		 * \brief Multiplication method of mat3 and float, every element is multiplied.
+		 * \param other float to multiply with *this
+		 * \return result of mat3 and float multiplication (which is mat3)
+		 */
+		mat3 multiply(float other) const;
+
+		/**
+		 * \brief Computes determinant of given matrix.
+		 * \param m mat3, which determinant will be calculated
+		 * \return calculated determinant
+		 */
+		static float determinant(const mat3& m);
+
+		/**
+		 * \brief Computes inverse of given matrix from its cofactors.
+		 * \param m mat3, which inverse will be calculated
+		 * \return inverted mat3
+		 */
+		static mat3 inverse(const mat3& m);
+
+		/**
+		 * \brief Returns transposed copy of given matrix.
+		 * \param m mat3, which will be transposed
+		 * \return transposed mat3
+		 */
+		static mat3 transpose(const mat3& m);
+
+		/// \brief Transposes *this in place.
+		void transpose();
+
+		/**
+		 * \brief Computes normal matrix of given model matrix, which is inverse-transpose of its
+		 * upper 3x3. Cofactors are computed directly, without going through mat4::inverse.
+		 * \param model model matrix
+		 * \return normal matrix
+		 */
+		static mat3 normalMatrix(const mat4& model);
+
+		/**
+		 * \brief Computes normal matrices of given model matrices. Columns of inverse-transpose are
+		 * cross products of model columns divided by determinant, which is computed with SIMD.
+		 * If uniformScale is true, caller promises, that every model is rotation with uniform scale
+		 * (and translation), so normal matrix is just upper 3x3 divided by squared scale.
+		 * \param models array of count model matrices
+		 * \param out array, to which count normal matrices will be written
+		 * \param count count of matrices
+		 * \param uniformScale if true, fast path for rotation with uniform scale is used
+		 */
+		static void normalMatrixMany(const mat4* models, mat3* out, size_t count, bool uniformScale = false);
+
+		/**
+		 * \brief Compares two mat3's element by element.
+		 * \param left first mat3
+		 * \param right second mat3
+		 * \return true if every element is equal
+		 */
+		static bool compare(const mat3& left, const mat3& right);
+
+		/**
+		 * \brief Returns pointer to first element of given container of mat3's (ex: std::vector<mat3>),
+		 * so that normal matrices can be uploaded directly.
+		 * \param matrices container with data() method
+		 * \return pointer to first float
+		 */
+		template<typename TContainer>
+		static auto value_ptr(const TContainer& matrices) -> decltype(&matrices.data()->elements[0]) {
+			return &matrices.data()->elements[0];
+		}
+
+		/**
+		 * \brief Returns pointer to first element of given mat3.
+		 * \param matrix3x3 mat3, which pointer will be returned
+		 * \return pointer to elements
+		 */
+		static const float* value_ptr(const mat3& matrix3x3);
+
+		/// \brief self-explanatory
+		friend mat3 operator*(const mat3& left, const mat3& right);
+		/// \brief self-explanatory
+		friend vec3 operator*(const mat3& left, const vec3& right);
+		/// \brief self-explanatory
+		friend mat3 operator*(const mat3& left, float right);
+		/// \brief self-explanatory
+		const float& operator[](unsigned int index) const;
+		/// \brief self-explanatory
+		float& operator[](unsigned int index);
+		/// \brief self-explanatory
+		bool operator==(const mat3& right) const;
+		/// \brief self-explanatory
+		bool operator!=(const mat3& right) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_MAT3_H
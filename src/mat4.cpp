@@ -26,6 +26,18 @@
 #include "trig.h"
 #include "basic.h"
 #include "quat.h"
+#include "mat3.h"
+#include "decomposition.h"
+#include "parallel.h"
+#include "diagnostics.h"
+#include "stridedview.h"
+#include "instrumentation.h"
+#include <cfloat>
+#include <cmath>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
 
 
 namespace marengine::maths {
@@ -47,12 +59,7 @@ namespace marengine::maths {
 	}
 
 	vec4 mat4::getColumn4(size_t index) const {
-		return {
-			elements[0 + index * 4],
-			elements[1 + index * 4],
-			elements[2 + index * 4],
-			elements[3 + index * 4]
-		};
+		return vec4::load(&elements[0 + index * 4]);
 	}
 
 	vec3 mat4::getColumn3(size_t index) const {
@@ -84,48 +91,58 @@ namespace marengine::maths {
 		return mat4(1.0f);
 	}
 
-	mat4 mat4::multiply(const mat4& other) const {
-		mat4 rtn;
-
-		const vec4 left_one{ getColumn4(0) };
-		const vec4 left_two{ getColumn4(1) };
-		const vec4 left_three{ getColumn4(2) };
-		const vec4 left_four{ getColumn4(3) };
-
-		const vec4 col1{ left_one * other[0 + 0 * 4] + left_two * other[1 + 0 * 4] + left_three * other[2 + 0 * 4] + left_four * other[3 + 0 * 4] };
-		const vec4 col2{ left_one * other[0 + 1 * 4] + left_two * other[1 + 1 * 4] + left_three * other[2 + 1 * 4] + left_four * other[3 + 1 * 4] };
-		const vec4 col3{ left_one * other[0 + 2 * 4] + left_two * other[1 + 2 * 4] + left_three * other[2 + 2 * 4] + left_four * other[3 + 2 * 4] };
-		const vec4 col4{ left_one * other[0 + 3 * 4] + left_two * other[1 + 3 * 4] + left_three * other[2 + 3 * 4] + left_four * other[3 + 3 * 4] };
-
-		rtn[0 + 0 * 4] = col1.x;
-		rtn[1 + 0 * 4] = col1.y;
-		rtn[2 + 0 * 4] = col1.z;
-		rtn[3 + 0 * 4] = col1.w;
-
-		rtn[0 + 1 * 4] = col2.x;
-		rtn[1 + 1 * 4] = col2.y;
-		rtn[2 + 1 * 4] = col2.z;
-		rtn[3 + 1 * 4] = col2.w;
-
-		rtn[0 + 2 * 4] = col3.x;
-		rtn[1 + 2 * 4] = col3.y;
-		rtn[2 + 2 * 4] = col3.z;
-		rtn[3 + 2 * 4] = col3.w;
+	// out = left * right, every column of out is sum of left columns weighted by right column.
+	// Left is loaded and every right column is read before out column is written, so out may alias.
+	static void multiplyKernel(const float* left, const float* right, float* out) {
+#if MARMATH_SIMD_SSE
+		const __m128 l0{ _mm_loadu_ps(left + 0) };
+		const __m128 l1{ _mm_loadu_ps(left + 4) };
+		const __m128 l2{ _mm_loadu_ps(left + 8) };
+		const __m128 l3{ _mm_loadu_ps(left + 12) };
+		for (size_t col = 0; col < 4; col++) {
+			const __m128 r{ _mm_loadu_ps(right + col * 4) };
+			__m128 sum{ _mm_mul_ps(l0, _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 0))) };
+			sum = _mm_add_ps(sum, _mm_mul_ps(l1, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(l2, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(l3, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+			_mm_storeu_ps(out + col * 4, sum);
+		}
+#else
+		float l[16];
+		for (size_t i = 0; i < 16; i++) {
+			l[i] = left[i];
+		}
+		for (size_t col = 0; col < 4; col++) {
+			const float r[4]{ right[0 + col * 4], right[1 + col * 4], right[2 + col * 4], right[3 + col * 4] };
+			for (size_t row = 0; row < 4; row++) {
+				out[row + col * 4] = l[row + 0 * 4] * r[0] + l[row + 1 * 4] * r[1] + l[row + 2 * 4] * r[2] + l[row + 3 * 4] * r[3];
+			}
+		}
+#endif
+	}
 
-		rtn[0 + 3 * 4] = col4.x;
-		rtn[1 + 3 * 4] = col4.y;
-		rtn[2 + 3 * 4] = col4.z;
-		rtn[3 + 3 * 4] = col4.w;
+	static void prefetchMatrix(const mat4* m) {
+#if MARMATH_SIMD_SSE
+		_mm_prefetch((const char*)m, _MM_HINT_T0);
+		_mm_prefetch((const char*)m + 32, _MM_HINT_T0);
+#else
+		(void)m;
+#endif
+	}
 
+	mat4 mat4::multiply(const mat4& other) const {
+		MARMATH_PROBE(Mat4Multiply, 1);
+		mat4 rtn;
+		multiplyKernel(elements, other.elements, rtn.elements);
 		return rtn;
 	}
 
 	vec4 mat4::multiply(const vec4& other) const {
 		return {
-			elements[0 + 0 * 4] + other.x + elements[0 + 1 * 4] + other.y + elements[0 + 2 * 4] + other.z + elements[0 + 3 * 4] + other.w,
-			elements[1 + 0 * 4] + other.x + elements[1 + 1 * 4] + other.y + elements[1 + 2 * 4] + other.z + elements[1 + 3 * 4] + other.w,
-			elements[2 + 0 * 4] + other.x + elements[2 + 1 * 4] + other.y + elements[2 + 2 * 4] + other.z + elements[2 + 3 * 4] + other.w,
-			elements[3 + 0 * 4] + other.x + elements[3 + 1 * 4] + other.y + elements[3 + 2 * 4] + other.z + elements[3 + 3 * 4] + other.w
+			elements[0 + 0 * 4] * other.x + elements[0 + 1 * 4] * other.y + elements[0 + 2 * 4] * other.z + elements[0 + 3 * 4] * other.w,
+			elements[1 + 0 * 4] * other.x + elements[1 + 1 * 4] * other.y + elements[1 + 2 * 4] * other.z + elements[1 + 3 * 4] * other.w,
+			elements[2 + 0 * 4] * other.x + elements[2 + 1 * 4] * other.y + elements[2 + 2 * 4] * other.z + elements[2 + 3 * 4] * other.w,
+			elements[3 + 0 * 4] * other.x + elements[3 + 1 * 4] * other.y + elements[3 + 2 * 4] * other.z + elements[3 + 3 * 4] * other.w
 		};
 	}
 
@@ -137,6 +154,64 @@ namespace marengine::maths {
 		return rtn;
 	}
 
+	void mat4::multiplyMany(const mat4& left, const mat4* right, mat4* out, size_t count) {
+		MARMATH_PROBE(Mat4MultiplyMany, count);
+		const mat4 l{ left };
+		MARMATH_CHECK_DENORMALS(l.elements, 16, "mat4::multiplyMany");
+		parallel::forEach(count, [&l, right, out](size_t begin, size_t end) {
+			MARMATH_CHECK_DENORMALS(right[begin].elements, 16 * (end - begin), "mat4::multiplyMany");
+			for (size_t i = begin; i < end; i++) {
+				if (i + 4 < end) {
+					prefetchMatrix(right + i + 4);
+				}
+				multiplyKernel(l.elements, right[i].elements, out[i].elements);
+			}
+			MARMATH_CHECK_FINITE(out[begin].elements, 16 * (end - begin), "mat4::multiplyMany");
+		});
+	}
+
+	void mat4::multiplyPairwise(const mat4* left, const mat4* right, mat4* out, size_t count) {
+		MARMATH_PROBE(Mat4MultiplyPairwise, count);
+		parallel::forEach(count, [left, right, out](size_t begin, size_t end) {
+			MARMATH_CHECK_DENORMALS(left[begin].elements, 16 * (end - begin), "mat4::multiplyPairwise");
+			MARMATH_CHECK_DENORMALS(right[begin].elements, 16 * (end - begin), "mat4::multiplyPairwise");
+			for (size_t i = begin; i < end; i++) {
+				prefetchMatrix(left + i + 4);
+				if (i + 4 < end) {
+					prefetchMatrix(right + i + 4);
+				}
+				multiplyKernel(left[i].elements, right[i].elements, out[i].elements);
+			}
+			MARMATH_CHECK_FINITE(out[begin].elements, 16 * (end - begin), "mat4::multiplyPairwise");
+		});
+	}
+
+	void mat4::multiplyMany(const mat4& left, const mat4* right, const stridedView<mat4>& out) {
+		MARMATH_PROBE(Mat4MultiplyMany, out.count);
+		const mat4 l{ left };
+		parallel::forEach(out.count, [&l, right, &out](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				if (i + 4 < end) {
+					prefetchMatrix(right + i + 4);
+				}
+				multiplyKernel(l.elements, right[i].elements, (float*)out.address(i));
+			}
+		});
+	}
+
+	void mat4::multiplyPairwise(const mat4* left, const mat4* right, const stridedView<mat4>& out) {
+		MARMATH_PROBE(Mat4MultiplyPairwise, out.count);
+		parallel::forEach(out.count, [left, right, &out](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				prefetchMatrix(left + i + 4);
+				if (i + 4 < end) {
+					prefetchMatrix(right + i + 4);
+				}
+				multiplyKernel(left[i].elements, right[i].elements, (float*)out.address(i));
+			}
+		});
+	}
+
 	mat4 mat4::orthographic(float left, float right, float top, float bottom, float near, float far) {
 		mat4 result(1.0f);
 
@@ -146,8 +221,31 @@ namespace marengine::maths {
 
 		result.elements[0 + 3 * 4] = (left + right) / (left - right);
 		result.elements[1 + 3 * 4] = (bottom + top) / (bottom - top);
-		result.elements[2 + 3 * 4] = (far + near) / (far - near);
+		result.elements[2 + 3 * 4] = (far + near) / (near - far);
+
+		return result;
+	}
+
+	static mat4 orthographicBase(float left, float right, float top, float bottom) {
+		mat4 result(1.0f);
+		result.elements[0 + 0 * 4] = 2.0f / (right - left);
+		result.elements[1 + 1 * 4] = 2.0f / (top - bottom);
+		result.elements[0 + 3 * 4] = (left + right) / (left - right);
+		result.elements[1 + 3 * 4] = (bottom + top) / (bottom - top);
+		return result;
+	}
 
+	mat4 mat4::orthographicZeroToOne(float left, float right, float top, float bottom, float near, float far) {
+		mat4 result{ orthographicBase(left, right, top, bottom) };
+		result.elements[2 + 2 * 4] = 1.0f / (near - far);
+		result.elements[2 + 3 * 4] = near / (near - far);
+		return result;
+	}
+
+	mat4 mat4::orthographicReversedZ(float left, float right, float top, float bottom, float near, float far) {
+		mat4 result{ orthographicBase(left, right, top, bottom) };
+		result.elements[2 + 2 * 4] = 1.0f / (far - near);
+		result.elements[2 + 3 * 4] = far / (far - near);
 		return result;
 	}
 
@@ -161,10 +259,49 @@ namespace marengine::maths {
 		result.elements[2 + 2 * 4] = - ((far + near) / (far - near));
 		result.elements[3 + 2 * 4] = -1.0f;
 		result.elements[2 + 3 * 4] = - ((2 * far * near) / (far - near));
+		result.elements[3 + 3 * 4] = 0.f;
 
 		return result;
 	}
 
+	// x, y and w rows of right-handed perspective, depth row is filled by caller
+	static mat4 perspectiveBase(float fov, float aspectRatio) {
+		const float tanfov2{ trig::tangent(fov / 2) };
+		mat4 result;
+		result.elements[0 + 0 * 4] = 1 / (aspectRatio * tanfov2);
+		result.elements[1 + 1 * 4] = 1 / tanfov2;
+		result.elements[3 + 2 * 4] = -1.0f;
+		return result;
+	}
+
+	mat4 mat4::perspectiveZeroToOne(float fov, float aspectRatio, float near, float far) {
+		mat4 result{ perspectiveBase(fov, aspectRatio) };
+		result.elements[2 + 2 * 4] = far / (near - far);
+		result.elements[2 + 3 * 4] = (near * far) / (near - far);
+		return result;
+	}
+
+	mat4 mat4::perspectiveReversedZ(float fov, float aspectRatio, float near, float far) {
+		mat4 result{ perspectiveBase(fov, aspectRatio) };
+		result.elements[2 + 2 * 4] = near / (far - near);
+		result.elements[2 + 3 * 4] = (near * far) / (far - near);
+		return result;
+	}
+
+	mat4 mat4::perspectiveInfinite(float fov, float aspectRatio, float near) {
+		mat4 result{ perspectiveBase(fov, aspectRatio) };
+		result.elements[2 + 2 * 4] = -1.0f;
+		result.elements[2 + 3 * 4] = -2.0f * near;
+		return result;
+	}
+
+	mat4 mat4::perspectiveInfiniteReversedZ(float fov, float aspectRatio, float near) {
+		mat4 result{ perspectiveBase(fov, aspectRatio) };
+		result.elements[2 + 2 * 4] = 0.0f;
+		result.elements[2 + 3 * 4] = near;
+		return result;
+	}
+
 	mat4 mat4::lookAt(vec3 eye, vec3 center, vec3 y) {
 		const vec3 fwd{ vec3::normalize(center - eye) };
 		const vec3 side{ vec3::normalize(vec3::cross(fwd, y)) };
@@ -256,6 +393,8 @@ namespace marengine::maths {
 	}
 
 	mat4 mat4::inverse(const mat4& m) {
+		MARMATH_PROBE(Mat4Inverse, 1);
+		MARMATH_CHECK_DENORMALS(m.elements, 16, "mat4::inverse");
 		mat4 inv;
 
 		inv[0] = m[5]  * m[10] * m[15] - m[5]  * m[11] * m[14] -
@@ -324,7 +463,7 @@ namespace marengine::maths {
 
 		const float det{ m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12] };
 		if (det == 0.f) {
-			static_assert(true, "Mat4 determinant is equal to 0!\n");
+			MARMATH_DIAGNOSE(SingularInverse, "mat4::inverse - determinant is equal to 0!");
 		}
 
 		const float invDet{ 1.f / det };
@@ -332,6 +471,7 @@ namespace marengine::maths {
 			inv[i] *= invDet;
 		}
 
+		MARMATH_CHECK_FINITE(inv.elements, 16, "mat4::inverse");
 		return inv;
 	}
 
@@ -393,6 +533,7 @@ namespace marengine::maths {
 	}
 
 	void mat4::decompose(const mat4& transform, vec3& translation, vec3& rotation, vec3& scale) {
+		MARMATH_PROBE(Mat4Decompose, 1);
 		mat4 localMatrix(transform);
 
 		// Normalize the matrix.
@@ -424,11 +565,27 @@ namespace marengine::maths {
 			localMatrix.getColumn3(2).length()
 		};
 
-		const vec3 row[3]{
-			localMatrix.getColumn3(0).normalize(),
-			localMatrix.getColumn3(1).normalize(),
-			localMatrix.getColumn3(2).normalize()
+		vec3 row[3]{
+			vec3::normalizeSafe(localMatrix.getColumn3(0), { 0.f, 0.f, 0.f }),
+			vec3::normalizeSafe(localMatrix.getColumn3(1), { 0.f, 0.f, 0.f }),
+			vec3::normalizeSafe(localMatrix.getColumn3(2), { 0.f, 0.f, 0.f })
+		};
+
+		// Normalized columns are rotation only for orthogonal, non-mirrored and non-degenerate basis.
+		// Otherwise rotation is taken from polar decomposition and scale from diagonal of its stretch.
+		const float shear{
+			std::fabs(vec3::dot(row[0], row[1])) + std::fabs(vec3::dot(row[0], row[2])) + std::fabs(vec3::dot(row[1], row[2]))
 		};
+		const float minimumScale{ std::fmin(scale.x, std::fmin(scale.y, scale.z)) };
+		const float maximumScale{ std::fmax(scale.x, std::fmax(scale.y, scale.z)) };
+		if (!(shear <= 1e-4f) || !(minimumScale > 1e-6f * maximumScale) || vec3::dot(vec3::cross(row[0], row[1]), row[2]) < 0.f) {
+			mat3 stretch;
+			const mat3 polarRotation{ decomposition::polar(mat3(localMatrix), &stretch) };
+			scale = { stretch[0 + 0 * 3], stretch[1 + 1 * 3], stretch[2 + 2 * 3] };
+			row[0] = polarRotation.getColumn3(0);
+			row[1] = polarRotation.getColumn3(1);
+			row[2] = polarRotation.getColumn3(2);
+		}
 
 		rotation.y = asin(-row[0].z);
 		if (cos(rotation.y) != 0.f) {
@@ -439,6 +596,10 @@ namespace marengine::maths {
 			rotation.x = atan2(-row[2].x, row[1].y);
 			rotation.z = 0.f;
 		}
+
+		MARMATH_CHECK_FINITE(&translation.x, 3, "mat4::decompose");
+		MARMATH_CHECK_FINITE(&rotation.x, 3, "mat4::decompose");
+		MARMATH_CHECK_FINITE(&scale.x, 3, "mat4::decompose");
 	}
 
 	void mat4::decompose(vec3& translation, vec3& rotation, vec3& scale) const {
@@ -471,10 +632,6 @@ namespace marengine::maths {
 		return true;
 	};
 
-	const float* mat4::value_ptr(const std::vector<mat4>& matrices) {
-		return &(*matrices.data())[0];
-	}
-
 	const float* mat4::value_ptr(const mat4& matrix4x4) {
 		return matrix4x4.elements;
 	}
@@ -491,21 +648,21 @@ namespace marengine::maths {
 		return value_ptr_nonconst(*this);
 	}
 
-	mat4 operator*(mat4 left, const mat4& right) {
+	mat4 operator*(const mat4& left, const mat4& right) {
 		return left.multiply(right);
 	}
 
-	vec4 operator*(mat4 left, const vec4& right) {
+	vec4 operator*(const mat4& left, const vec4& right) {
 		return left.multiply(right);
 	}
 
-	mat4 operator*(mat4 left, float right) {
+	mat4 operator*(const mat4& left, float right) {
 		return left.multiply(right);
 	}
 
 	const float& mat4::operator[](unsigned int index) const {
 		if (index >= 4 * 4) {
-			static_assert(true, "matrix.elements[index] out of bound!\n");
+			MARMATH_DIAGNOSE(OutOfBounds, "mat4::operator[] - index out of bound!");
 		}
 
 		return elements[index];
@@ -513,7 +670,7 @@ namespace marengine::maths {
 
 	float& mat4::operator[](unsigned int index) {
 		if (index >= 4 * 4) {
-			static_assert(true, "const matrix.elements[index] out of bound!\n");
+			MARMATH_DIAGNOSE(OutOfBounds, "mat4::operator[] - index out of bound!");
 		}
 
 		return elements[index];
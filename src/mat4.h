@@ -32,6 +32,7 @@ namespace marengine::maths {
     struct vec3;
     struct vec4;
     struct quat;
+    template<typename T> struct stridedView;
 
     
     /**
@@ -123,6 +124,46 @@ namespace marengine::maths {
          */
         mat4 multiply(float other) const;
 
+        /**
+         * \brief Computes out[i] = left * right[i] for every matrix in array, ex: viewProjection * model[i].
+         * Uses SIMD 4x4 kernel, prefetches next matrices and splits large arrays with parallel::forEach.
+         * Out is contiguous, so it can be instance buffer passed later to mat4::value_ptr. Out may be right.
+         * \param left matrix on the left side of every product
+         * \param right array of matrices on the right side
+         * \param out array, to which count products will be written
+         * \param count count of matrices
+         */
+        static void multiplyMany(const mat4& left, const mat4* right, mat4* out, size_t count);
+
+        /**
+         * \brief Computes out[i] = left[i] * right[i] for every pair, ex: parentWorld[i] * local[i].
+         * Uses SIMD 4x4 kernel, prefetches next matrices and splits large arrays with parallel::forEach.
+         * Out may be left or right.
+         * \param left array of matrices on the left side
+         * \param right array of matrices on the right side
+         * \param out array, to which count products will be written
+         * \param count count of pairs
+         */
+        static void multiplyPairwise(const mat4* left, const mat4* right, mat4* out, size_t count);
+
+        /**
+         * \brief Computes out[i] = left * right[i] for every element of out, writing directly
+         * into strided (ex: interleaved instance) buffer. Right must have at least out.count matrices.
+         * \param left matrix on the left side of every product
+         * \param right array of matrices on the right side
+         * \param out view, to which out.count products will be written (4-byte aligned)
+         */
+        static void multiplyMany(const mat4& left, const mat4* right, const stridedView<mat4>& out);
+
+        /**
+         * \brief Computes out[i] = left[i] * right[i] for every element of out, writing directly
+         * into strided (ex: interleaved instance) buffer. Left and right must have at least out.count matrices.
+         * \param left array of matrices on the left side
+         * \param right array of matrices on the right side
+         * \param out view, to which out.count products will be written (4-byte aligned)
+         */
+        static void multiplyPairwise(const mat4* left, const mat4* right, const stridedView<mat4>& out);
+
         /**
          * \brief Get Projection Matrix - Orthographic with given parameters. Usually used in 2D.
          * \param left distance left
@@ -145,6 +186,70 @@ namespace marengine::maths {
          */
         static mat4 perspective(float fov, float aspectRatio, float near, float far);
 
+        /**
+         * \brief Perspective projection, which maps depth to [0;1] (Direct3D / Vulkan / glClipControl).
+         * \param fov field of view in radians
+         * \param aspectRatio aspect ratio
+         * \param near near plane distance, mapped to 0
+         * \param far far plane distance, mapped to 1
+         * \return created perspective mat4
+         */
+        static mat4 perspectiveZeroToOne(float fov, float aspectRatio, float near, float far);
+
+        /**
+         * \brief Reversed-Z perspective projection with [0;1] depth. Near plane is mapped to 1 and far plane
+         * to 0, which spreads float depth precision evenly. Use with depth test GREATER and depth cleared to 0.
+         * \param fov field of view in radians
+         * \param aspectRatio aspect ratio
+         * \param near near plane distance, mapped to 1
+         * \param far far plane distance, mapped to 0
+         * \return created perspective mat4
+         */
+        static mat4 perspectiveReversedZ(float fov, float aspectRatio, float near, float far);
+
+        /**
+         * \brief Perspective projection with far plane at infinity and OpenGL [-1;1] depth.
+         * \param fov field of view in radians
+         * \param aspectRatio aspect ratio
+         * \param near near plane distance, mapped to -1
+         * \return created perspective mat4
+         */
+        static mat4 perspectiveInfinite(float fov, float aspectRatio, float near);
+
+        /**
+         * \brief Reversed-Z perspective projection with far plane at infinity, near plane is mapped to 1
+         * and infinity to 0. Best depth precision available with float depth buffer.
+         * \param fov field of view in radians
+         * \param aspectRatio aspect ratio
+         * \param near near plane distance, mapped to 1
+         * \return created perspective mat4
+         */
+        static mat4 perspectiveInfiniteReversedZ(float fov, float aspectRatio, float near);
+
+        /**
+         * \brief Orthographic projection, which maps depth to [0;1].
+         * \param left distance left
+         * \param right distance right
+         * \param top distance up
+         * \param bottom distance down
+         * \param near near plane distance, mapped to 0
+         * \param far far plane distance, mapped to 1
+         * \return created orthographic mat4
+         */
+        static mat4 orthographicZeroToOne(float left, float right, float top, float bottom, float near, float far);
+
+        /**
+         * \brief Reversed-Z orthographic projection, near plane is mapped to 1 and far plane to 0.
+         * \param left distance left
+         * \param right distance right
+         * \param top distance up
+         * \param bottom distance down
+         * \param near near plane distance, mapped to 1
+         * \param far far plane distance, mapped to 0
+         * \return created orthographic mat4
+         */
+        static mat4 orthographicReversedZ(float left, float right, float top, float bottom, float near, float far);
+
         /**
          * \brief Get lookAt matrix - View Matrix with given parameters.
          * \param eye defines positions of view (camera)
@@ -216,6 +321,8 @@ namespace marengine::maths {
 
         /**
          * \brief Decomposes a model matrix to translations, rotation and scale components.
+         * Sheared, mirrored or nearly singular matrices are decomposed with decomposition::polar,
+         * then scale is diagonal of stretch (negative on mirrored axis).
          * \param transform transform which will be decomposed
          * \param translation reference to which decomposed translation will be written
          * \param quaternion reference to which decomposed quaternion will be written (radians)
@@ -264,11 +371,15 @@ namespace marengine::maths {
         static bool compare(const mat4& left, const mat4& right);
 
         /**
-         * \brief Get value pointer to first matrix element. Used especially in shaders.
-         * \param matrices vector of matrices
+         * \brief Get value pointer to first matrix element at contiguous container (std::vector, std::array...).
+         * Used especially in shaders. Template, so that mat4.h doesn't need to include any container.
+         * \param matrices container of matrices
          * \return pointer to first value at first matrix
          */
-        static const float* value_ptr(const std::vector<mat4>& matrices);
+        template<typename TContainer>
+        static auto value_ptr(const TContainer& matrices) -> decltype(&matrices.data()->elements[0]) {
+            return &matrices.data()->elements[0];
+        }
     
         /**
          * \brief Get value pointer to first matrix element. Used especially in shaders.
@@ -303,7 +414,7 @@ namespace marengine::maths {
          * \param right - matrix on the right side, after * operator
          * \return mat4 - matrix 4x4 as a result of this multiplication
          */
-        friend mat4 operator*(mat4 left, const mat4& right);
+        friend mat4 operator*(const mat4& left, const mat4& right);
 
         /**
          * \brief Overloaded * multiplication operator. Says that, matrix on the left and vec4 on
@@ -312,7 +423,7 @@ namespace marengine::maths {
          * \param right - vec4 on the right side, after * operator
          * \return vec4 - 4-dimensional vector as a result of this multiplication
          */
-        friend vec4 operator*(mat4 left, const vec4& right);
+        friend vec4 operator*(const mat4& left, const vec4& right);
 
         /**
          * \brief Overloaded * multiplication operator. Says that, matrix on the left and float on
@@ -321,7 +432,7 @@ namespace marengine::maths {
          * \param right - float on the right side, after * operator
          * \return mat4 - matrix 4x4 as a result of this multiplication
          */
-        friend mat4 operator*(mat4 left, float right);
+        friend mat4 operator*(const mat4& left, float right);
     
         /**
          * \brief Overloaded [] operator, so that we have ability to call mat4[index], which returns
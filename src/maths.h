@@ -21,14 +21,15 @@
 #ifndef MAR_MATH_H
 #define MAR_MATH_H
 
-#include <iostream>
-
-#define _USE_MATH_DEFINES
-#include <cmath>
-#include <vector>
+#include <cstddef>
 
 #define MARMATH_PI 3.14159265358979323846f
 #define MARMATH_DEG2RAD 0.01745329251f
 #define MARMATH_RAD2DEG 57.29577951308f
 
+// SIMD backend selection, define MARMATH_NO_SIMD to force scalar code.
+#if !defined(MARMATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define MARMATH_SIMD_SSE 1
+#endif
+
 #endif // !MAR_MATH_H
@@ -0,0 +1,458 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "obb.h"
+#include "aabb.h"
+#include "frustum.h"
+#include "mat4.h"
+#include "quat.h"
+#include "decomposition.h"
+#include "parallel.h"
+#include "kernels.h"
+#include "instrumentation.h"
+#include <cfloat>
+#include <cmath>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	static constexpr size_t g_batchElementCost{ 4 };
+	// Added to |dot(axisA, axisB)|, so that cross products of nearly parallel axes
+	// (which are close to zero vectors) don't report false separation.
+	static constexpr float g_parallelEpsilon{ 1e-6f };
+
+	// Same semantics as _mm_min_ps / _mm_max_ps (second operand is returned for NaN),
+	// so scalar and SSE ray kernels give identical results.
+	static float minimum(float a, float b) {
+		return a < b ? a : b;
+	}
+
+	static float maximum(float a, float b) {
+		return a > b ? a : b;
+	}
+
+	obb::obb() :
+		center(0.f, 0.f, 0.f),
+		orientation(1.f),
+		halfExtents(0.f, 0.f, 0.f)
+	{}
+
+	obb::obb(vec3 _center, const mat3& _orientation, vec3 _halfExtents) :
+		center(_center),
+		orientation(_orientation),
+		halfExtents(_halfExtents)
+	{}
+
+	obb::obb(vec3 _center, quat rotation, vec3 _halfExtents) :
+		center(_center),
+		orientation(mat3::fromQuat(rotation)),
+		halfExtents(_halfExtents)
+	{}
+
+	obb obb::fromAabb(const aabb& box, const mat4& transform) {
+		const float* m{ transform.elements };
+		const vec3 c{ box.center() };
+		const vec3 half{ box.extent() * 0.5f };
+		const float halfs[3]{ half.x, half.y, half.z };
+		float extents[3];
+
+		obb rtn;
+		rtn.center = {
+			m[0] * c.x + m[4] * c.y + m[8] * c.z + m[12],
+			m[1] * c.x + m[5] * c.y + m[9] * c.z + m[13],
+			m[2] * c.x + m[6] * c.y + m[10] * c.z + m[14]
+		};
+		for (size_t col = 0; col < 3; col++) {
+			const vec3 axis{ m[0 + col * 4], m[1 + col * 4], m[2 + col * 4] };
+			const float length{ vec3::length(axis) };
+			extents[col] = halfs[col] * length;
+			if (length > 0.f) {
+				rtn.orientation[0 + col * 3] = axis.x / length;
+				rtn.orientation[1 + col * 3] = axis.y / length;
+				rtn.orientation[2 + col * 3] = axis.z / length;
+			}
+		}
+		rtn.halfExtents = { extents[0], extents[1], extents[2] };
+		return rtn;
+	}
+
+	obb obb::fromPoints(const vec3* points, size_t count) {
+		if (count == 0) {
+			return obb();
+		}
+
+		double mean[3]{ 0.0, 0.0, 0.0 };
+		for (size_t i = 0; i < count; i++) {
+			mean[0] += points[i].x;
+			mean[1] += points[i].y;
+			mean[2] += points[i].z;
+		}
+		for (double& value : mean) {
+			value /= (double)count;
+		}
+
+		double covariance[3][3]{};
+		for (size_t i = 0; i < count; i++) {
+			const double d[3]{ points[i].x - mean[0], points[i].y - mean[1], points[i].z - mean[2] };
+			for (size_t row = 0; row < 3; row++) {
+				for (size_t col = row; col < 3; col++) {
+					covariance[row][col] += d[row] * d[col];
+				}
+			}
+		}
+		mat3 m;
+		for (size_t row = 0; row < 3; row++) {
+			for (size_t col = row; col < 3; col++) {
+				m[row + col * 3] = (float)(covariance[row][col] / (double)count);
+				m[col + row * 3] = m[row + col * 3];
+			}
+		}
+
+		// Eigenvectors are sorted by decreasing variance and form proper rotation.
+		mat3 vectors;
+		vec3 variances;
+		decomposition::eigenSymmetric(m, vectors, variances);
+		const vec3 axes[3]{ vectors.getColumn3(0), vectors.getColumn3(1), vectors.getColumn3(2) };
+
+		float lowest[3]{ FLT_MAX, FLT_MAX, FLT_MAX };
+		float highest[3]{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (size_t i = 0; i < count; i++) {
+			for (size_t k = 0; k < 3; k++) {
+				const float projection{ vec3::dot(points[i], axes[k]) };
+				lowest[k] = minimum(projection, lowest[k]);
+				highest[k] = maximum(projection, highest[k]);
+			}
+		}
+
+		obb rtn;
+		rtn.center = { 0.f, 0.f, 0.f };
+		for (size_t k = 0; k < 3; k++) {
+			rtn.center = rtn.center + axes[k] * ((lowest[k] + highest[k]) * 0.5f);
+			rtn.orientation[0 + k * 3] = axes[k].x;
+			rtn.orientation[1 + k * 3] = axes[k].y;
+			rtn.orientation[2 + k * 3] = axes[k].z;
+		}
+		rtn.halfExtents = { (highest[0] - lowest[0]) * 0.5f, (highest[1] - lowest[1]) * 0.5f, (highest[2] - lowest[2]) * 0.5f };
+		return rtn;
+	}
+
+	aabb obb::toAabb() const {
+		const float* r{ orientation.elements };
+		const vec3 extent{
+			std::fabs(r[0]) * halfExtents.x + std::fabs(r[3]) * halfExtents.y + std::fabs(r[6]) * halfExtents.z,
+			std::fabs(r[1]) * halfExtents.x + std::fabs(r[4]) * halfExtents.y + std::fabs(r[7]) * halfExtents.z,
+			std::fabs(r[2]) * halfExtents.x + std::fabs(r[5]) * halfExtents.y + std::fabs(r[8]) * halfExtents.z
+		};
+		return { center - extent, center + extent };
+	}
+
+	bool obb::contains(vec3 point) const {
+		const vec3 d{ point - center };
+		const float* r{ orientation.elements };
+		const float extents[3]{ halfExtents.x, halfExtents.y, halfExtents.z };
+		for (size_t i = 0; i < 3; i++) {
+			if (std::fabs(d.x * r[0 + i * 3] + d.y * r[1 + i * 3] + d.z * r[2 + i * 3]) > extents[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Separating axis test (Gottschalk), computed in local space of a (Ericson, Real-Time Collision Detection 4.4.1).
+	static bool intersectsKernel(const obb& a, const obb& b) {
+		const float* ra{ a.orientation.elements };
+		const float* rb{ b.orientation.elements };
+		const float ea[3]{ a.halfExtents.x, a.halfExtents.y, a.halfExtents.z };
+		const float eb[3]{ b.halfExtents.x, b.halfExtents.y, b.halfExtents.z };
+		const vec3 d{ b.center - a.center };
+
+		float r[3][3];
+		float absR[3][3];
+		float t[3];
+		for (size_t i = 0; i < 3; i++) {
+			for (size_t j = 0; j < 3; j++) {
+				r[i][j] = ra[0 + i * 3] * rb[0 + j * 3] + ra[1 + i * 3] * rb[1 + j * 3] + ra[2 + i * 3] * rb[2 + j * 3];
+				absR[i][j] = std::fabs(r[i][j]) + g_parallelEpsilon;
+			}
+			t[i] = d.x * ra[0 + i * 3] + d.y * ra[1 + i * 3] + d.z * ra[2 + i * 3];
+		}
+
+		for (size_t i = 0; i < 3; i++) {
+			if (std::fabs(t[i]) > ea[i] + eb[0] * absR[i][0] + eb[1] * absR[i][1] + eb[2] * absR[i][2]) {
+				return false;
+			}
+		}
+		for (size_t j = 0; j < 3; j++) {
+			if (std::fabs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) > ea[0] * absR[0][j] + ea[1] * absR[1][j] + ea[2] * absR[2][j] + eb[j]) {
+				return false;
+			}
+		}
+		for (size_t i = 0; i < 3; i++) {
+			const size_t i1{ (i + 1) % 3 };
+			const size_t i2{ (i + 2) % 3 };
+			for (size_t j = 0; j < 3; j++) {
+				const size_t j1{ (j + 1) % 3 };
+				const size_t j2{ (j + 2) % 3 };
+				const float radiusA{ ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j] };
+				const float radiusB{ eb[j1] * absR[i][j2] + eb[j2] * absR[i][j1] };
+				if (std::fabs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > radiusA + radiusB) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	static bool intersectsRayKernel(const obb& box, vec3 origin, vec3 direction, float& distance) {
+		const float* r{ box.orientation.elements };
+		const float extents[3]{ box.halfExtents.x, box.halfExtents.y, box.halfExtents.z };
+		const vec3 relative{ origin - box.center };
+		float tmin{ 0.f };
+		float tmax{ FLT_MAX };
+		for (size_t i = 0; i < 3; i++) {
+			const float o{ relative.x * r[0 + i * 3] + relative.y * r[1 + i * 3] + relative.z * r[2 + i * 3] };
+			const float d{ direction.x * r[0 + i * 3] + direction.y * r[1 + i * 3] + direction.z * r[2 + i * 3] };
+			const float inv{ 1.f / d };
+			const float t1{ (-extents[i] - o) * inv };
+			const float t2{ (extents[i] - o) * inv };
+			tmin = maximum(tmin, minimum(t1, t2));
+			tmax = minimum(tmax, maximum(t1, t2));
+		}
+		distance = tmin;
+		return tmin <= tmax;
+	}
+
+	static bool intersectsFrustumKernel(const frustum& planes, const obb& box) {
+		const float* r{ box.orientation.elements };
+		const vec3 c{ box.center };
+		const vec3 e{ box.halfExtents };
+		for (const vec4& p : planes.planes) {
+			const float distance{ p.x * c.x + p.y * c.y + p.z * c.z + p.w };
+			const float radius{
+				e.x * std::fabs(p.x * r[0] + p.y * r[1] + p.z * r[2]) +
+				e.y * std::fabs(p.x * r[3] + p.y * r[4] + p.z * r[5]) +
+				e.z * std::fabs(p.x * r[6] + p.y * r[7] + p.z * r[8])
+			};
+			if (distance + radius < 0.f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+#if MARMATH_SIMD_SSE
+	// Four boxes transposed to SoA registers, lane k belongs to boxes[k].
+	struct obbLanesSSE {
+		__m128 center[3];
+		__m128 orientation[9];
+		__m128 halfExtents[3];
+	};
+
+	static obbLanesSSE loadLanesSSE(const obb* b) {
+		obbLanesSSE lanes;
+		lanes.center[0] = _mm_setr_ps(b[0].center.x, b[1].center.x, b[2].center.x, b[3].center.x);
+		lanes.center[1] = _mm_setr_ps(b[0].center.y, b[1].center.y, b[2].center.y, b[3].center.y);
+		lanes.center[2] = _mm_setr_ps(b[0].center.z, b[1].center.z, b[2].center.z, b[3].center.z);
+		for (size_t k = 0; k < 9; k++) {
+			lanes.orientation[k] = _mm_setr_ps(b[0].orientation.elements[k], b[1].orientation.elements[k],
+				b[2].orientation.elements[k], b[3].orientation.elements[k]);
+		}
+		lanes.halfExtents[0] = _mm_setr_ps(b[0].halfExtents.x, b[1].halfExtents.x, b[2].halfExtents.x, b[3].halfExtents.x);
+		lanes.halfExtents[1] = _mm_setr_ps(b[0].halfExtents.y, b[1].halfExtents.y, b[2].halfExtents.y, b[3].halfExtents.y);
+		lanes.halfExtents[2] = _mm_setr_ps(b[0].halfExtents.z, b[1].halfExtents.z, b[2].halfExtents.z, b[3].halfExtents.z);
+		return lanes;
+	}
+
+	static __m128 absSSE(__m128 v) {
+		return _mm_andnot_ps(_mm_set1_ps(-0.f), v);
+	}
+
+	// Same test as intersectsKernel for four boxes at once, returns bit mask of intersecting boxes.
+	static int intersectsKernelSSE(const obb& a, const obb* boxes) {
+		const obbLanesSSE b{ loadLanesSSE(boxes) };
+		const float* ra{ a.orientation.elements };
+		const float ea[3]{ a.halfExtents.x, a.halfExtents.y, a.halfExtents.z };
+		const __m128* eb{ b.halfExtents };
+		const __m128 d[3]{
+			_mm_sub_ps(b.center[0], _mm_set1_ps(a.center.x)),
+			_mm_sub_ps(b.center[1], _mm_set1_ps(a.center.y)),
+			_mm_sub_ps(b.center[2], _mm_set1_ps(a.center.z))
+		};
+
+		__m128 r[3][3];
+		__m128 absR[3][3];
+		__m128 t[3];
+		for (size_t i = 0; i < 3; i++) {
+			for (size_t j = 0; j < 3; j++) {
+				r[i][j] = kernels::dot3LanesSSE(b.orientation[0 + j * 3], b.orientation[1 + j * 3], b.orientation[2 + j * 3],
+					ra[0 + i * 3], ra[1 + i * 3], ra[2 + i * 3]);
+				absR[i][j] = _mm_add_ps(absSSE(r[i][j]), _mm_set1_ps(g_parallelEpsilon));
+			}
+			t[i] = kernels::dot3LanesSSE(d[0], d[1], d[2], ra[0 + i * 3], ra[1 + i * 3], ra[2 + i * 3]);
+		}
+
+		__m128 separated{ _mm_setzero_ps() };
+		for (size_t i = 0; i < 3; i++) {
+			const __m128 radius{ _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_set1_ps(ea[i]), _mm_mul_ps(eb[0], absR[i][0])),
+				_mm_mul_ps(eb[1], absR[i][1])), _mm_mul_ps(eb[2], absR[i][2])) };
+			separated = _mm_or_ps(separated, _mm_cmpgt_ps(absSSE(t[i]), radius));
+		}
+		for (size_t j = 0; j < 3; j++) {
+			const __m128 projection{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(t[0], r[0][j]), _mm_mul_ps(t[1], r[1][j])), _mm_mul_ps(t[2], r[2][j])) };
+			const __m128 radius{ _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(ea[0]), absR[0][j]),
+				_mm_mul_ps(_mm_set1_ps(ea[1]), absR[1][j])), _mm_mul_ps(_mm_set1_ps(ea[2]), absR[2][j])), eb[j]) };
+			separated = _mm_or_ps(separated, _mm_cmpgt_ps(absSSE(projection), radius));
+		}
+		for (size_t i = 0; i < 3; i++) {
+			const size_t i1{ (i + 1) % 3 };
+			const size_t i2{ (i + 2) % 3 };
+			for (size_t j = 0; j < 3; j++) {
+				const size_t j1{ (j + 1) % 3 };
+				const size_t j2{ (j + 2) % 3 };
+				const __m128 radiusA{ _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ea[i1]), absR[i2][j]), _mm_mul_ps(_mm_set1_ps(ea[i2]), absR[i1][j])) };
+				const __m128 radiusB{ _mm_add_ps(_mm_mul_ps(eb[j1], absR[i][j2]), _mm_mul_ps(eb[j2], absR[i][j1])) };
+				const __m128 projection{ _mm_sub_ps(_mm_mul_ps(t[i2], r[i1][j]), _mm_mul_ps(t[i1], r[i2][j])) };
+				separated = _mm_or_ps(separated, _mm_cmpgt_ps(absSSE(projection), _mm_add_ps(radiusA, radiusB)));
+			}
+		}
+		return ~_mm_movemask_ps(separated) & 0xF;
+	}
+
+	static void intersectsRayKernelSSE(const obb* boxes, vec3 origin, vec3 direction, float* distances) {
+		const obbLanesSSE b{ loadLanesSSE(boxes) };
+		const __m128 relative[3]{
+			_mm_sub_ps(_mm_set1_ps(origin.x), b.center[0]),
+			_mm_sub_ps(_mm_set1_ps(origin.y), b.center[1]),
+			_mm_sub_ps(_mm_set1_ps(origin.z), b.center[2])
+		};
+		__m128 tmin{ _mm_setzero_ps() };
+		__m128 tmax{ _mm_set1_ps(FLT_MAX) };
+		for (size_t i = 0; i < 3; i++) {
+			const __m128* axis{ b.orientation + i * 3 };
+			const __m128 o{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(relative[0], axis[0]), _mm_mul_ps(relative[1], axis[1])), _mm_mul_ps(relative[2], axis[2])) };
+			const __m128 d{ kernels::dot3LanesSSE(axis[0], axis[1], axis[2], direction.x, direction.y, direction.z) };
+			const __m128 inv{ _mm_div_ps(_mm_set1_ps(1.f), d) };
+			const __m128 t1{ _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_setzero_ps(), b.halfExtents[i]), o), inv) };
+			const __m128 t2{ _mm_mul_ps(_mm_sub_ps(b.halfExtents[i], o), inv) };
+			tmin = _mm_max_ps(tmin, _mm_min_ps(t1, t2));
+			tmax = _mm_min_ps(tmax, _mm_max_ps(t1, t2));
+		}
+		const __m128 hit{ _mm_cmple_ps(tmin, tmax) };
+		_mm_storeu_ps(distances, _mm_or_ps(_mm_and_ps(hit, tmin), _mm_andnot_ps(hit, _mm_set1_ps(FLT_MAX))));
+	}
+
+	// Returns bit mask of boxes, which may be visible.
+	static int intersectsFrustumKernelSSE(const frustum& planes, const obb* boxes) {
+		const obbLanesSSE b{ loadLanesSSE(boxes) };
+		const __m128* r{ b.orientation };
+		__m128 outside{ _mm_setzero_ps() };
+		for (const vec4& p : planes.planes) {
+			const __m128 distance{ _mm_add_ps(kernels::dot3LanesSSE(b.center[0], b.center[1], b.center[2], p.x, p.y, p.z), _mm_set1_ps(p.w)) };
+			const __m128 radius{ _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(b.halfExtents[0], absSSE(kernels::dot3LanesSSE(r[0], r[1], r[2], p.x, p.y, p.z))),
+				_mm_mul_ps(b.halfExtents[1], absSSE(kernels::dot3LanesSSE(r[3], r[4], r[5], p.x, p.y, p.z)))),
+				_mm_mul_ps(b.halfExtents[2], absSSE(kernels::dot3LanesSSE(r[6], r[7], r[8], p.x, p.y, p.z)))) };
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+		return ~_mm_movemask_ps(outside) & 0xF;
+	}
+#endif
+
+	bool obb::intersects(const obb& left, const obb& right) {
+		return intersectsKernel(left, right);
+	}
+
+	bool obb::intersects(const obb& left, const aabb& right) {
+		if (right.isEmpty()) {
+			return false;
+		}
+		return intersectsKernel(left, obb(right.center(), mat3(1.f), right.extent() * 0.5f));
+	}
+
+	bool obb::intersectsRay(vec3 origin, vec3 direction, float& distance) const {
+		return intersectsRayKernel(*this, origin, direction, distance);
+	}
+
+	bool obb::intersectsFrustum(const frustum& planes) const {
+		return intersectsFrustumKernel(planes, *this);
+	}
+
+	void obb::intersectsMany(const obb& box, const obb* boxes, size_t count, uint8_t* out) {
+		MARMATH_PROBE(ObbIntersectsMany, count);
+		parallel::forEach(count, parallel::grainSize(g_batchElementCost), [&box, boxes, out](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			for (; i + 4 <= end; i += 4) {
+				const int mask{ intersectsKernelSSE(box, boxes + i) };
+				for (size_t k = 0; k < 4; k++) {
+					out[i + k] = (uint8_t)((mask >> k) & 1);
+				}
+			}
+#endif
+			for (; i < end; i++) {
+				out[i] = intersectsKernel(box, boxes[i]) ? 1 : 0;
+			}
+		});
+	}
+
+	void obb::intersectsRayMany(vec3 origin, vec3 direction, const obb* boxes, size_t count, float* distances) {
+		MARMATH_PROBE(ObbIntersectsRayMany, count);
+		parallel::forEach(count, parallel::grainSize(g_batchElementCost), [origin, direction, boxes, distances](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			for (; i + 4 <= end; i += 4) {
+				intersectsRayKernelSSE(boxes + i, origin, direction, distances + i);
+			}
+#endif
+			for (; i < end; i++) {
+				float distance;
+				distances[i] = intersectsRayKernel(boxes[i], origin, direction, distance) ? distance : FLT_MAX;
+			}
+		});
+	}
+
+	void obb::intersectsFrustumMany(const frustum& planes, const obb* boxes, size_t count, uint8_t* visible) {
+		MARMATH_PROBE(ObbIntersectsFrustumMany, count);
+		parallel::forEach(count, parallel::grainSize(g_batchElementCost), [&planes, boxes, visible](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			for (; i + 4 <= end; i += 4) {
+				const int mask{ intersectsFrustumKernelSSE(planes, boxes + i) };
+				for (size_t k = 0; k < 4; k++) {
+					visible[i + k] = (uint8_t)((mask >> k) & 1);
+				}
+			}
+#endif
+			for (; i < end; i++) {
+				visible[i] = intersectsFrustumKernel(planes, boxes[i]) ? 1 : 0;
+			}
+		});
+	}
+
+
+}
@@ -0,0 +1,175 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_OBB_H
+#define MAR_MATH_OBB_H
+
+
+#include "maths.h"
+#include "vec3.h"
+#include "mat3.h"
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+	struct quat;
+	struct mat4;
+	struct aabb;
+	struct frustum;
+
+
+	/**
+	 * \struct obb obb.h "obb.h"
+	 * \brief Oriented bounding box given by its center, orthonormal orientation (columns are
+	 * local axes of box in world space) and half-extents along these axes. Box is usually much
+	 * tighter than aabb around rotated or elongated geometry.
+	 */
+	struct obb {
+
+		/// \brief center of box in world space
+		vec3 center;
+		/// \brief rotation of box, column i is unit direction of local axis i
+		mat3 orientation;
+		/// \brief half of box size along every local axis
+		vec3 halfExtents;
+
+
+		/// \brief Default constructor, creates box with zero size at origin, aligned with world axes.
+		obb();
+
+		/**
+		 * \brief Constructor, that creates box from given orientation matrix.
+		 * \param _center center of box
+		 * \param _orientation orthonormal rotation matrix
+		 * \param _halfExtents half of box size along every local axis
+		 */
+		obb(vec3 _center, const mat3& _orientation, vec3 _halfExtents);
+
+		/**
+		 * \brief Constructor, that creates box from given rotation (same basis as quat::rotationFromQuat).
+		 * \param _center center of box
+		 * \param rotation unit quaternion
+		 * \param _halfExtents half of box size along every local axis
+		 */
+		obb(vec3 _center, quat rotation, vec3 _halfExtents);
+
+		/**
+		 * \brief Creates box bounding given aabb after transformation. Scale of transform is moved
+		 * into half-extents, so transform must be affine without shear.
+		 * \param box local box, must not be empty
+		 * \param transform local to world matrix
+		 * \return transformed box
+		 */
+		static obb fromAabb(const aabb& box, const mat4& transform);
+
+		/**
+		 * \brief Fits box to given points. Axes are eigenvectors of covariance matrix of points
+		 * (principal component analysis), so box follows the direction, in which points spread the most.
+		 * \param points array of points
+		 * \param count count of points
+		 * \return fitted box, default box if count is 0
+		 */
+		static obb fromPoints(const vec3* points, size_t count);
+
+		/**
+		 * \brief Computes the smallest aabb containing box.
+		 * \return bounding aabb
+		 */
+		aabb toAabb() const;
+
+		/**
+		 * \brief Checks, if point lies inside box (boundary included).
+		 * \param point point to check
+		 * \return true, if point is inside
+		 */
+		bool contains(vec3 point) const;
+
+		/**
+		 * \brief Separating axis test of two boxes (15 axes), touching boxes intersect.
+		 * \param left first box
+		 * \param right second box
+		 * \return true, if boxes intersect
+		 */
+		static bool intersects(const obb& left, const obb& right);
+
+		/**
+		 * \brief Separating axis test of box and aabb.
+		 * \param left oriented box
+		 * \param right axis-aligned box
+		 * \return true, if boxes intersect, false if aabb is empty
+		 */
+		static bool intersects(const obb& left, const aabb& right);
+
+		/**
+		 * \brief Intersects ray with box (slab test in local space of box).
+		 * \param origin origin of ray
+		 * \param direction direction of ray, doesn't have to be normalized
+		 * \param distance reference, to which entry parameter t (hit = origin + t * direction) will be
+		 * written, 0 if origin is inside box
+		 * \return true, if ray hits box
+		 */
+		bool intersectsRay(vec3 origin, vec3 direction, float& distance) const;
+
+		/**
+		 * \brief Conservative test of box against frustum.
+		 * \param planes frustum in world space
+		 * \return false, if box is fully outside of any plane
+		 */
+		bool intersectsFrustum(const frustum& planes) const;
+
+		/**
+		 * \brief Tests box against many boxes (four at once with SSE), large arrays are split with parallel::forEach.
+		 * \param box tested box
+		 * \param boxes array of boxes
+		 * \param count count of boxes
+		 * \param out array, to which count results (1 if boxes intersect, 0 otherwise) will be written
+		 */
+		static void intersectsMany(const obb& box, const obb* boxes, size_t count, uint8_t* out);
+
+		/**
+		 * \brief Intersects ray with many boxes (four at once with SSE), large arrays are split with parallel::forEach.
+		 * \param origin origin of ray
+		 * \param direction direction of ray, doesn't have to be normalized
+		 * \param boxes array of boxes
+		 * \param count count of boxes
+		 * \param distances array, to which count entry parameters will be written, FLT_MAX for missed boxes
+		 */
+		static void intersectsRayMany(vec3 origin, vec3 direction, const obb* boxes, size_t count, float* distances);
+
+		/**
+		 * \brief Culls many boxes against frustum (four at once with SSE), large arrays are split with parallel::forEach.
+		 * \param planes frustum in world space
+		 * \param boxes array of boxes
+		 * \param count count of boxes
+		 * \param visible array, to which count results (1 if box may be visible, 0 otherwise) will be written
+		 */
+		static void intersectsFrustumMany(const frustum& planes, const obb* boxes, size_t count, uint8_t* visible);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_OBB_H
@@ -0,0 +1,270 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "parallel.h"
+#include "diagnostics.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * Work-stealing pool. Every thread (calling thread has index 0) owns a queue of chunks,
+	 * pops from its back and, when empty, steals from the front of other queues.
+	 */
+	struct threadPool {
+
+		struct chunk {
+			size_t begin;
+			size_t end;
+			const parallel::task* function;
+		};
+
+		struct workQueue {
+			std::mutex mutex;
+			std::deque<chunk> chunks;
+		};
+
+		explicit threadPool(size_t threads) {
+			for (size_t i = 0; i < threads; i++) {
+				queues.push_back(std::make_unique<workQueue>());
+			}
+			for (size_t i = 1; i < threads; i++) {
+				workers.emplace_back([this, i]() { workerLoop(i); });
+			}
+		}
+
+		~threadPool() {
+			{
+				std::lock_guard<std::mutex> lock(wakeMutex);
+				stopping = true;
+			}
+			wake.notify_all();
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+		}
+
+		size_t size() const {
+			return queues.size();
+		}
+
+		void run(size_t count, size_t grainSize, const parallel::task& function) {
+			const size_t chunkCount{ (count + grainSize - 1) / grainSize };
+			pending.store(chunkCount);
+			for (size_t i = 0; i < chunkCount; i++) {
+				const chunk c{ i * grainSize, std::min(count, (i + 1) * grainSize), &function };
+				workQueue& queue{ *queues[i % queues.size()] };
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				queue.chunks.push_back(c);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(wakeMutex);
+				generation++;
+			}
+			wake.notify_all();
+
+			processChunks(0);
+			while (pending.load() != 0) {
+				std::this_thread::yield();
+			}
+
+			// every chunk is finished, so no worker holds &function anymore
+			if (failed.load()) {
+				std::exception_ptr exception{ firstException };
+				firstException = nullptr;
+				failed.store(false);
+				std::rethrow_exception(exception);
+			}
+		}
+
+	private:
+
+		bool popChunk(size_t self, chunk& c) {
+			{
+				workQueue& own{ *queues[self] };
+				std::lock_guard<std::mutex> lock(own.mutex);
+				if (!own.chunks.empty()) {
+					c = own.chunks.back();
+					own.chunks.pop_back();
+					return true;
+				}
+			}
+			for (size_t i = 1; i < queues.size(); i++) {
+				workQueue& victim{ *queues[(self + i) % queues.size()] };
+				std::lock_guard<std::mutex> lock(victim.mutex);
+				if (!victim.chunks.empty()) {
+					c = victim.chunks.front();
+					victim.chunks.pop_front();
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void processChunks(size_t self) {
+			chunk c;
+			while (popChunk(self, c)) {
+				// after first exception remaining chunks are only drained, so run() can return
+				if (!failed.load()) {
+					insideTask = true;
+					try {
+						(*c.function)(c.begin, c.end);
+					}
+					catch (...) {
+						std::lock_guard<std::mutex> lock(exceptionMutex);
+						if (!firstException) {
+							firstException = std::current_exception();
+						}
+						failed.store(true);
+					}
+					insideTask = false;
+				}
+				pending.fetch_sub(1);
+			}
+		}
+
+		void workerLoop(size_t self) {
+			size_t seenGeneration{ 0 };
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock(wakeMutex);
+					wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+					if (stopping) {
+						return;
+					}
+					seenGeneration = generation;
+				}
+				processChunks(self);
+			}
+		}
+
+	public:
+
+		static thread_local bool insideTask;
+
+	private:
+
+		std::vector<std::unique_ptr<workQueue>> queues;
+		std::vector<std::thread> workers;
+		std::mutex wakeMutex;
+		std::condition_variable wake;
+		std::atomic<size_t> pending{ 0 };
+		std::atomic<bool> failed{ false };
+		std::mutex exceptionMutex;
+		std::exception_ptr firstException;
+		size_t generation{ 0 };
+		bool stopping{ false };
+
+	};
+
+	thread_local bool threadPool::insideTask{ false };
+
+	static std::unique_ptr<threadPool> g_pool;
+	static std::mutex g_poolMutex;
+	static std::atomic<size_t> g_threadCount{ 1 };
+	static std::atomic<size_t> g_grainSize{ 1024 };
+
+
+	static void forEachSerially(size_t count, size_t grainSize, const parallel::task& function) {
+		const denormalScope denormals;
+		for (size_t begin = 0; begin < count; begin += grainSize) {
+			function(begin, std::min(count, begin + grainSize));
+		}
+	}
+
+	void parallel::setThreadCount(size_t count) {
+		if (count == 0) {
+			count = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+
+		std::lock_guard<std::mutex> lock(g_poolMutex);
+		g_pool.reset();
+		if (count > 1) {
+			g_pool = std::make_unique<threadPool>(count);
+		}
+		g_threadCount.store(count);
+	}
+
+	size_t parallel::threadCount() {
+		return g_threadCount.load();
+	}
+
+	void parallel::setGrainSize(size_t grainSize) {
+		g_grainSize.store(std::max<size_t>(1, grainSize));
+	}
+
+	size_t parallel::grainSize() {
+		return g_grainSize.load();
+	}
+
+	size_t parallel::grainSize(size_t elementCost) {
+		return std::max<size_t>(1, g_grainSize.load() / std::max<size_t>(1, elementCost));
+	}
+
+	void parallel::forEach(size_t count, size_t grainSize, const task& function) {
+		if (count == 0) {
+			return;
+		}
+		grainSize = std::max<size_t>(1, grainSize);
+
+		const bool runSerially{ g_threadCount.load() == 1 || count <= grainSize || threadPool::insideTask };
+		if (runSerially) {
+			forEachSerially(count, grainSize, function);
+			return;
+		}
+
+		// pool has single pending counter, so whole run is guarded (see class documentation)
+		std::lock_guard<std::mutex> lock(g_poolMutex);
+		if (!g_pool) {
+			// setThreadCount(1) disabled pool after thread count was checked
+			forEachSerially(count, grainSize, function);
+			return;
+		}
+		if (diagnostics::flushDenormals()) {
+			const task flushing{ [&function](size_t begin, size_t end) {
+				const denormalScope denormals;
+				function(begin, end);
+			} };
+			g_pool->run(count, grainSize, flushing);
+			return;
+		}
+		g_pool->run(count, grainSize, function);
+	}
+
+	void parallel::forEach(size_t count, const task& function) {
+		forEach(count, grainSize(), function);
+	}
+
+
+}
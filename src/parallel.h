@@ -0,0 +1,119 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_PARALLEL_H
+#define MAR_MATH_PARALLEL_H
+
+
+#include "maths.h"
+#include <functional>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct parallel parallel.h "parallel.h"
+	 * \brief parallel is optional execution layer for batch methods. It owns work-stealing
+	 * thread pool, which splits [0;count) range into chunks of grain size. Chunk boundaries
+	 * depend only on count and grain size and every index is processed exactly once, so batch
+	 * methods, that write to disjoint output ranges, produce the same result regardless of
+	 * thread count.
+	 *
+	 * By default library is single-threaded (thread count equal to 1), call setThreadCount()
+	 * to enable pool.
+	 *
+	 * There is single pool and it runs one forEach at a time: calls from different threads
+	 * are serialized, second caller blocks until every chunk of first call is processed
+	 * (calling thread takes part in the work and spins, while workers finish last chunks).
+	 * Independent systems, that need to batch concurrently, should not rely on the pool
+	 * to overlap their work.
+	 */
+	struct parallel {
+
+		/**
+		 * \brief Task called for every chunk, begin is inclusive, end is exclusive.
+		 */
+		using task = std::function<void(size_t begin, size_t end)>;
+
+		/**
+		 * \brief Sets count of threads used by batch methods (including calling thread).
+		 * Pass 0 to use std::thread::hardware_concurrency(), pass 1 to disable pool.
+		 * Do not call it during parallel::forEach!
+		 * \param count count of threads
+		 */
+		static void setThreadCount(size_t count);
+
+		/**
+		 * \brief Returns count of threads used by batch methods (including calling thread).
+		 * \return thread count
+		 */
+		static size_t threadCount();
+
+		/**
+		 * \brief Sets grain size used by batch methods, that do not take it explicitly.
+		 * \param grainSize minimal count of elements processed by single task call, 0 is treated as 1
+		 */
+		static void setGrainSize(size_t grainSize);
+
+		/**
+		 * \brief Returns grain size used by batch methods, that do not take it explicitly.
+		 * \return grain size
+		 */
+		static size_t grainSize();
+
+		/**
+		 * \brief Returns grain size for batch methods, whose single element costs about as much
+		 * as elementCost elements of element-wise batch method, so that chunks stay equally heavy
+		 * and follow setGrainSize.
+		 * \param elementCost relative cost of single element, 0 is treated as 1
+		 * \return grainSize() / elementCost, at least 1
+		 */
+		static size_t grainSize(size_t elementCost);
+
+		/**
+		 * \brief Splits [0;count) into chunks of grainSize elements and calls task for every chunk.
+		 * If pool is disabled, count is not greater than grainSize or method is called from
+		 * inside of another task, chunks are processed on calling thread. Method returns after
+		 * every chunk is processed. If task throws, chunks not started yet are skipped and first
+		 * exception is rethrown on calling thread after all workers have finished.
+		 * \param count count of elements
+		 * \param grainSize count of elements in single chunk (last chunk may be smaller)
+		 * \param function task, that will be called for every chunk
+		 */
+		static void forEach(size_t count, size_t grainSize, const task& function);
+
+		/**
+		 * \brief Calls forEach with grain size returned by parallel::grainSize().
+		 * \param count count of elements
+		 * \param function task, that will be called for every chunk
+		 */
+		static void forEach(size_t count, const task& function);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_PARALLEL_H
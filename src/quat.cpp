@@ -26,6 +26,7 @@
 #include "mat4.h"
 #include "vec4.h"
 #include "vec3.h"
+#include <cmath>
 
 
 namespace marengine::maths {
@@ -100,5 +101,34 @@ namespace marengine::maths {
 		return rtn;
 	}
 
+	quat quat::multiply(quat left, quat right) {
+		return {
+			left.w * right.w - left.x * right.x - left.y * right.y - left.z * right.z,
+			left.w * right.x + left.x * right.w + left.y * right.z - left.z * right.y,
+			left.w * right.y - left.x * right.z + left.y * right.w + left.z * right.x,
+			left.w * right.z + left.x * right.y - left.y * right.x + left.z * right.w
+		};
+	}
+
+	quat quat::normalize(quat q) {
+		const float invLength{ 1.f / std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z) };
+		return { q.w * invLength, q.x * invLength, q.y * invLength, q.z * invLength };
+	}
+
+	quat quat::derivative(quat q, vec3 angularVelocity) {
+		const vec3 w{ angularVelocity * 0.5f };
+		return {
+			-w.x * q.x - w.y * q.y - w.z * q.z,
+			w.x * q.w + w.y * q.z - w.z * q.y,
+			w.y * q.w + w.z * q.x - w.x * q.z,
+			w.z * q.w + w.x * q.y - w.y * q.x
+		};
+	}
+
+	quat quat::integrate(quat q, vec3 angularVelocity, float dt) {
+		const quat d{ derivative(q, angularVelocity) };
+		return normalize({ q.w + d.w * dt, q.x + d.x * dt, q.y + d.y * dt, q.z + d.z * dt });
+	}
+
 
 }
@@ -87,6 +87,40 @@ namespace marengine::maths {
 		 */
 		static mat4 rotationFromQuat(quat q);
 
+		/**
+		 * \brief Computes Hamilton product of quanternions, rotation by result is rotation by right followed by left.
+		 * \param left first quanternion
+		 * \param right second quanternion
+		 * \return left * right
+		 */
+		static quat multiply(quat left, quat right);
+
+		/**
+		 * \brief Normalizes quanternion, so that it is unit and represents pure rotation.
+		 * \param q quanternion, which will be normalized (must not be zero)
+		 * \return normalized quanternion
+		 */
+		static quat normalize(quat q);
+
+		/**
+		 * \brief Computes time derivative of orientation rotating with given angular velocity,
+		 * dq/dt = 0.5 * quat(0, angularVelocity) * q.
+		 * \param q current orientation
+		 * \param angularVelocity angular velocity in world space (radians per second)
+		 * \return derivative of orientation
+		 */
+		static quat derivative(quat q, vec3 angularVelocity);
+
+		/**
+		 * \brief Advances orientation by one explicit step of its derivative and renormalizes it,
+		 * which is accurate for small angularVelocity * dt (as in rigid body integration every tick).
+		 * \param q current orientation
+		 * \param angularVelocity angular velocity in world space (radians per second)
+		 * \param dt time step in seconds
+		 * \return new orientation
+		 */
+		static quat integrate(quat q, vec3 angularVelocity, float dt);
+
 	};
 
 
@@ -0,0 +1,149 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "radixsort.h"
+#include "parallel.h"
+#include "instrumentation.h"
+#include <vector>
+
+
+namespace marengine::maths {
+
+
+	template<typename TKey>
+	static void sortImpl(const TKey* keys, uint32_t* order, size_t count, std::vector<TKey>* keysBuffer,
+		std::vector<uint32_t>* orderBuffer, std::vector<size_t>& offsets, TKey* sortedKeys)
+	{
+		constexpr size_t radix{ 256 };
+		constexpr size_t minimalBlockSize{ 4096 };
+
+		// Blocks are processed in order of their index, so that scatter keeps sort stable.
+		size_t blockCount{ (count + minimalBlockSize - 1) / minimalBlockSize };
+		const size_t maxBlockCount{ parallel::threadCount() * 4 };
+		blockCount = blockCount < maxBlockCount ? blockCount : maxBlockCount;
+		blockCount = blockCount > 0 ? blockCount : 1;
+		const size_t blockSize{ (count + blockCount - 1) / blockCount };
+
+		// assign and resize keep capacity, so reused buffers are not reallocated
+		keysBuffer[0].assign(keys, keys + count);
+		keysBuffer[1].resize(count);
+		orderBuffer[0].resize(count);
+		orderBuffer[1].resize(count);
+		for (size_t i = 0; i < count; i++) {
+			orderBuffer[0][i] = (uint32_t)i;
+		}
+		offsets.resize(blockCount * radix);
+
+		size_t current{ 0 };
+		for (uint32_t shift = 0; shift < sizeof(TKey) * 8; shift += 8) {
+			const TKey* srcKeys{ keysBuffer[current].data() };
+			const uint32_t* srcOrder{ orderBuffer[current].data() };
+			TKey* dstKeys{ keysBuffer[current ^ 1].data() };
+			uint32_t* dstOrder{ orderBuffer[current ^ 1].data() };
+			size_t* blockOffsets{ offsets.data() };
+
+			parallel::forEach(blockCount, 1, [&](size_t blockBegin, size_t blockEnd) {
+				for (size_t block = blockBegin; block < blockEnd; block++) {
+					size_t* histogram{ blockOffsets + block * radix };
+					for (size_t d = 0; d < radix; d++) {
+						histogram[d] = 0;
+					}
+					const size_t end{ (block + 1) * blockSize < count ? (block + 1) * blockSize : count };
+					for (size_t i = block * blockSize; i < end; i++) {
+						histogram[(srcKeys[i] >> shift) & 0xFF]++;
+					}
+				}
+			});
+
+			// Exclusive prefix sum, digit-major, so that block b places its keys after keys
+			// of the same digit from blocks before it.
+			bool sameDigit{ false };
+			size_t running{ 0 };
+			for (size_t d = 0; d < radix; d++) {
+				size_t digitCount{ 0 };
+				for (size_t block = 0; block < blockCount; block++) {
+					const size_t blockCountOfDigit{ blockOffsets[block * radix + d] };
+					blockOffsets[block * radix + d] = running;
+					running += blockCountOfDigit;
+					digitCount += blockCountOfDigit;
+				}
+				sameDigit = sameDigit || digitCount == count;
+			}
+			if (sameDigit) {
+				continue;
+			}
+
+			parallel::forEach(blockCount, 1, [&](size_t blockBegin, size_t blockEnd) {
+				for (size_t block = blockBegin; block < blockEnd; block++) {
+					size_t* offset{ blockOffsets + block * radix };
+					const size_t end{ (block + 1) * blockSize < count ? (block + 1) * blockSize : count };
+					for (size_t i = block * blockSize; i < end; i++) {
+						const size_t destination{ offset[(srcKeys[i] >> shift) & 0xFF]++ };
+						dstKeys[destination] = srcKeys[i];
+						dstOrder[destination] = srcOrder[i];
+					}
+				}
+			});
+			current ^= 1;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			order[i] = orderBuffer[current][i];
+		}
+		if (sortedKeys) {
+			for (size_t i = 0; i < count; i++) {
+				sortedKeys[i] = keysBuffer[current][i];
+			}
+		}
+	}
+
+	void radixSort::sort(const uint32_t* keys, uint32_t* order, size_t count, uint32_t* sortedKeys) {
+		buffers scratch;
+		sort(keys, order, count, scratch, sortedKeys);
+	}
+
+	void radixSort::sort(const uint32_t* keys, uint32_t* order, size_t count, buffers& scratch, uint32_t* sortedKeys) {
+		MARMATH_PROBE(RadixSortSort, count);
+		sortImpl(keys, order, count, scratch.keys32, scratch.order, scratch.offsets, sortedKeys);
+	}
+
+	void radixSort::sort(const uint64_t* keys, uint32_t* order, size_t count, uint64_t* sortedKeys) {
+		buffers scratch;
+		sort(keys, order, count, scratch, sortedKeys);
+	}
+
+	void radixSort::sort(const uint64_t* keys, uint32_t* order, size_t count, buffers& scratch, uint64_t* sortedKeys) {
+		MARMATH_PROBE(RadixSortSort, count);
+		sortImpl(keys, order, count, scratch.keys64, scratch.order, scratch.offsets, sortedKeys);
+	}
+
+	void radixSort::gatherSoA(const uint32_t* order, const float* const* in, float* const* out, size_t laneCount, size_t count) {
+		parallel::forEach(laneCount, 1, [order, in, out, count](size_t begin, size_t end) {
+			for (size_t lane = begin; lane < end; lane++) {
+				gather(order, in[lane], out[lane], count);
+			}
+		});
+	}
+
+
+}
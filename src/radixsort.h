@@ -0,0 +1,134 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_RADIXSORT_H
+#define MAR_MATH_RADIXSORT_H
+
+
+#include "maths.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct radixSort radixsort.h "radixsort.h"
+	 * \brief Stable LSD radix sort of 32 / 64 bit keys (ex: spatialCode), 8 bits per pass. Keys
+	 * are not moved around with data, sort produces order (permutation), which is then applied
+	 * to every stream with gather / gatherSoA. Passes, in which every key has the same digit,
+	 * are skipped. Histograms and scatters of large arrays run on parallel pool, result doesn't
+	 * depend on thread count as sort is stable.
+	 *
+	 * \code
+	 *   spatialCode::morton30Many(positions, count, aabb::fromPoints(positions, count), codes);
+	 *   radixSort::sort(codes, order, count);
+	 *   radixSort::gather(order, transforms, sortedTransforms, count);
+	 * \endcode
+	 */
+	struct radixSort {
+
+		/**
+		 * \struct buffers radixsort.h "radixsort.h"
+		 * \brief Scratch storage of sort. Buffers only grow, so sorting with the same object every
+		 * frame doesn't allocate once it has seen the largest count. Must not be shared between
+		 * concurrent sorts.
+		 */
+		struct buffers {
+			std::vector<uint32_t> keys32[2];
+			std::vector<uint64_t> keys64[2];
+			std::vector<uint32_t> order[2];
+			std::vector<size_t> offsets;
+		};
+
+		/**
+		 * \brief Computes order, in which keys are sorted ascending (equal keys keep their order).
+		 * \param keys array of keys
+		 * \param order array, to which count indices will be written, keys[order[0]] is the smallest
+		 * \param count count of keys, must be less than 2^32
+		 * \param sortedKeys optional array, to which sorted keys will be written
+		 */
+		static void sort(const uint32_t* keys, uint32_t* order, size_t count, uint32_t* sortedKeys = nullptr);
+
+		/**
+		 * \brief Same as sort, but uses given scratch buffers instead of allocating its own.
+		 * \param keys array of keys
+		 * \param order array, to which count indices will be written, keys[order[0]] is the smallest
+		 * \param count count of keys, must be less than 2^32
+		 * \param scratch buffers reused between calls
+		 * \param sortedKeys optional array, to which sorted keys will be written
+		 */
+		static void sort(const uint32_t* keys, uint32_t* order, size_t count, buffers& scratch, uint32_t* sortedKeys = nullptr);
+
+		/**
+		 * \brief Computes order, in which keys are sorted ascending (equal keys keep their order).
+		 * \param keys array of keys
+		 * \param order array, to which count indices will be written, keys[order[0]] is the smallest
+		 * \param count count of keys, must be less than 2^32
+		 * \param sortedKeys optional array, to which sorted keys will be written
+		 */
+		static void sort(const uint64_t* keys, uint32_t* order, size_t count, uint64_t* sortedKeys = nullptr);
+
+		/**
+		 * \brief Same as sort, but uses given scratch buffers instead of allocating its own.
+		 * \param keys array of keys
+		 * \param order array, to which count indices will be written, keys[order[0]] is the smallest
+		 * \param count count of keys, must be less than 2^32
+		 * \param scratch buffers reused between calls
+		 * \param sortedKeys optional array, to which sorted keys will be written
+		 */
+		static void sort(const uint64_t* keys, uint32_t* order, size_t count, buffers& scratch, uint64_t* sortedKeys = nullptr);
+
+		/**
+		 * \brief Reorders array, out[i] = in[order[i]]. In and out must not overlap.
+		 * \param order order computed by sort
+		 * \param in array, which will be reordered
+		 * \param out array, to which count reordered elements will be written
+		 * \param count count of elements
+		 */
+		template<typename T>
+		static void gather(const uint32_t* order, const T* in, T* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = in[order[i]];
+			}
+		}
+
+		/**
+		 * \brief Reorders every lane of SoA arrays, out[lane][i] = in[lane][order[i]]. Lanes are
+		 * reordered on parallel pool. In and out must not overlap.
+		 * \param order order computed by sort
+		 * \param in pointers to lanes, which will be reordered
+		 * \param out pointers to lanes, to which count reordered floats will be written
+		 * \param laneCount count of lanes
+		 * \param count count of elements in every lane
+		 */
+		static void gatherSoA(const uint32_t* order, const float* const* in, float* const* out, size_t laneCount, size_t count);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_RADIXSORT_H
@@ -0,0 +1,401 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "rigidbody.h"
+#include "vec3.h"
+#include "quat.h"
+#include "mat3.h"
+#include "mat4.h"
+#include "parallel.h"
+#include "diagnostics.h"
+#include "instrumentation.h"
+#include <cmath>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	static constexpr size_t g_bodyElementCost{ 4 };
+
+	struct rigidBodyStep {
+		vec3 gravity;
+		float dt;
+		bool kick;
+		bool drift;
+		bool clearForces;
+	};
+
+	static float inverseOrZero(float f) {
+		return f != 0.f ? 1.f / f : 0.f;
+	}
+
+	// Rotation of unit quaternion, column-major as mat3::fromQuat.
+	static void rotation(float w, float x, float y, float z, float* r) {
+		r[0] = 1.f - 2.f * (y * y + z * z);
+		r[1] = 2.f * (x * y + w * z);
+		r[2] = 2.f * (x * z - w * y);
+		r[3] = 2.f * (x * y - w * z);
+		r[4] = 1.f - 2.f * (x * x + z * z);
+		r[5] = 2.f * (y * z + w * x);
+		r[6] = 2.f * (x * z + w * y);
+		r[7] = 2.f * (y * z - w * x);
+		r[8] = 1.f - 2.f * (x * x + y * y);
+	}
+
+	// R * diag(d) * transpose(R) as xx, yy, zz, xy, xz, yz.
+	static void worldInverseInertia(const float* r, float dx, float dy, float dz, float* out) {
+		out[0] = r[0] * r[0] * dx + r[3] * r[3] * dy + r[6] * r[6] * dz;
+		out[1] = r[1] * r[1] * dx + r[4] * r[4] * dy + r[7] * r[7] * dz;
+		out[2] = r[2] * r[2] * dx + r[5] * r[5] * dy + r[8] * r[8] * dz;
+		out[3] = r[0] * r[1] * dx + r[3] * r[4] * dy + r[6] * r[7] * dz;
+		out[4] = r[0] * r[2] * dx + r[3] * r[5] * dy + r[6] * r[8] * dz;
+		out[5] = r[1] * r[2] * dx + r[4] * r[5] * dy + r[7] * r[8] * dz;
+	}
+
+	static void storeInverseInertiaWorld(rigidBodyArrays& b, size_t i, const float* inertia) {
+		b.inverseInertiaWorldXX[i] = inertia[0];
+		b.inverseInertiaWorldYY[i] = inertia[1];
+		b.inverseInertiaWorldZZ[i] = inertia[2];
+		b.inverseInertiaWorldXY[i] = inertia[3];
+		b.inverseInertiaWorldXZ[i] = inertia[4];
+		b.inverseInertiaWorldYZ[i] = inertia[5];
+	}
+
+	size_t rigidBodyArrays::add(vec3 position, quat orientation, float mass, vec3 inertia) {
+		const size_t index{ size() };
+		resize(index + 1);
+		const quat q{ quat::normalize(orientation) };
+		positionX[index] = position.x;
+		positionY[index] = position.y;
+		positionZ[index] = position.z;
+		orientationW[index] = q.w;
+		orientationX[index] = q.x;
+		orientationY[index] = q.y;
+		orientationZ[index] = q.z;
+		inverseMass[index] = inverseOrZero(mass);
+		inverseInertiaX[index] = inverseOrZero(inertia.x);
+		inverseInertiaY[index] = inverseOrZero(inertia.y);
+		inverseInertiaZ[index] = inverseOrZero(inertia.z);
+
+		float r[9];
+		float world[6];
+		rotation(q.w, q.x, q.y, q.z, r);
+		worldInverseInertia(r, inverseInertiaX[index], inverseInertiaY[index], inverseInertiaZ[index], world);
+		storeInverseInertiaWorld(*this, index, world);
+		return index;
+	}
+
+	void rigidBodyArrays::resize(size_t count) {
+		std::vector<float>* lanes[]{
+			&positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+			&orientationW, &orientationX, &orientationY, &orientationZ,
+			&angularVelocityX, &angularVelocityY, &angularVelocityZ,
+			&forceX, &forceY, &forceZ, &torqueX, &torqueY, &torqueZ,
+			&inverseMass, &inverseInertiaX, &inverseInertiaY, &inverseInertiaZ,
+			&inverseInertiaWorldXX, &inverseInertiaWorldYY, &inverseInertiaWorldZZ,
+			&inverseInertiaWorldXY, &inverseInertiaWorldXZ, &inverseInertiaWorldYZ
+		};
+		for (std::vector<float>* lane : lanes) {
+			lane->resize(count, 0.f);
+		}
+	}
+
+	size_t rigidBodyArrays::size() const {
+		return positionX.size();
+	}
+
+	mat3 rigidBodyArrays::inverseInertiaWorld(size_t index) const {
+		mat3 rtn;
+		rtn[0 + 0 * 3] = inverseInertiaWorldXX[index];
+		rtn[1 + 1 * 3] = inverseInertiaWorldYY[index];
+		rtn[2 + 2 * 3] = inverseInertiaWorldZZ[index];
+		rtn[0 + 1 * 3] = rtn[1 + 0 * 3] = inverseInertiaWorldXY[index];
+		rtn[0 + 2 * 3] = rtn[2 + 0 * 3] = inverseInertiaWorldXZ[index];
+		rtn[1 + 2 * 3] = rtn[2 + 1 * 3] = inverseInertiaWorldYZ[index];
+		return rtn;
+	}
+
+	// Velocities are changed by accumulated forces and torques, angular acceleration uses inverse
+	// inertia of current orientation.
+	static void kickBody(rigidBodyArrays& b, const rigidBodyStep& s, size_t i) {
+		const float dt{ s.dt };
+		const float invMass{ b.inverseMass[i] };
+		const float dynamic{ invMass > 0.f ? 1.f : 0.f };
+		b.velocityX[i] += (s.gravity.x * dynamic + b.forceX[i] * invMass) * dt;
+		b.velocityY[i] += (s.gravity.y * dynamic + b.forceY[i] * invMass) * dt;
+		b.velocityZ[i] += (s.gravity.z * dynamic + b.forceZ[i] * invMass) * dt;
+
+		float r[9];
+		float inertia[6];
+		rotation(b.orientationW[i], b.orientationX[i], b.orientationY[i], b.orientationZ[i], r);
+		worldInverseInertia(r, b.inverseInertiaX[i], b.inverseInertiaY[i], b.inverseInertiaZ[i], inertia);
+		const float tx{ b.torqueX[i] };
+		const float ty{ b.torqueY[i] };
+		const float tz{ b.torqueZ[i] };
+		b.angularVelocityX[i] += (inertia[0] * tx + inertia[3] * ty + inertia[4] * tz) * dt;
+		b.angularVelocityY[i] += (inertia[3] * tx + inertia[1] * ty + inertia[5] * tz) * dt;
+		b.angularVelocityZ[i] += (inertia[4] * tx + inertia[5] * ty + inertia[2] * tz) * dt;
+	}
+
+	// Positions and orientations are moved by current velocities.
+	static void driftBody(rigidBodyArrays& b, const rigidBodyStep& s, mat4* transforms, size_t i) {
+		const float dt{ s.dt };
+		b.positionX[i] += b.velocityX[i] * dt;
+		b.positionY[i] += b.velocityY[i] * dt;
+		b.positionZ[i] += b.velocityZ[i] * dt;
+
+		const quat q{ quat::integrate({ b.orientationW[i], b.orientationX[i], b.orientationY[i], b.orientationZ[i] },
+			{ b.angularVelocityX[i], b.angularVelocityY[i], b.angularVelocityZ[i] }, dt) };
+		b.orientationW[i] = q.w;
+		b.orientationX[i] = q.x;
+		b.orientationY[i] = q.y;
+		b.orientationZ[i] = q.z;
+
+		float r[9];
+		float inertia[6];
+		rotation(q.w, q.x, q.y, q.z, r);
+		worldInverseInertia(r, b.inverseInertiaX[i], b.inverseInertiaY[i], b.inverseInertiaZ[i], inertia);
+		storeInverseInertiaWorld(b, i, inertia);
+
+		if (transforms) {
+			float* m{ transforms[i].elements };
+			for (size_t col = 0; col < 3; col++) {
+				m[0 + col * 4] = r[0 + col * 3];
+				m[1 + col * 4] = r[1 + col * 3];
+				m[2 + col * 4] = r[2 + col * 3];
+				m[3 + col * 4] = 0.f;
+			}
+			m[12] = b.positionX[i];
+			m[13] = b.positionY[i];
+			m[14] = b.positionZ[i];
+			m[15] = 1.f;
+		}
+	}
+
+	static void integrateBody(rigidBodyArrays& b, const rigidBodyStep& s, mat4* transforms, size_t i) {
+		if (s.kick) {
+			kickBody(b, s, i);
+		}
+		if (s.drift) {
+			driftBody(b, s, transforms, i);
+		}
+		if (s.clearForces) {
+			b.forceX[i] = b.forceY[i] = b.forceZ[i] = 0.f;
+			b.torqueX[i] = b.torqueY[i] = b.torqueZ[i] = 0.f;
+		}
+	}
+
+#if MARMATH_SIMD_SSE
+	static void rotationSSE(__m128 w, __m128 x, __m128 y, __m128 z, __m128* r) {
+		const __m128 one{ _mm_set1_ps(1.f) };
+		const __m128 two{ _mm_set1_ps(2.f) };
+		const __m128 xx{ _mm_mul_ps(x, x) };
+		const __m128 yy{ _mm_mul_ps(y, y) };
+		const __m128 zz{ _mm_mul_ps(z, z) };
+		const __m128 xy{ _mm_mul_ps(x, y) };
+		const __m128 xz{ _mm_mul_ps(x, z) };
+		const __m128 yz{ _mm_mul_ps(y, z) };
+		const __m128 wx{ _mm_mul_ps(w, x) };
+		const __m128 wy{ _mm_mul_ps(w, y) };
+		const __m128 wz{ _mm_mul_ps(w, z) };
+		r[0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+		r[1] = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+		r[2] = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+		r[3] = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+		r[4] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+		r[5] = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+		r[6] = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+		r[7] = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+		r[8] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+	}
+
+	static __m128 sandwichSSE(__m128 a0, __m128 b0, __m128 a1, __m128 b1, __m128 a2, __m128 b2, __m128 dx, __m128 dy, __m128 dz) {
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(a0, b0), dx), _mm_mul_ps(_mm_mul_ps(a1, b1), dy)), _mm_mul_ps(_mm_mul_ps(a2, b2), dz));
+	}
+
+	static void inverseInertiaWorldSSE(const __m128* r, __m128 dx, __m128 dy, __m128 dz, __m128* out) {
+		out[0] = sandwichSSE(r[0], r[0], r[3], r[3], r[6], r[6], dx, dy, dz);
+		out[1] = sandwichSSE(r[1], r[1], r[4], r[4], r[7], r[7], dx, dy, dz);
+		out[2] = sandwichSSE(r[2], r[2], r[5], r[5], r[8], r[8], dx, dy, dz);
+		out[3] = sandwichSSE(r[0], r[1], r[3], r[4], r[6], r[7], dx, dy, dz);
+		out[4] = sandwichSSE(r[0], r[2], r[3], r[5], r[6], r[8], dx, dy, dz);
+		out[5] = sandwichSSE(r[1], r[2], r[4], r[5], r[7], r[8], dx, dy, dz);
+	}
+
+	// Same as kickBody for bodies i ... i + 3.
+	static void kickBodiesSSE(rigidBodyArrays& b, const rigidBodyStep& s, size_t i) {
+		const auto load = [i](const std::vector<float>& lane) { return _mm_loadu_ps(lane.data() + i); };
+		const auto store = [i](std::vector<float>& lane, __m128 value) { _mm_storeu_ps(lane.data() + i, value); };
+		const __m128 dt{ _mm_set1_ps(s.dt) };
+		const __m128 invMass{ load(b.inverseMass) };
+		const __m128 dynamic{ _mm_cmpgt_ps(invMass, _mm_setzero_ps()) };
+		const __m128 a[3]{
+			_mm_add_ps(_mm_and_ps(_mm_set1_ps(s.gravity.x), dynamic), _mm_mul_ps(load(b.forceX), invMass)),
+			_mm_add_ps(_mm_and_ps(_mm_set1_ps(s.gravity.y), dynamic), _mm_mul_ps(load(b.forceY), invMass)),
+			_mm_add_ps(_mm_and_ps(_mm_set1_ps(s.gravity.z), dynamic), _mm_mul_ps(load(b.forceZ), invMass))
+		};
+		std::vector<float>* velocities[3]{ &b.velocityX, &b.velocityY, &b.velocityZ };
+		for (size_t k = 0; k < 3; k++) {
+			store(*velocities[k], _mm_add_ps(load(*velocities[k]), _mm_mul_ps(a[k], dt)));
+		}
+
+		__m128 r[9];
+		__m128 inertia[6];
+		rotationSSE(load(b.orientationW), load(b.orientationX), load(b.orientationY), load(b.orientationZ), r);
+		inverseInertiaWorldSSE(r, load(b.inverseInertiaX), load(b.inverseInertiaY), load(b.inverseInertiaZ), inertia);
+		const __m128 tx{ load(b.torqueX) };
+		const __m128 ty{ load(b.torqueY) };
+		const __m128 tz{ load(b.torqueZ) };
+		const auto row = [tx, ty, tz](__m128 i0, __m128 i1, __m128 i2) {
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(i0, tx), _mm_mul_ps(i1, ty)), _mm_mul_ps(i2, tz));
+		};
+		store(b.angularVelocityX, _mm_add_ps(load(b.angularVelocityX), _mm_mul_ps(row(inertia[0], inertia[3], inertia[4]), dt)));
+		store(b.angularVelocityY, _mm_add_ps(load(b.angularVelocityY), _mm_mul_ps(row(inertia[3], inertia[1], inertia[5]), dt)));
+		store(b.angularVelocityZ, _mm_add_ps(load(b.angularVelocityZ), _mm_mul_ps(row(inertia[4], inertia[5], inertia[2]), dt)));
+	}
+
+	// Same as driftBody for bodies i ... i + 3.
+	static void driftBodiesSSE(rigidBodyArrays& b, const rigidBodyStep& s, mat4* transforms, size_t i) {
+		const auto load = [i](const std::vector<float>& lane) { return _mm_loadu_ps(lane.data() + i); };
+		const auto store = [i](std::vector<float>& lane, __m128 value) { _mm_storeu_ps(lane.data() + i, value); };
+		const __m128 zero{ _mm_setzero_ps() };
+		const __m128 dt{ _mm_set1_ps(s.dt) };
+		std::vector<float>* positions[3]{ &b.positionX, &b.positionY, &b.positionZ };
+		std::vector<float>* velocities[3]{ &b.velocityX, &b.velocityY, &b.velocityZ };
+		__m128 p[3];
+		for (size_t k = 0; k < 3; k++) {
+			p[k] = _mm_add_ps(load(*positions[k]), _mm_mul_ps(load(*velocities[k]), dt));
+			store(*positions[k], p[k]);
+		}
+
+		const __m128 wx{ load(b.angularVelocityX) };
+		const __m128 wy{ load(b.angularVelocityY) };
+		const __m128 wz{ load(b.angularVelocityZ) };
+		__m128 qw{ load(b.orientationW) };
+		__m128 qx{ load(b.orientationX) };
+		__m128 qy{ load(b.orientationY) };
+		__m128 qz{ load(b.orientationZ) };
+
+		// q += quat::derivative(q, w) * dt, then normalize
+		const __m128 hx{ _mm_mul_ps(wx, _mm_set1_ps(0.5f)) };
+		const __m128 hy{ _mm_mul_ps(wy, _mm_set1_ps(0.5f)) };
+		const __m128 hz{ _mm_mul_ps(wz, _mm_set1_ps(0.5f)) };
+		const __m128 dw{ _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(zero, _mm_mul_ps(hx, qx)), _mm_mul_ps(hy, qy)), _mm_mul_ps(hz, qz)) };
+		const __m128 dqx{ _mm_sub_ps(_mm_add_ps(_mm_mul_ps(hx, qw), _mm_mul_ps(hy, qz)), _mm_mul_ps(hz, qy)) };
+		const __m128 dqy{ _mm_sub_ps(_mm_add_ps(_mm_mul_ps(hy, qw), _mm_mul_ps(hz, qx)), _mm_mul_ps(hx, qz)) };
+		const __m128 dqz{ _mm_sub_ps(_mm_add_ps(_mm_mul_ps(hz, qw), _mm_mul_ps(hx, qy)), _mm_mul_ps(hy, qx)) };
+		qw = _mm_add_ps(qw, _mm_mul_ps(dw, dt));
+		qx = _mm_add_ps(qx, _mm_mul_ps(dqx, dt));
+		qy = _mm_add_ps(qy, _mm_mul_ps(dqy, dt));
+		qz = _mm_add_ps(qz, _mm_mul_ps(dqz, dt));
+		const __m128 lengthSquared{ _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qw, qw), _mm_mul_ps(qx, qx)), _mm_mul_ps(qy, qy)), _mm_mul_ps(qz, qz)) };
+		const __m128 invLength{ _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(lengthSquared)) };
+		qw = _mm_mul_ps(qw, invLength);
+		qx = _mm_mul_ps(qx, invLength);
+		qy = _mm_mul_ps(qy, invLength);
+		qz = _mm_mul_ps(qz, invLength);
+		store(b.orientationW, qw);
+		store(b.orientationX, qx);
+		store(b.orientationY, qy);
+		store(b.orientationZ, qz);
+
+		__m128 r[9];
+		__m128 inertia[6];
+		rotationSSE(qw, qx, qy, qz, r);
+		inverseInertiaWorldSSE(r, load(b.inverseInertiaX), load(b.inverseInertiaY), load(b.inverseInertiaZ), inertia);
+		store(b.inverseInertiaWorldXX, inertia[0]);
+		store(b.inverseInertiaWorldYY, inertia[1]);
+		store(b.inverseInertiaWorldZZ, inertia[2]);
+		store(b.inverseInertiaWorldXY, inertia[3]);
+		store(b.inverseInertiaWorldXZ, inertia[4]);
+		store(b.inverseInertiaWorldYZ, inertia[5]);
+
+		if (transforms) {
+			// Every column of four matrices is one transpose of four lane registers.
+			__m128 columns[4][4]{
+				{ r[0], r[1], r[2], zero },
+				{ r[3], r[4], r[5], zero },
+				{ r[6], r[7], r[8], zero },
+				{ p[0], p[1], p[2], _mm_set1_ps(1.f) }
+			};
+			for (size_t col = 0; col < 4; col++) {
+				__m128* c{ columns[col] };
+				_MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+				for (size_t k = 0; k < 4; k++) {
+					_mm_storeu_ps(transforms[i + k].elements + col * 4, c[k]);
+				}
+			}
+		}
+	}
+
+	// Same as integrateBody for bodies i ... i + 3.
+	static void integrateBodiesSSE(rigidBodyArrays& b, const rigidBodyStep& s, mat4* transforms, size_t i) {
+		if (s.kick) {
+			kickBodiesSSE(b, s, i);
+		}
+		if (s.drift) {
+			driftBodiesSSE(b, s, transforms, i);
+		}
+		if (s.clearForces) {
+			for (std::vector<float>* lane : { &b.forceX, &b.forceY, &b.forceZ, &b.torqueX, &b.torqueY, &b.torqueZ }) {
+				_mm_storeu_ps(lane->data() + i, _mm_setzero_ps());
+			}
+		}
+	}
+#endif
+
+	static void integrate(rigidBodyArrays& bodies, const rigidBodyStep& step, mat4* transforms) {
+		MARMATH_PROBE(RigidBodyIntegrate, bodies.size());
+		parallel::forEach(bodies.size(), parallel::grainSize(g_bodyElementCost), [&bodies, &step, transforms](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			for (; i + 4 <= end; i += 4) {
+				integrateBodiesSSE(bodies, step, transforms, i);
+			}
+#endif
+			for (; i < end; i++) {
+				integrateBody(bodies, step, transforms, i);
+			}
+			MARMATH_CHECK_FINITE(bodies.positionX.data() + begin, end - begin, "rigidBody::integrate");
+			MARMATH_CHECK_FINITE(bodies.orientationW.data() + begin, end - begin, "rigidBody::integrate");
+		});
+	}
+
+	void rigidBody::integrateSemiImplicitEuler(rigidBodyArrays& bodies, vec3 gravity, float dt, mat4* transforms) {
+		integrate(bodies, { gravity, dt, true, true, true }, transforms);
+	}
+
+	void rigidBody::kick(rigidBodyArrays& bodies, vec3 gravity, float dt) {
+		integrate(bodies, { gravity, dt, true, false, false }, nullptr);
+	}
+
+	void rigidBody::drift(rigidBodyArrays& bodies, float dt, mat4* transforms) {
+		integrate(bodies, { vec3(0.f, 0.f, 0.f), dt, false, true, false }, transforms);
+	}
+
+
+}
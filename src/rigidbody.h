@@ -0,0 +1,156 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_RIGIDBODY_H
+#define MAR_MATH_RIGIDBODY_H
+
+
+#include "maths.h"
+#include <vector>
+
+
+namespace marengine::maths {
+
+	struct vec3;
+	struct quat;
+	struct mat3;
+	struct mat4;
+
+
+	/**
+	 * \struct rigidBodyArrays rigidbody.h "rigidbody.h"
+	 * \brief Structure of arrays container of rigid body state, every lane has size() floats.
+	 * Orientation is unit quaternion, angular velocity is in world space. Inertia is given by
+	 * principal moments in body space, its world space inverse is refreshed by integrators after
+	 * every step, so that solvers can read it directly. Forces and torques are accumulated by user
+	 * and cleared by integrateSemiImplicitEuler (kick keeps them, see rigidBody::kick). Bodies with
+	 * inverse mass 0 are static (gravity doesn't affect them).
+	 */
+	struct rigidBodyArrays {
+		/// \brief positions of centers of mass
+		std::vector<float> positionX, positionY, positionZ;
+		/// \brief linear velocities
+		std::vector<float> velocityX, velocityY, velocityZ;
+		/// \brief orientations (unit quaternions)
+		std::vector<float> orientationW, orientationX, orientationY, orientationZ;
+		/// \brief angular velocities in world space
+		std::vector<float> angularVelocityX, angularVelocityY, angularVelocityZ;
+		/// \brief forces accumulated for next step
+		std::vector<float> forceX, forceY, forceZ;
+		/// \brief torques accumulated for next step
+		std::vector<float> torqueX, torqueY, torqueZ;
+		/// \brief inverse masses, 0 for static bodies
+		std::vector<float> inverseMass;
+		/// \brief inverse principal moments of inertia in body space
+		std::vector<float> inverseInertiaX, inverseInertiaY, inverseInertiaZ;
+		/// \brief symmetric inverse inertia tensor in world space (six unique elements)
+		std::vector<float> inverseInertiaWorldXX, inverseInertiaWorldYY, inverseInertiaWorldZZ,
+			inverseInertiaWorldXY, inverseInertiaWorldXZ, inverseInertiaWorldYZ;
+
+
+		/**
+		 * \brief Appends body at rest.
+		 * \param position position of center of mass
+		 * \param orientation rotation from body to world space, it is normalized
+		 * \param mass mass of body, 0 creates static body
+		 * \param inertia principal moments of inertia in body space (ex: from decomposition::principalAxes)
+		 * \return index of body
+		 */
+		size_t add(vec3 position, quat orientation, float mass, vec3 inertia);
+
+		/**
+		 * \brief Resizes every lane, new bodies are zero-initialized (set orientationW to 1 before integration).
+		 * \param count new count of bodies
+		 */
+		void resize(size_t count);
+
+		/**
+		 * \brief Returns count of bodies.
+		 * \return count of bodies
+		 */
+		size_t size() const;
+
+		/**
+		 * \brief Returns world space inverse inertia tensor of body, as computed by last integration or add().
+		 * \param index index of body
+		 * \return inverse inertia tensor
+		 */
+		mat3 inverseInertiaWorld(size_t index) const;
+
+	};
+
+
+	/**
+	 * \struct rigidBody rigidbody.h "rigidbody.h"
+	 * \brief Integrators of rigidBodyArrays. Four bodies are integrated at once with SIMD, large
+	 * arrays are split with parallel::forEach. Angular velocity is changed by torque through world
+	 * space inverse inertia, gyroscopic term is omitted (it is usually handled by solver or damping).
+	 * Orientation is advanced with quaternion derivative and renormalized (as quat::integrate).
+	 *
+	 * Velocity Verlet is composed by caller from kick and drift, so that forces can be recomputed
+	 * at new positions between them:
+	 * \code
+	 *   rigidBody::kick(bodies, gravity, dt * 0.5f);
+	 *   rigidBody::drift(bodies, dt, transforms);
+	 *   computeForces(bodies); // replaces forceX ... torqueZ with forces at new positions
+	 *   rigidBody::kick(bodies, gravity, dt * 0.5f);
+	 * \endcode
+	 */
+	struct rigidBody {
+
+		/**
+		 * \brief Semi-implicit (symplectic) Euler step, velocities are updated first and positions
+		 * are moved by new velocities. Stable default for game physics.
+		 * \param bodies bodies, which will be integrated
+		 * \param gravity acceleration applied to dynamic bodies
+		 * \param dt time step in seconds
+		 * \param transforms optional array, to which size() world matrices (translation * rotation) will be written
+		 */
+		static void integrateSemiImplicitEuler(rigidBodyArrays& bodies, vec3 gravity, float dt, mat4* transforms = nullptr);
+
+		/**
+		 * \brief Changes linear and angular velocities by gravity and accumulated forces and torques,
+		 * positions and orientations are not changed. Forces and torques are kept, so that caller
+		 * decides, when they are recomputed.
+		 * \param bodies bodies, whose velocities will be changed
+		 * \param gravity acceleration applied to dynamic bodies
+		 * \param dt time step in seconds (half of step for velocity Verlet)
+		 */
+		static void kick(rigidBodyArrays& bodies, vec3 gravity, float dt);
+
+		/**
+		 * \brief Moves positions and orientations by current velocities and refreshes world space
+		 * inverse inertia, velocities, forces and torques are not changed.
+		 * \param bodies bodies, which will be moved
+		 * \param dt time step in seconds
+		 * \param transforms optional array, to which size() world matrices (translation * rotation) will be written
+		 */
+		static void drift(rigidBodyArrays& bodies, float dt, mat4* transforms = nullptr);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_RIGIDBODY_H
@@ -0,0 +1,98 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "rotor2.h"
+#include "vec2.h"
+#include "diagnostics.h"
+#include <cmath>
+
+
+namespace marengine::maths {
+
+
+	rotor2::rotor2() :
+		c(1.f),
+		s(0.f)
+	{}
+
+	rotor2::rotor2(float _c, float _s) :
+		c(_c),
+		s(_s)
+	{}
+
+	rotor2 rotor2::fromAngle(float radians) {
+		return { std::cos(radians), std::sin(radians) };
+	}
+
+	rotor2 rotor2::between(vec2 from, vec2 to) {
+		return { from.x * to.x + from.y * to.y, from.x * to.y - from.y * to.x };
+	}
+
+	float rotor2::angle() const {
+		return std::atan2(s, c);
+	}
+
+	vec2 rotor2::rotate(vec2 v) const {
+		return { c * v.x - s * v.y, s * v.x + c * v.y };
+	}
+
+	rotor2 rotor2::multiply(rotor2 other) const {
+		return { c * other.c - s * other.s, c * other.s + s * other.c };
+	}
+
+	rotor2 rotor2::inverse(rotor2 r) {
+		return { r.c, -r.s };
+	}
+
+	rotor2 rotor2::normalize(rotor2 r) {
+		const float length{ std::sqrt(r.c * r.c + r.s * r.s) };
+		if (length == 0.f) {
+			MARMATH_DIAGNOSE(ZeroLengthNormalize, "rotor2::normalize - length is equal to 0!");
+		}
+
+		return { r.c / length, r.s / length };
+	}
+
+	rotor2 rotor2::nlerp(rotor2 left, rotor2 right, float t) {
+		// Unlike quaternions, -r is different rotation (by angle + pi), so there is no sign flip here.
+		return normalize({ left.c + (right.c - left.c) * t, left.s + (right.s - left.s) * t });
+	}
+
+	rotor2 operator*(rotor2 left, rotor2 right) {
+		return left.multiply(right);
+	}
+
+	vec2 operator*(rotor2 left, vec2 right) {
+		return left.rotate(right);
+	}
+
+	bool rotor2::operator==(rotor2 other) const {
+		return c == other.c && s == other.s;
+	}
+
+	bool rotor2::operator!=(rotor2 other) const {
+		return !(*this == other);
+	}
+
+
+}
@@ -0,0 +1,135 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_ROTOR2_H
+#define MAR_MATH_ROTOR2_H
+
+
+#include "maths.h"
+
+
+namespace marengine::maths {
+
+	struct vec2;
+
+
+	/**
+	 * \struct rotor2 rotor2.h "rotor2.h"
+	 * \brief 2D rotation stored as unit complex number c + s*i, where c = cos(angle) and
+	 * s = sin(angle). Rotating vector and composing rotations need only multiplications,
+	 * so sine and cosine are computed once, when angle changes, not for every vertex.
+	 */
+	struct rotor2 {
+
+		/// \brief cosine of rotation angle (real part)
+		float c;
+		/// \brief sine of rotation angle (imaginary part)
+		float s;
+
+
+		/// \brief Default constructor, creates identity rotation rotor2(1.f, 0.f).
+		rotor2();
+
+		/**
+		 * \brief Constructor, that creates rotor2 from given cosine and sine.
+		 * \param _c cosine of angle
+		 * \param _s sine of angle
+		 */
+		rotor2(float _c, float _s);
+
+		/**
+		 * \brief Creates rotor2 rotating counter-clockwise by given angle.
+		 * \param radians angle in radians
+		 * \return created rotor2
+		 */
+		static rotor2 fromAngle(float radians);
+
+		/**
+		 * \brief Creates shortest rotor2, that rotates direction from onto direction to.
+		 * \param from unit vector
+		 * \param to unit vector
+		 * \return created rotor2
+		 */
+		static rotor2 between(vec2 from, vec2 to);
+
+		/**
+		 * \brief Returns angle of rotation.
+		 * \return angle in radians <-pi;pi>
+		 */
+		float angle() const;
+
+		/**
+		 * \brief Rotates given vector.
+		 * \param v vector, which will be rotated
+		 * \return rotated vector
+		 */
+		vec2 rotate(vec2 v) const;
+
+		/**
+		 * \brief Composes rotations, result first rotates by other and then by *this.
+		 * As 2D rotations commute, order doesn't change the result.
+		 * \param other second rotor2
+		 * \return composed rotor2
+		 */
+		rotor2 multiply(rotor2 other) const;
+
+		/**
+		 * \brief Returns inverse rotation (conjugate of unit complex number).
+		 * \param r rotor2, which will be inverted
+		 * \return inverted rotor2
+		 */
+		static rotor2 inverse(rotor2 r);
+
+		/**
+		 * \brief Brings rotor2 back to unit length, use it after many compositions.
+		 * \param r rotor2, which will be normalized
+		 * \return normalized rotor2
+		 */
+		static rotor2 normalize(rotor2 r);
+
+		/**
+		 * \brief Normalized linear interpolation between two rotations. It takes the shorter arc (rotations must not be opposite),
+		 * angular velocity is not constant, but error is negligible for small angles.
+		 * \param left rotation for t equal to 0
+		 * \param right rotation for t equal to 1
+		 * \param t interpolation factor <0;1>
+		 * \return interpolated rotor2
+		 */
+		static rotor2 nlerp(rotor2 left, rotor2 right, float t);
+
+		/// \brief self-explanatory
+		friend rotor2 operator*(rotor2 left, rotor2 right);
+		/// \brief self-explanatory
+		friend vec2 operator*(rotor2 left, vec2 right);
+		/// \brief self-explanatory
+		bool operator==(rotor2 other) const;
+		/// \brief self-explanatory
+		bool operator!=(rotor2 other) const;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_ROTOR2_H
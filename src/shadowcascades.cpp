@@ -0,0 +1,104 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "shadowcascades.h"
+#include "vec4.h"
+#include "trig.h"
+#include <cmath>
+
+
+namespace marengine::maths {
+
+
+	void shadowCascades::splitDistances(float near, float far, float lambda, float* splits, size_t count) {
+		splits[0] = near;
+		for (size_t i = 1; i < count; i++) {
+			const float fraction{ (float)i / (float)count };
+			const float logarithmic{ near * std::pow(far / near, fraction) };
+			const float uniform{ near + (far - near) * fraction };
+			splits[i] = lambda * logarithmic + (1.f - lambda) * uniform;
+		}
+		splits[count] = far;
+	}
+
+	void shadowCascades::compute(const mat4& cameraInverseView, float fov, float aspectRatio, float near, float far,
+		vec3 lightDirection, float lambda, float resolution, cascade* out, size_t count, bool zeroToOne,
+		float casterExtension) {
+		constexpr size_t maxCascades{ 16 };
+		float splits[maxCascades + 1];
+		count = count < maxCascades ? count : maxCascades;
+		splitDistances(near, far, lambda, splits, count);
+
+		const vec3 direction{ vec3::normalize(lightDirection) };
+		const vec3 up{ std::fabs(direction.y) > 0.99f ? vec3(0.f, 0.f, 1.f) : vec3(0.f, 1.f, 0.f) };
+
+		// distance of slice corner from view axis divided by its depth
+		const float tanHalfFov{ trig::tangent(fov / 2.f) };
+		const float k2{ tanHalfFov * tanHalfFov * (1.f + aspectRatio * aspectRatio) };
+
+		for (size_t i = 0; i < count; i++) {
+			const float n{ splits[i] };
+			const float f{ splits[i + 1] };
+
+			// smallest sphere containing slice corners, its center lies on view axis
+			float centerDepth{ 0.5f * (n + f) * (1.f + k2) };
+			float radius;
+			if (centerDepth >= f) {
+				centerDepth = f;
+				radius = f * std::sqrt(k2);
+			}
+			else {
+				radius = std::sqrt((f - centerDepth) * (f - centerDepth) + f * f * k2);
+			}
+			// quantized radius keeps texel size constant between frames
+			radius = std::ceil(radius * 16.f) / 16.f;
+
+			const vec4 centerWorld{ cameraInverseView * vec4(0.f, 0.f, -centerDepth, 1.f) };
+			const vec3 center{ centerWorld.x, centerWorld.y, centerWorld.z };
+
+			// eye moves only along light direction, so texel snapping below is not affected by extension
+			const float eyeDistance{ radius + casterExtension };
+			cascade& c{ out[i] };
+			c.view = mat4::lookAt(center - direction * eyeDistance, center, up);
+			c.projection = zeroToOne ?
+				mat4::orthographicZeroToOne(-radius, radius, radius, -radius, 0.f, eyeDistance + radius) :
+				mat4::orthographic(-radius, radius, radius, -radius, 0.f, eyeDistance + radius);
+
+			// snap projected world origin to whole texels
+			const mat4 unsnapped{ c.projection * c.view };
+			const float texelsPerUnit{ resolution * 0.5f };
+			const float originX{ unsnapped.elements[0 + 3 * 4] * texelsPerUnit };
+			const float originY{ unsnapped.elements[1 + 3 * 4] * texelsPerUnit };
+			c.projection.elements[0 + 3 * 4] += (std::round(originX) - originX) / texelsPerUnit;
+			c.projection.elements[1 + 3 * 4] += (std::round(originY) - originY) / texelsPerUnit;
+
+			c.viewProjection = c.projection * c.view;
+			c.center = center;
+			c.radius = radius;
+			c.splitNear = n;
+			c.splitFar = f;
+		}
+	}
+
+
+}
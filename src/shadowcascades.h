@@ -0,0 +1,106 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_SHADOWCASCADES_H
+#define MAR_MATH_SHADOWCASCADES_H
+
+
+#include "maths.h"
+#include "vec3.h"
+#include "mat4.h"
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct cascade shadowcascades.h "shadowcascades.h"
+	 * \brief Light matrices and bounds of single shadow cascade.
+	 */
+	struct cascade {
+
+		/// \brief view matrix of light
+		mat4 view;
+		/// \brief orthographic projection, snapped to shadow map texels
+		mat4 projection;
+		/// \brief projection * view
+		mat4 viewProjection;
+		/// \brief center of bounding sphere of frustum slice in world space
+		vec3 center;
+		/// \brief radius of bounding sphere of frustum slice
+		float radius;
+		/// \brief view space distance, where slice begins
+		float splitNear;
+		/// \brief view space distance, where slice ends
+		float splitFar;
+
+	};
+
+
+	/**
+	 * \struct shadowCascades shadowcascades.h "shadowcascades.h"
+	 * \brief Cascaded shadow map setup. Every cascade is fitted with bounding sphere of its frustum
+	 * slice, so its size doesn't change when camera rotates, and its projection is snapped to whole
+	 * texels, so shadows don't shimmer when camera moves.
+	 */
+	struct shadowCascades {
+
+		/**
+		 * \brief Computes split distances blending uniform and logarithmic scheme (practical split scheme).
+		 * \param near near plane distance of camera
+		 * \param far far plane distance of camera (ex: max shadow distance)
+		 * \param lambda 0 gives uniform splits, 1 logarithmic ones, 0.5 - 0.8 is usual
+		 * \param splits array of count + 1 floats, first is near, last is far
+		 * \param count count of cascades
+		 */
+		static void splitDistances(float near, float far, float lambda, float* splits, size_t count);
+
+		/**
+		 * \brief Computes count cascades for perspective camera in one call.
+		 * \param cameraInverseView inverse of camera view matrix (camera to world)
+		 * \param fov camera field of view in radians
+		 * \param aspectRatio camera aspect ratio
+		 * \param near camera near plane distance
+		 * \param far distance, up to which shadows are rendered
+		 * \param lightDirection direction, in which light shines
+		 * \param lambda split scheme blend, see splitDistances
+		 * \param resolution shadow map resolution in texels (width == height)
+		 * \param out array of count cascades
+		 * \param count count of cascades (at most 16)
+		 * \param zeroToOne true to build projections with [0;1] depth instead of [-1;1]
+		 * \param casterExtension distance, by which light eye and near plane are pulled back towards light.
+		 * Casters between light and bounding sphere of slice (ex: tall buildings outside of it) are clipped
+		 * by near plane otherwise and their shadows disappear from cascade. Use distance from sphere to
+		 * scene bounds, or 0.f with depth clamping (GL_DEPTH_CLAMP / depthClampEnable) enabled.
+		 */
+		static void compute(const mat4& cameraInverseView, float fov, float aspectRatio, float near, float far,
+			vec3 lightDirection, float lambda, float resolution, cascade* out, size_t count, bool zeroToOne = false,
+			float casterExtension = 0.f);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_SHADOWCASCADES_H
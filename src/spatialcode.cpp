@@ -0,0 +1,531 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "spatialcode.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "aabb.h"
+#include "parallel.h"
+#include "instrumentation.h"
+
+#if MARMATH_SIMD_SSE
+	#include <emmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	// Spreads 10 bits, so that there are 2 zero bits between every bit.
+	static uint32_t spreadBy2(uint32_t x) {
+		x &= 0x000003FF;
+		x = (x | (x << 16)) & 0x030000FF;
+		x = (x | (x << 8)) & 0x0300F00F;
+		x = (x | (x << 4)) & 0x030C30C3;
+		x = (x | (x << 2)) & 0x09249249;
+		return x;
+	}
+
+	static uint32_t compactBy2(uint32_t x) {
+		x &= 0x09249249;
+		x = (x ^ (x >> 2)) & 0x030C30C3;
+		x = (x ^ (x >> 4)) & 0x0300F00F;
+		x = (x ^ (x >> 8)) & 0x030000FF;
+		x = (x ^ (x >> 16)) & 0x000003FF;
+		return x;
+	}
+
+	// Spreads 21 bits, so that there are 2 zero bits between every bit.
+	static uint64_t spreadBy2(uint64_t x) {
+		x &= 0x00000000001FFFFFull;
+		x = (x | (x << 32)) & 0x001F00000000FFFFull;
+		x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+		x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+		x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+		x = (x | (x << 2)) & 0x1249249249249249ull;
+		return x;
+	}
+
+	static uint64_t compactBy2(uint64_t x) {
+		x &= 0x1249249249249249ull;
+		x = (x ^ (x >> 2)) & 0x10C30C30C30C30C3ull;
+		x = (x ^ (x >> 4)) & 0x100F00F00F00F00Full;
+		x = (x ^ (x >> 8)) & 0x001F0000FF0000FFull;
+		x = (x ^ (x >> 16)) & 0x001F00000000FFFFull;
+		x = (x ^ (x >> 32)) & 0x00000000001FFFFFull;
+		return x;
+	}
+
+	// Spreads 16 bits, so that there is 1 zero bit between every bit.
+	static uint32_t spreadBy1(uint32_t x) {
+		x &= 0x0000FFFF;
+		x = (x | (x << 8)) & 0x00FF00FF;
+		x = (x | (x << 4)) & 0x0F0F0F0F;
+		x = (x | (x << 2)) & 0x33333333;
+		x = (x | (x << 1)) & 0x55555555;
+		return x;
+	}
+
+	static uint32_t compactBy1(uint32_t x) {
+		x &= 0x55555555;
+		x = (x ^ (x >> 1)) & 0x33333333;
+		x = (x ^ (x >> 2)) & 0x0F0F0F0F;
+		x = (x ^ (x >> 4)) & 0x00FF00FF;
+		x = (x ^ (x >> 8)) & 0x0000FFFF;
+		return x;
+	}
+
+	// Spreads 32 bits, so that there is 1 zero bit between every bit.
+	static uint64_t spreadBy1(uint64_t x) {
+		x &= 0x00000000FFFFFFFFull;
+		x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+		x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+		x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		x = (x | (x << 2)) & 0x3333333333333333ull;
+		x = (x | (x << 1)) & 0x5555555555555555ull;
+		return x;
+	}
+
+	static uint64_t compactBy1(uint64_t x) {
+		x &= 0x5555555555555555ull;
+		x = (x ^ (x >> 1)) & 0x3333333333333333ull;
+		x = (x ^ (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+		x = (x ^ (x >> 4)) & 0x00FF00FF00FF00FFull;
+		x = (x ^ (x >> 8)) & 0x0000FFFF0000FFFFull;
+		x = (x ^ (x >> 16)) & 0x00000000FFFFFFFFull;
+		return x;
+	}
+
+	uint32_t spatialCode::morton30(uint32_t x, uint32_t y, uint32_t z) {
+		return (spreadBy2(x) << 2) | (spreadBy2(y) << 1) | spreadBy2(z);
+	}
+
+	uint64_t spatialCode::morton63(uint32_t x, uint32_t y, uint32_t z) {
+		return (spreadBy2((uint64_t)x) << 2) | (spreadBy2((uint64_t)y) << 1) | spreadBy2((uint64_t)z);
+	}
+
+	uint32_t spatialCode::morton32(uint32_t x, uint32_t y) {
+		return (spreadBy1(x) << 1) | spreadBy1(y);
+	}
+
+	uint64_t spatialCode::morton64(uint32_t x, uint32_t y) {
+		return (spreadBy1((uint64_t)x) << 1) | spreadBy1((uint64_t)y);
+	}
+
+	void spatialCode::decodeMorton30(uint32_t code, uint32_t& x, uint32_t& y, uint32_t& z) {
+		x = compactBy2(code >> 2);
+		y = compactBy2(code >> 1);
+		z = compactBy2(code);
+	}
+
+	void spatialCode::decodeMorton63(uint64_t code, uint32_t& x, uint32_t& y, uint32_t& z) {
+		x = (uint32_t)compactBy2(code >> 2);
+		y = (uint32_t)compactBy2(code >> 1);
+		z = (uint32_t)compactBy2(code);
+	}
+
+	void spatialCode::decodeMorton32(uint32_t code, uint32_t& x, uint32_t& y) {
+		x = compactBy1(code >> 1);
+		y = compactBy1(code);
+	}
+
+	void spatialCode::decodeMorton64(uint64_t code, uint32_t& x, uint32_t& y) {
+		x = (uint32_t)compactBy1(code >> 1);
+		y = (uint32_t)compactBy1(code);
+	}
+
+	// J. Skilling, "Programming the Hilbert curve". Cell coordinates are turned in place into
+	// "transposed" Hilbert index, interleaving its bits (X[0] most significant) gives the index.
+	template<size_t N>
+	static void axesToTranspose(uint32_t(&X)[N], uint32_t bits) {
+		const uint32_t M{ 1u << (bits - 1) };
+		for (uint32_t Q = M; Q > 1; Q >>= 1) {
+			const uint32_t P{ Q - 1 };
+			for (size_t i = 0; i < N; i++) {
+				if (X[i] & Q) {
+					X[0] ^= P;
+				}
+				else {
+					const uint32_t t{ (X[0] ^ X[i]) & P };
+					X[0] ^= t;
+					X[i] ^= t;
+				}
+			}
+		}
+
+		for (size_t i = 1; i < N; i++) {
+			X[i] ^= X[i - 1];
+		}
+		uint32_t t{ 0 };
+		for (uint32_t Q = M; Q > 1; Q >>= 1) {
+			if (X[N - 1] & Q) {
+				t ^= Q - 1;
+			}
+		}
+		for (size_t i = 0; i < N; i++) {
+			X[i] ^= t;
+		}
+	}
+
+	template<size_t N>
+	static void transposeToAxes(uint32_t(&X)[N], uint32_t bits) {
+		const uint32_t t{ X[N - 1] >> 1 };
+		for (size_t i = N - 1; i > 0; i--) {
+			X[i] ^= X[i - 1];
+		}
+		X[0] ^= t;
+
+		for (uint32_t bit = 1; bit < bits; bit++) {
+			const uint32_t Q{ 1u << bit };
+			const uint32_t P{ Q - 1 };
+			for (size_t i = N; i-- > 0;) {
+				if (X[i] & Q) {
+					X[0] ^= P;
+				}
+				else {
+					const uint32_t s{ (X[0] ^ X[i]) & P };
+					X[0] ^= s;
+					X[i] ^= s;
+				}
+			}
+		}
+	}
+
+	uint32_t spatialCode::hilbert30(uint32_t x, uint32_t y, uint32_t z) {
+		uint32_t X[3]{ x & 0x3FF, y & 0x3FF, z & 0x3FF };
+		axesToTranspose(X, 10);
+		return morton30(X[0], X[1], X[2]);
+	}
+
+	uint64_t spatialCode::hilbert63(uint32_t x, uint32_t y, uint32_t z) {
+		uint32_t X[3]{ x & 0x1FFFFF, y & 0x1FFFFF, z & 0x1FFFFF };
+		axesToTranspose(X, 21);
+		return morton63(X[0], X[1], X[2]);
+	}
+
+	uint32_t spatialCode::hilbert32(uint32_t x, uint32_t y) {
+		uint32_t X[2]{ x & 0xFFFF, y & 0xFFFF };
+		axesToTranspose(X, 16);
+		return morton32(X[0], X[1]);
+	}
+
+	uint64_t spatialCode::hilbert64(uint32_t x, uint32_t y) {
+		uint32_t X[2]{ x, y };
+		axesToTranspose(X, 32);
+		return morton64(X[0], X[1]);
+	}
+
+	void spatialCode::decodeHilbert30(uint32_t code, uint32_t& x, uint32_t& y, uint32_t& z) {
+		uint32_t X[3];
+		decodeMorton30(code, X[0], X[1], X[2]);
+		transposeToAxes(X, 10);
+		x = X[0];
+		y = X[1];
+		z = X[2];
+	}
+
+	void spatialCode::decodeHilbert63(uint64_t code, uint32_t& x, uint32_t& y, uint32_t& z) {
+		uint32_t X[3];
+		decodeMorton63(code, X[0], X[1], X[2]);
+		transposeToAxes(X, 21);
+		x = X[0];
+		y = X[1];
+		z = X[2];
+	}
+
+	void spatialCode::decodeHilbert32(uint32_t code, uint32_t& x, uint32_t& y) {
+		uint32_t X[2];
+		decodeMorton32(code, X[0], X[1]);
+		transposeToAxes(X, 16);
+		x = X[0];
+		y = X[1];
+	}
+
+	void spatialCode::decodeHilbert64(uint64_t code, uint32_t& x, uint32_t& y) {
+		uint32_t X[2];
+		decodeMorton64(code, X[0], X[1]);
+		transposeToAxes(X, 32);
+		x = X[0];
+		y = X[1];
+	}
+
+	// Maps coordinate to cell. Up to 21 bits float is exact enough, 32 bits need double.
+	// NaN and coordinates below minimum go to cell 0.
+	template<typename TReal>
+	static uint32_t quantize(float value, float minimum, TReal scale, TReal maxCell) {
+		TReal q{ ((TReal)value - (TReal)minimum) * scale };
+		q = q > (TReal)0 ? q : (TReal)0;
+		q = q < maxCell ? q : maxCell;
+		return (uint32_t)q;
+	}
+
+	template<typename TReal>
+	static TReal quantizeScale(float minimum, float maximum, uint32_t bits) {
+		const TReal extent{ (TReal)maximum - (TReal)minimum };
+		return extent > (TReal)0 ? (TReal)((uint64_t)1 << bits) / extent : (TReal)0;
+	}
+
+	template<typename TReal, typename TEncode>
+	static void encode3(const vec3* points, size_t begin, size_t end, const aabb& bounds, uint32_t bits, TEncode encode) {
+		const TReal maxCell{ (TReal)(((uint64_t)1 << bits) - 1) };
+		const TReal scale[3]{
+			quantizeScale<TReal>(bounds.minimum.x, bounds.maximum.x, bits),
+			quantizeScale<TReal>(bounds.minimum.y, bounds.maximum.y, bits),
+			quantizeScale<TReal>(bounds.minimum.z, bounds.maximum.z, bits)
+		};
+		for (size_t i = begin; i < end; i++) {
+			encode(i,
+				quantize(points[i].x, bounds.minimum.x, scale[0], maxCell),
+				quantize(points[i].y, bounds.minimum.y, scale[1], maxCell),
+				quantize(points[i].z, bounds.minimum.z, scale[2], maxCell));
+		}
+	}
+
+	template<typename TReal, typename TEncode>
+	static void encode2(const vec2* points, size_t begin, size_t end, vec2 minimum, vec2 maximum, uint32_t bits, TEncode encode) {
+		const TReal maxCell{ (TReal)(((uint64_t)1 << bits) - 1) };
+		const TReal scale[2]{
+			quantizeScale<TReal>(minimum.x, maximum.x, bits),
+			quantizeScale<TReal>(minimum.y, maximum.y, bits)
+		};
+		for (size_t i = begin; i < end; i++) {
+			encode(i,
+				quantize(points[i].x, minimum.x, scale[0], maxCell),
+				quantize(points[i].y, minimum.y, scale[1], maxCell));
+		}
+	}
+
+	// Maps cell back to coordinate of its center, inverse of quantize for coordinates inside of bounds.
+	template<typename TReal>
+	static float dequantize(uint32_t cell, float minimum, float maximum, uint32_t bits) {
+		const TReal extent{ (TReal)maximum - (TReal)minimum };
+		return (float)((TReal)minimum + ((TReal)cell + (TReal)0.5) * extent / (TReal)((uint64_t)1 << bits));
+	}
+
+	template<typename TReal, typename TCode, typename TDecode>
+	static void decode3(const TCode* codes, size_t begin, size_t end, const aabb& bounds, uint32_t bits, vec3* out, TDecode decode) {
+		for (size_t i = begin; i < end; i++) {
+			uint32_t x, y, z;
+			decode(codes[i], x, y, z);
+			out[i] = {
+				dequantize<TReal>(x, bounds.minimum.x, bounds.maximum.x, bits),
+				dequantize<TReal>(y, bounds.minimum.y, bounds.maximum.y, bits),
+				dequantize<TReal>(z, bounds.minimum.z, bounds.maximum.z, bits)
+			};
+		}
+	}
+
+	template<typename TReal, typename TCode, typename TDecode>
+	static void decode2(const TCode* codes, size_t begin, size_t end, vec2 minimum, vec2 maximum, uint32_t bits, vec2* out, TDecode decode) {
+		for (size_t i = begin; i < end; i++) {
+			uint32_t x, y;
+			decode(codes[i], x, y);
+			out[i] = {
+				dequantize<TReal>(x, minimum.x, maximum.x, bits),
+				dequantize<TReal>(y, minimum.y, maximum.y, bits)
+			};
+		}
+	}
+
+#if MARMATH_SIMD_SSE
+	static __m128i spreadBy2SSE(__m128i x) {
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 16)), _mm_set1_epi32(0x030000FF));
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 8)), _mm_set1_epi32(0x0300F00F));
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 4)), _mm_set1_epi32(0x030C30C3));
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 2)), _mm_set1_epi32(0x09249249));
+		return x;
+	}
+
+	static __m128i spreadBy1SSE(__m128i x) {
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 8)), _mm_set1_epi32(0x00FF00FF));
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 4)), _mm_set1_epi32(0x0F0F0F0F));
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 2)), _mm_set1_epi32(0x33333333));
+		x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, 1)), _mm_set1_epi32(0x55555555));
+		return x;
+	}
+
+	// Same as quantize<float>, max returns 0 for NaN, because NaN is its first operand.
+	static __m128i quantizeSSE(__m128 value, __m128 minimum, __m128 scale, __m128 maxCell) {
+		const __m128 q{ _mm_mul_ps(_mm_sub_ps(value, minimum), scale) };
+		return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(q, _mm_setzero_ps()), maxCell));
+	}
+#endif
+
+	void spatialCode::morton30Many(const vec3* points, size_t count, const aabb& bounds, uint32_t* out) {
+		MARMATH_PROBE(SpatialCodeMorton30Many, count);
+		parallel::forEach(count, [points, &bounds, out](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			const __m128 maxCell{ _mm_set1_ps(1023.f) };
+			const __m128 minX{ _mm_set1_ps(bounds.minimum.x) };
+			const __m128 minY{ _mm_set1_ps(bounds.minimum.y) };
+			const __m128 minZ{ _mm_set1_ps(bounds.minimum.z) };
+			const __m128 scaleX{ _mm_set1_ps(quantizeScale<float>(bounds.minimum.x, bounds.maximum.x, 10)) };
+			const __m128 scaleY{ _mm_set1_ps(quantizeScale<float>(bounds.minimum.y, bounds.maximum.y, 10)) };
+			const __m128 scaleZ{ _mm_set1_ps(quantizeScale<float>(bounds.minimum.z, bounds.maximum.z, 10)) };
+			for (; i + 4 <= end; i += 4) {
+				// 4 vec3's are 3 registers: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3, transpose them to x / y / z.
+				const float* p{ &points[i].x };
+				const __m128 a{ _mm_loadu_ps(p + 0) };
+				const __m128 b{ _mm_loadu_ps(p + 4) };
+				const __m128 c{ _mm_loadu_ps(p + 8) };
+				const __m128 x{ _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0)) };
+				const __m128 y{ _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)) };
+				const __m128 z{ _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)) };
+				const __m128i sx{ spreadBy2SSE(quantizeSSE(x, minX, scaleX, maxCell)) };
+				const __m128i sy{ spreadBy2SSE(quantizeSSE(y, minY, scaleY, maxCell)) };
+				const __m128i sz{ spreadBy2SSE(quantizeSSE(z, minZ, scaleZ, maxCell)) };
+				const __m128i code{ _mm_or_si128(_mm_or_si128(_mm_slli_epi32(sx, 2), _mm_slli_epi32(sy, 1)), sz) };
+				_mm_storeu_si128((__m128i*)(out + i), code);
+			}
+#endif
+			encode3<float>(points, i, end, bounds, 10, [out](size_t index, uint32_t x, uint32_t y, uint32_t z) {
+				out[index] = morton30(x, y, z);
+			});
+		});
+	}
+
+	void spatialCode::morton63Many(const vec3* points, size_t count, const aabb& bounds, uint64_t* out) {
+		parallel::forEach(count, [points, &bounds, out](size_t begin, size_t end) {
+			encode3<float>(points, begin, end, bounds, 21, [out](size_t index, uint32_t x, uint32_t y, uint32_t z) {
+				out[index] = morton63(x, y, z);
+			});
+		});
+	}
+
+	void spatialCode::hilbert30Many(const vec3* points, size_t count, const aabb& bounds, uint32_t* out) {
+		parallel::forEach(count, [points, &bounds, out](size_t begin, size_t end) {
+			encode3<float>(points, begin, end, bounds, 10, [out](size_t index, uint32_t x, uint32_t y, uint32_t z) {
+				out[index] = hilbert30(x, y, z);
+			});
+		});
+	}
+
+	void spatialCode::hilbert63Many(const vec3* points, size_t count, const aabb& bounds, uint64_t* out) {
+		parallel::forEach(count, [points, &bounds, out](size_t begin, size_t end) {
+			encode3<float>(points, begin, end, bounds, 21, [out](size_t index, uint32_t x, uint32_t y, uint32_t z) {
+				out[index] = hilbert63(x, y, z);
+			});
+		});
+	}
+
+	void spatialCode::morton32Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint32_t* out) {
+		parallel::forEach(count, [points, minimum, maximum, out](size_t begin, size_t end) {
+			size_t i{ begin };
+#if MARMATH_SIMD_SSE
+			const __m128 maxCell{ _mm_set1_ps(65535.f) };
+			const __m128 minX{ _mm_set1_ps(minimum.x) };
+			const __m128 minY{ _mm_set1_ps(minimum.y) };
+			const __m128 scaleX{ _mm_set1_ps(quantizeScale<float>(minimum.x, maximum.x, 16)) };
+			const __m128 scaleY{ _mm_set1_ps(quantizeScale<float>(minimum.y, maximum.y, 16)) };
+			for (; i + 4 <= end; i += 4) {
+				const float* p{ &points[i].x };
+				const __m128 a{ _mm_loadu_ps(p + 0) };
+				const __m128 b{ _mm_loadu_ps(p + 4) };
+				const __m128 x{ _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)) };
+				const __m128 y{ _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)) };
+				const __m128i sx{ spreadBy1SSE(quantizeSSE(x, minX, scaleX, maxCell)) };
+				const __m128i sy{ spreadBy1SSE(quantizeSSE(y, minY, scaleY, maxCell)) };
+				_mm_storeu_si128((__m128i*)(out + i), _mm_or_si128(_mm_slli_epi32(sx, 1), sy));
+			}
+#endif
+			encode2<float>(points, i, end, minimum, maximum, 16, [out](size_t index, uint32_t x, uint32_t y) {
+				out[index] = morton32(x, y);
+			});
+		});
+	}
+
+	void spatialCode::morton64Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint64_t* out) {
+		parallel::forEach(count, [points, minimum, maximum, out](size_t begin, size_t end) {
+			encode2<double>(points, begin, end, minimum, maximum, 32, [out](size_t index, uint32_t x, uint32_t y) {
+				out[index] = morton64(x, y);
+			});
+		});
+	}
+
+	void spatialCode::hilbert32Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint32_t* out) {
+		parallel::forEach(count, [points, minimum, maximum, out](size_t begin, size_t end) {
+			encode2<float>(points, begin, end, minimum, maximum, 16, [out](size_t index, uint32_t x, uint32_t y) {
+				out[index] = hilbert32(x, y);
+			});
+		});
+	}
+
+	void spatialCode::hilbert64Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint64_t* out) {
+		parallel::forEach(count, [points, minimum, maximum, out](size_t begin, size_t end) {
+			encode2<double>(points, begin, end, minimum, maximum, 32, [out](size_t index, uint32_t x, uint32_t y) {
+				out[index] = hilbert64(x, y);
+			});
+		});
+	}
+
+	void spatialCode::decodeMorton30Many(const uint32_t* codes, size_t count, const aabb& bounds, vec3* out) {
+		parallel::forEach(count, [codes, &bounds, out](size_t begin, size_t end) {
+			decode3<float>(codes, begin, end, bounds, 10, out, decodeMorton30);
+		});
+	}
+
+	void spatialCode::decodeMorton63Many(const uint64_t* codes, size_t count, const aabb& bounds, vec3* out) {
+		parallel::forEach(count, [codes, &bounds, out](size_t begin, size_t end) {
+			decode3<float>(codes, begin, end, bounds, 21, out, decodeMorton63);
+		});
+	}
+
+	void spatialCode::decodeHilbert30Many(const uint32_t* codes, size_t count, const aabb& bounds, vec3* out) {
+		parallel::forEach(count, [codes, &bounds, out](size_t begin, size_t end) {
+			decode3<float>(codes, begin, end, bounds, 10, out, decodeHilbert30);
+		});
+	}
+
+	void spatialCode::decodeHilbert63Many(const uint64_t* codes, size_t count, const aabb& bounds, vec3* out) {
+		parallel::forEach(count, [codes, &bounds, out](size_t begin, size_t end) {
+			decode3<float>(codes, begin, end, bounds, 21, out, decodeHilbert63);
+		});
+	}
+
+	void spatialCode::decodeMorton32Many(const uint32_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out) {
+		parallel::forEach(count, [codes, minimum, maximum, out](size_t begin, size_t end) {
+			decode2<float>(codes, begin, end, minimum, maximum, 16, out, decodeMorton32);
+		});
+	}
+
+	void spatialCode::decodeMorton64Many(const uint64_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out) {
+		parallel::forEach(count, [codes, minimum, maximum, out](size_t begin, size_t end) {
+			decode2<double>(codes, begin, end, minimum, maximum, 32, out, decodeMorton64);
+		});
+	}
+
+	void spatialCode::decodeHilbert32Many(const uint32_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out) {
+		parallel::forEach(count, [codes, minimum, maximum, out](size_t begin, size_t end) {
+			decode2<float>(codes, begin, end, minimum, maximum, 16, out, decodeHilbert32);
+		});
+	}
+
+	void spatialCode::decodeHilbert64Many(const uint64_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out) {
+		parallel::forEach(count, [codes, minimum, maximum, out](size_t begin, size_t end) {
+			decode2<double>(codes, begin, end, minimum, maximum, 32, out, decodeHilbert64);
+		});
+	}
+
+
+}
@@ -0,0 +1,349 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_SPATIALCODE_H
+#define MAR_MATH_SPATIALCODE_H
+
+
+#include "maths.h"
+#include <cstdint>
+
+
+namespace marengine::maths {
+
+	struct vec2;
+	struct vec3;
+	struct aabb;
+
+
+	/**
+	 * \struct spatialCode spatialcode.h "spatialcode.h"
+	 * \brief Morton (Z-order) and Hilbert codes of 2D / 3D cells. Sorting objects by code places
+	 * objects close in space close in memory (radixSort), which is also the first step of LBVH
+	 * construction. Hilbert order has no jumps between distant cells, Morton order is cheaper.
+	 *
+	 * Integer methods take cell coordinates, x is the most significant axis of every bit group.
+	 * Batch methods quantize points against given bounds first, points outside are clamped.
+	 * 30 bit codes use 10 bits per axis, 63 bit codes 21 bits per axis, 2D codes use 16 or 32
+	 * bits per axis.
+	 */
+	struct spatialCode {
+
+		/**
+		 * \brief Interleaves bits of 3 cells coordinates.
+		 * \param x x cell <0;1023>
+		 * \param y y cell <0;1023>
+		 * \param z z cell <0;1023>
+		 * \return 30 bit Morton code
+		 */
+		static uint32_t morton30(uint32_t x, uint32_t y, uint32_t z);
+
+		/**
+		 * \brief Interleaves bits of 3 cells coordinates.
+		 * \param x x cell <0;2^21)
+		 * \param y y cell <0;2^21)
+		 * \param z z cell <0;2^21)
+		 * \return 63 bit Morton code
+		 */
+		static uint64_t morton63(uint32_t x, uint32_t y, uint32_t z);
+
+		/**
+		 * \brief Interleaves bits of 2 cells coordinates.
+		 * \param x x cell <0;65535>
+		 * \param y y cell <0;65535>
+		 * \return 32 bit Morton code
+		 */
+		static uint32_t morton32(uint32_t x, uint32_t y);
+
+		/**
+		 * \brief Interleaves bits of 2 cells coordinates.
+		 * \param x x cell
+		 * \param y y cell
+		 * \return 64 bit Morton code
+		 */
+		static uint64_t morton64(uint32_t x, uint32_t y);
+
+		/**
+		 * \brief Decodes 30 bit Morton code.
+		 * \param code Morton code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 * \param z reference, to which z cell will be written
+		 */
+		static void decodeMorton30(uint32_t code, uint32_t& x, uint32_t& y, uint32_t& z);
+
+		/**
+		 * \brief Decodes 63 bit Morton code.
+		 * \param code Morton code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 * \param z reference, to which z cell will be written
+		 */
+		static void decodeMorton63(uint64_t code, uint32_t& x, uint32_t& y, uint32_t& z);
+
+		/**
+		 * \brief Decodes 32 bit Morton code.
+		 * \param code Morton code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 */
+		static void decodeMorton32(uint32_t code, uint32_t& x, uint32_t& y);
+
+		/**
+		 * \brief Decodes 64 bit Morton code.
+		 * \param code Morton code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 */
+		static void decodeMorton64(uint64_t code, uint32_t& x, uint32_t& y);
+
+		/**
+		 * \brief Computes index of cell on 3D Hilbert curve of order 10 (Skilling's transform).
+		 * \param x x cell <0;1023>
+		 * \param y y cell <0;1023>
+		 * \param z z cell <0;1023>
+		 * \return 30 bit Hilbert code
+		 */
+		static uint32_t hilbert30(uint32_t x, uint32_t y, uint32_t z);
+
+		/**
+		 * \brief Computes index of cell on 3D Hilbert curve of order 21.
+		 * \param x x cell <0;2^21)
+		 * \param y y cell <0;2^21)
+		 * \param z z cell <0;2^21)
+		 * \return 63 bit Hilbert code
+		 */
+		static uint64_t hilbert63(uint32_t x, uint32_t y, uint32_t z);
+
+		/**
+		 * \brief Computes index of cell on 2D Hilbert curve of order 16.
+		 * \param x x cell <0;65535>
+		 * \param y y cell <0;65535>
+		 * \return 32 bit Hilbert code
+		 */
+		static uint32_t hilbert32(uint32_t x, uint32_t y);
+
+		/**
+		 * \brief Computes index of cell on 2D Hilbert curve of order 32.
+		 * \param x x cell
+		 * \param y y cell
+		 * \return 64 bit Hilbert code
+		 */
+		static uint64_t hilbert64(uint32_t x, uint32_t y);
+
+		/**
+		 * \brief Decodes 30 bit Hilbert code.
+		 * \param code Hilbert code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 * \param z reference, to which z cell will be written
+		 */
+		static void decodeHilbert30(uint32_t code, uint32_t& x, uint32_t& y, uint32_t& z);
+
+		/**
+		 * \brief Decodes 63 bit Hilbert code.
+		 * \param code Hilbert code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 * \param z reference, to which z cell will be written
+		 */
+		static void decodeHilbert63(uint64_t code, uint32_t& x, uint32_t& y, uint32_t& z);
+
+		/**
+		 * \brief Decodes 32 bit Hilbert code.
+		 * \param code Hilbert code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 */
+		static void decodeHilbert32(uint32_t code, uint32_t& x, uint32_t& y);
+
+		/**
+		 * \brief Decodes 64 bit Hilbert code.
+		 * \param code Hilbert code
+		 * \param x reference, to which x cell will be written
+		 * \param y reference, to which y cell will be written
+		 */
+		static void decodeHilbert64(uint64_t code, uint32_t& x, uint32_t& y);
+
+		/**
+		 * \brief Computes 30 bit Morton codes of points quantized against bounds. Four points are
+		 * encoded at once with SIMD, large arrays are split with parallel::forEach.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param bounds box, which is divided into 1024^3 cells
+		 * \param out array, to which count codes will be written
+		 */
+		static void morton30Many(const vec3* points, size_t count, const aabb& bounds, uint32_t* out);
+
+		/**
+		 * \brief Computes 63 bit Morton codes of points quantized against bounds.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param bounds box, which is divided into 2^21^3 cells
+		 * \param out array, to which count codes will be written
+		 */
+		static void morton63Many(const vec3* points, size_t count, const aabb& bounds, uint64_t* out);
+
+		/**
+		 * \brief Computes 30 bit Hilbert codes of points quantized against bounds.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param bounds box, which is divided into 1024^3 cells
+		 * \param out array, to which count codes will be written
+		 */
+		static void hilbert30Many(const vec3* points, size_t count, const aabb& bounds, uint32_t* out);
+
+		/**
+		 * \brief Computes 63 bit Hilbert codes of points quantized against bounds.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param bounds box, which is divided into 2^21^3 cells
+		 * \param out array, to which count codes will be written
+		 */
+		static void hilbert63Many(const vec3* points, size_t count, const aabb& bounds, uint64_t* out);
+
+		/**
+		 * \brief Computes 32 bit Morton codes of 2D points quantized against bounds. Four points
+		 * are encoded at once with SIMD, large arrays are split with parallel::forEach.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count codes will be written
+		 */
+		static void morton32Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint32_t* out);
+
+		/**
+		 * \brief Computes 64 bit Morton codes of 2D points quantized against bounds.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count codes will be written
+		 */
+		static void morton64Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint64_t* out);
+
+		/**
+		 * \brief Computes 32 bit Hilbert codes of 2D points quantized against bounds.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count codes will be written
+		 */
+		static void hilbert32Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint32_t* out);
+
+		/**
+		 * \brief Computes 64 bit Hilbert codes of 2D points quantized against bounds.
+		 * \param points array of points
+		 * \param count count of points
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count codes will be written
+		 */
+		static void hilbert64Many(const vec2* points, size_t count, vec2 minimum, vec2 maximum, uint64_t* out);
+
+		/**
+		 * \brief Decodes 30 bit Morton codes to centers of their cells inside of bounds, inverse of morton30Many. Decoders are scalar
+		 * (bit compaction is cheap next to memory traffic), large arrays are split with parallel::forEach.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param bounds box, which is divided into 1024^3 cells (the same as used for encoding)
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeMorton30Many(const uint32_t* codes, size_t count, const aabb& bounds, vec3* out);
+
+		/**
+		 * \brief Decodes 63 bit Morton codes to centers of their cells inside of bounds, inverse of morton63Many.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param bounds box, which is divided into 2^21^3 cells (the same as used for encoding)
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeMorton63Many(const uint64_t* codes, size_t count, const aabb& bounds, vec3* out);
+
+		/**
+		 * \brief Decodes 30 bit Hilbert codes to centers of their cells inside of bounds, inverse of hilbert30Many.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param bounds box, which is divided into 1024^3 cells (the same as used for encoding)
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeHilbert30Many(const uint32_t* codes, size_t count, const aabb& bounds, vec3* out);
+
+		/**
+		 * \brief Decodes 63 bit Hilbert codes to centers of their cells inside of bounds, inverse of hilbert63Many.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param bounds box, which is divided into 2^21^3 cells (the same as used for encoding)
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeHilbert63Many(const uint64_t* codes, size_t count, const aabb& bounds, vec3* out);
+
+		/**
+		 * \brief Decodes 32 bit Morton codes to centers of their 2D cells inside of bounds, inverse of morton32Many.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeMorton32Many(const uint32_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out);
+
+		/**
+		 * \brief Decodes 64 bit Morton codes to centers of their 2D cells inside of bounds, inverse of morton64Many.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeMorton64Many(const uint64_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out);
+
+		/**
+		 * \brief Decodes 32 bit Hilbert codes to centers of their 2D cells inside of bounds, inverse of hilbert32Many.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeHilbert32Many(const uint32_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out);
+
+		/**
+		 * \brief Decodes 64 bit Hilbert codes to centers of their 2D cells inside of bounds, inverse of hilbert64Many.
+		 * \param codes array of codes
+		 * \param count count of codes
+		 * \param minimum corner of bounds with the smallest coordinates
+		 * \param maximum corner of bounds with the largest coordinates
+		 * \param out array, to which count points will be written
+		 */
+		static void decodeHilbert64Many(const uint64_t* codes, size_t count, vec2 minimum, vec2 maximum, vec2* out);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_SPATIALCODE_H
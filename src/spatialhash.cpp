@@ -0,0 +1,255 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "spatialhash.h"
+#include "parallel.h"
+#include "kernels.h"
+#include "instrumentation.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace marengine::maths {
+
+
+	// Queries are heavier than element-wise batch methods, so they use smaller chunks.
+	static constexpr size_t g_queryElementCost{ 16 };
+
+	static int32_t cellOf(float coordinate, float inverseCellSize) {
+		return (int32_t)std::floor(coordinate * inverseCellSize);
+	}
+
+	spatialHash::spatialHash(float cellSize) :
+		m_cellSize(cellSize),
+		m_inverseCellSize(1.f / cellSize),
+		m_bucketMask(0)
+	{}
+
+	uint32_t spatialHash::bucket(int32_t x, int32_t y, int32_t z) const {
+		return (((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u) ^ ((uint32_t)z * 83492791u)) & m_bucketMask;
+	}
+
+	void spatialHash::build(const vec3* points, size_t count) {
+		MARMATH_PROBE(SpatialHashBuild, count);
+		size_t bucketCount{ 64 };
+		while (bucketCount < count) {
+			bucketCount *= 2;
+		}
+		if (m_bucketStart.size() != bucketCount + 1) {
+			m_bucketStart = std::vector<std::atomic<uint32_t>>(bucketCount + 1);
+		}
+		m_bucketMask = (uint32_t)(bucketCount - 1);
+		m_buckets.resize(count);
+		m_indices.resize(count);
+		m_positions.resize(count);
+
+		parallel::forEach(bucketCount + 1, [this](size_t begin, size_t end) {
+			for (size_t b = begin; b < end; b++) {
+				m_bucketStart[b].store(0, std::memory_order_relaxed);
+			}
+		});
+
+		// Counting sort: count points per bucket, turn counts into bucket ends, then every point
+		// takes slot by decrementing end of its bucket, which leaves start of every bucket.
+		parallel::forEach(count, [this, points](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const uint32_t b{ bucket(
+					cellOf(points[i].x, m_inverseCellSize),
+					cellOf(points[i].y, m_inverseCellSize),
+					cellOf(points[i].z, m_inverseCellSize)) };
+				m_buckets[i] = b;
+				m_bucketStart[b].fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+
+		uint32_t running{ 0 };
+		for (size_t b = 0; b < bucketCount; b++) {
+			running += m_bucketStart[b].load(std::memory_order_relaxed);
+			m_bucketStart[b].store(running, std::memory_order_relaxed);
+		}
+		m_bucketStart[bucketCount].store(running, std::memory_order_relaxed);
+
+		parallel::forEach(count, [this](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const uint32_t slot{ m_bucketStart[m_buckets[i]].fetch_sub(1, std::memory_order_relaxed) - 1 };
+				m_indices[slot] = (uint32_t)i;
+			}
+		});
+
+		// Order inside of bucket depends on thread timing, sort it to keep queries deterministic.
+		// Buckets hold about one point on average, insertion sort is enough.
+		parallel::forEach(bucketCount, [this](size_t begin, size_t end) {
+			for (size_t b = begin; b < end; b++) {
+				uint32_t* first{ m_indices.data() + m_bucketStart[b].load(std::memory_order_relaxed) };
+				uint32_t* last{ m_indices.data() + m_bucketStart[b + 1].load(std::memory_order_relaxed) };
+				for (uint32_t* i = first + 1; i < last; i++) {
+					const uint32_t value{ *i };
+					uint32_t* j{ i };
+					for (; j > first && *(j - 1) > value; j--) {
+						*j = *(j - 1);
+					}
+					*j = value;
+				}
+			}
+		});
+
+		parallel::forEach(count, [this, points](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				m_positions[i] = points[m_indices[i]];
+			}
+		});
+	}
+
+	template<typename TFunction>
+	void spatialHash::forEachInRadius(vec3 center, float radius, TFunction function) const {
+		if (m_positions.empty()) {
+			return;
+		}
+
+		const float radiusSquared{ radius * radius };
+		const float lower[3]{
+			std::floor((center.x - radius) * m_inverseCellSize),
+			std::floor((center.y - radius) * m_inverseCellSize),
+			std::floor((center.z - radius) * m_inverseCellSize)
+		};
+		const float upper[3]{
+			std::floor((center.x + radius) * m_inverseCellSize),
+			std::floor((center.y + radius) * m_inverseCellSize),
+			std::floor((center.z + radius) * m_inverseCellSize)
+		};
+		const float cellCount{ (upper[0] - lower[0] + 1.f) * (upper[1] - lower[1] + 1.f) * (upper[2] - lower[2] + 1.f) };
+
+		// Query covering more cells than there are buckets is cheaper as scan of every point.
+		if (!(cellCount <= (float)(m_bucketMask + 1))) {
+			for (size_t i = 0; i < m_positions.size(); i++) {
+				const vec3 d{ m_positions[i] - center };
+				const float distanceSquared{ d.x * d.x + d.y * d.y + d.z * d.z };
+				if (distanceSquared <= radiusSquared) {
+					function(m_indices[i], distanceSquared);
+				}
+			}
+			return;
+		}
+
+		for (int32_t z = (int32_t)lower[2]; z <= (int32_t)upper[2]; z++) {
+			for (int32_t y = (int32_t)lower[1]; y <= (int32_t)upper[1]; y++) {
+				for (int32_t x = (int32_t)lower[0]; x <= (int32_t)upper[0]; x++) {
+					const uint32_t b{ bucket(x, y, z) };
+					const uint32_t begin{ m_bucketStart[b].load(std::memory_order_relaxed) };
+					const uint32_t end{ m_bucketStart[b + 1].load(std::memory_order_relaxed) };
+					for (uint32_t i = begin; i < end; i++) {
+						const vec3 p{ m_positions[i] };
+						const vec3 d{ p - center };
+						const float distanceSquared{ d.x * d.x + d.y * d.y + d.z * d.z };
+						// Different cells may share bucket, point is reported only from its own cell.
+						if (distanceSquared <= radiusSquared &&
+							cellOf(p.x, m_inverseCellSize) == x &&
+							cellOf(p.y, m_inverseCellSize) == y &&
+							cellOf(p.z, m_inverseCellSize) == z) {
+							function(m_indices[i], distanceSquared);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	size_t spatialHash::queryRadius(vec3 center, float radius, uint32_t* out, size_t capacity) const {
+		size_t found{ 0 };
+		forEachInRadius(center, radius, [&found, out, capacity](uint32_t index, float) {
+			if (found < capacity) {
+				out[found] = index;
+			}
+			found++;
+		});
+		return found;
+	}
+
+	void spatialHash::queryRadiusMany(const vec3* centers, size_t count, float radius, std::vector<uint32_t>& offsets,
+		std::vector<uint32_t>& neighbors) const
+	{
+		MARMATH_PROBE(SpatialHashQueryRadiusMany, count);
+		kernels::gatherMany(count, parallel::grainSize(g_queryElementCost), offsets, neighbors, [this, centers, radius](size_t i, std::vector<uint32_t>& found) {
+			forEachInRadius(centers[i], radius, [&found](uint32_t index, float) {
+				found.push_back(index);
+			});
+		});
+	}
+
+	size_t spatialHash::nearest(vec3 center, size_t k, float maxRadius, std::vector<candidate>& scratch, uint32_t* out) const {
+		if (k == 0) {
+			return 0;
+		}
+
+		// If at least k points lie within radius, k nearest of them are k nearest overall,
+		// otherwise radius is doubled.
+		float radius{ m_cellSize < maxRadius ? m_cellSize : maxRadius };
+		while (true) {
+			scratch.clear();
+			forEachInRadius(center, radius, [&scratch](uint32_t index, float distanceSquared) {
+				scratch.push_back({ distanceSquared, index });
+			});
+			if (scratch.size() >= k || radius >= maxRadius) {
+				break;
+			}
+			radius = 2.f * radius < maxRadius ? 2.f * radius : maxRadius;
+		}
+
+		const size_t found{ scratch.size() < k ? scratch.size() : k };
+		std::partial_sort(scratch.begin(), scratch.begin() + found, scratch.end(), [](const candidate& left, const candidate& right) {
+			return left.distanceSquared < right.distanceSquared || (left.distanceSquared == right.distanceSquared && left.index < right.index);
+		});
+		for (size_t i = 0; i < found; i++) {
+			out[i] = scratch[i].index;
+		}
+		return found;
+	}
+
+	size_t spatialHash::queryNearest(vec3 center, size_t k, float maxRadius, uint32_t* out) const {
+		std::vector<candidate> scratch;
+		return nearest(center, k, maxRadius, scratch, out);
+	}
+
+	void spatialHash::queryNearestMany(const vec3* centers, size_t count, size_t k, float maxRadius, uint32_t* out) const {
+		MARMATH_PROBE(SpatialHashQueryNearestMany, count);
+		parallel::forEach(count, parallel::grainSize(g_queryElementCost), [this, centers, k, maxRadius, out](size_t begin, size_t end) {
+			std::vector<candidate> scratch;
+			for (size_t i = begin; i < end; i++) {
+				const size_t found{ nearest(centers[i], k, maxRadius, scratch, out + i * k) };
+				for (size_t j = found; j < k; j++) {
+					out[i * k + j] = invalid;
+				}
+			}
+		});
+	}
+
+	float spatialHash::cellSize() const {
+		return m_cellSize;
+	}
+
+	size_t spatialHash::size() const {
+		return m_positions.size();
+	}
+
+
+}
@@ -0,0 +1,151 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_SPATIALHASH_H
+#define MAR_MATH_SPATIALHASH_H
+
+
+#include "maths.h"
+#include "vec3.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct spatialHash spatialhash.h "spatialhash.h"
+	 * \brief Uniform grid over vec3 points, where infinite grid cells are hashed into table of
+	 * power of two buckets. build() computes buckets in parallel and sorts points by bucket with
+	 * counting sort, so every bucket is a [start;end) range of one index array and points are
+	 * copied in that order for cache-friendly queries. Storage is reused between builds, there are
+	 * no allocations per cell, rebuild every tick is intended.
+	 *
+	 * Cell size should be close to the usual query radius. Queries return indices of points as
+	 * given to build(), results are deterministic regardless of thread count.
+	 */
+	struct spatialHash {
+
+		/// \brief Returned by queryNearestMany in place of missing neighbours.
+		static constexpr uint32_t invalid{ 0xFFFFFFFF };
+
+
+		/**
+		 * \brief Constructor, creates empty grid.
+		 * \param cellSize edge length of grid cell
+		 */
+		explicit spatialHash(float cellSize);
+
+		/**
+		 * \brief Rebuilds grid from given points. Table has at least as many buckets as points.
+		 * Large arrays are processed on parallel pool.
+		 * \param points array of points, which are copied (array doesn't have to outlive grid)
+		 * \param count count of points, must be less than 2^32 - 1
+		 */
+		void build(const vec3* points, size_t count);
+
+		/**
+		 * \brief Finds every point within radius (boundary included) of center.
+		 * \param center center of query
+		 * \param radius radius of query
+		 * \param out array, to which at most capacity indices will be written
+		 * \param capacity size of out array
+		 * \return count of found points, may be greater than capacity
+		 */
+		size_t queryRadius(vec3 center, float radius, uint32_t* out, size_t capacity) const;
+
+		/**
+		 * \brief Runs radius query for every center on parallel pool. Result is compressed, neighbours
+		 * of centers[i] are neighbors[offsets[i]] ... neighbors[offsets[i + 1] - 1].
+		 * \param centers array of query centers
+		 * \param count count of centers
+		 * \param radius radius of every query
+		 * \param offsets vector, which is resized to count + 1 offsets
+		 * \param neighbors vector, which is resized to count of all found points
+		 */
+		void queryRadiusMany(const vec3* centers, size_t count, float radius, std::vector<uint32_t>& offsets,
+			std::vector<uint32_t>& neighbors) const;
+
+		/**
+		 * \brief Finds k nearest points to center, search radius grows from cell size up to maxRadius.
+		 * \param center center of query
+		 * \param k count of wanted points
+		 * \param maxRadius points further than maxRadius are ignored
+		 * \param out array, to which at most k indices will be written, sorted from the nearest
+		 * \return count of found points (less than k, if there are not enough points within maxRadius)
+		 */
+		size_t queryNearest(vec3 center, size_t k, float maxRadius, uint32_t* out) const;
+
+		/**
+		 * \brief Runs k nearest query for every center on parallel pool.
+		 * \param centers array of query centers
+		 * \param count count of centers
+		 * \param k count of wanted points
+		 * \param maxRadius points further than maxRadius are ignored
+		 * \param out array of count * k indices, missing neighbours are set to spatialHash::invalid
+		 */
+		void queryNearestMany(const vec3* centers, size_t count, size_t k, float maxRadius, uint32_t* out) const;
+
+		/**
+		 * \brief Returns edge length of grid cell.
+		 * \return cell size
+		 */
+		float cellSize() const;
+
+		/**
+		 * \brief Returns count of points given to last build().
+		 * \return count of points
+		 */
+		size_t size() const;
+
+	private:
+
+		struct candidate {
+			float distanceSquared;
+			uint32_t index;
+		};
+
+		template<typename TFunction>
+		void forEachInRadius(vec3 center, float radius, TFunction function) const;
+
+		size_t nearest(vec3 center, size_t k, float maxRadius, std::vector<candidate>& scratch, uint32_t* out) const;
+
+		uint32_t bucket(int32_t x, int32_t y, int32_t z) const;
+
+		std::vector<std::atomic<uint32_t>> m_bucketStart;
+		std::vector<uint32_t> m_buckets;
+		std::vector<uint32_t> m_indices;
+		std::vector<vec3> m_positions;
+		float m_cellSize;
+		float m_inverseCellSize;
+		uint32_t m_bucketMask;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_SPATIALHASH_H
@@ -0,0 +1,132 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "sprite.h"
+#include "vec2.h"
+#include "rotor2.h"
+#include "affine2.h"
+#include "parallel.h"
+#include "diagnostics.h"
+#include "instrumentation.h"
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	// Bottom-left corner is position + R * (-pivot * scale), other corners are reached by adding
+	// edges R * (scale.x, 0) and R * (0, scale.y). Transform is linear + translation, so corner
+	// is transformed as point and edges as vectors, which is all per-sprite work.
+	void sprite::quadVertices(const affine2& transform, vec2 position, rotor2 rotation, vec2 scale, vec2 pivot, vec2* out) {
+		const vec2 offset{ rotation.rotate({ -pivot.x * scale.x, -pivot.y * scale.y }) };
+		const vec2 corner{ transform.transformPoint(position + offset) };
+		const vec2 edgeX{ transform.transformVector({ rotation.c * scale.x, rotation.s * scale.x }) };
+		const vec2 edgeY{ transform.transformVector({ -rotation.s * scale.y, rotation.c * scale.y }) };
+		out[0] = corner;
+		out[1] = corner + edgeX;
+		out[2] = corner + edgeX + edgeY;
+		out[3] = corner + edgeY;
+	}
+
+	static void quadVerticesRange(const affine2& transform, const spriteArrays& s, vec2* out, size_t begin, size_t end) {
+		size_t i{ begin };
+#if MARMATH_SIMD_SSE
+		const float* t{ transform.elements };
+		const __m128 t0{ _mm_set1_ps(t[0]) };
+		const __m128 t1{ _mm_set1_ps(t[1]) };
+		const __m128 t2{ _mm_set1_ps(t[2]) };
+		const __m128 t3{ _mm_set1_ps(t[3]) };
+		const __m128 t4{ _mm_set1_ps(t[4]) };
+		const __m128 t5{ _mm_set1_ps(t[5]) };
+		for (; i + 4 <= end; i += 4) {
+			const __m128 c{ _mm_loadu_ps(s.rotationC + i) };
+			const __m128 sn{ _mm_loadu_ps(s.rotationS + i) };
+			const __m128 sx{ _mm_loadu_ps(s.scaleX + i) };
+			const __m128 sy{ _mm_loadu_ps(s.scaleY + i) };
+			const __m128 ox{ _mm_mul_ps(_mm_loadu_ps(s.pivotX + i), sx) };
+			const __m128 oy{ _mm_mul_ps(_mm_loadu_ps(s.pivotY + i), sy) };
+
+			// world space corner and edges
+			const __m128 wx{ _mm_sub_ps(_mm_loadu_ps(s.positionX + i), _mm_sub_ps(_mm_mul_ps(c, ox), _mm_mul_ps(sn, oy))) };
+			const __m128 wy{ _mm_sub_ps(_mm_loadu_ps(s.positionY + i), _mm_add_ps(_mm_mul_ps(sn, ox), _mm_mul_ps(c, oy))) };
+			const __m128 exw{ _mm_mul_ps(c, sx) };
+			const __m128 eyw{ _mm_mul_ps(sn, sx) };
+			const __m128 fxw{ _mm_mul_ps(sn, sy) }; // edgeY is (-fxw, fyw)
+			const __m128 fyw{ _mm_mul_ps(c, sy) };
+
+			// transformed corner and edges
+			const __m128 px{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(t0, wx), _mm_mul_ps(t2, wy)), t4) };
+			const __m128 py{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(t1, wx), _mm_mul_ps(t3, wy)), t5) };
+			const __m128 ex{ _mm_add_ps(_mm_mul_ps(t0, exw), _mm_mul_ps(t2, eyw)) };
+			const __m128 ey{ _mm_add_ps(_mm_mul_ps(t1, exw), _mm_mul_ps(t3, eyw)) };
+			const __m128 fx{ _mm_sub_ps(_mm_mul_ps(t2, fyw), _mm_mul_ps(t0, fxw)) };
+			const __m128 fy{ _mm_sub_ps(_mm_mul_ps(t3, fyw), _mm_mul_ps(t1, fxw)) };
+
+			const __m128 x[4]{ px, _mm_add_ps(px, ex), _mm_add_ps(_mm_add_ps(px, ex), fx), _mm_add_ps(px, fx) };
+			const __m128 y[4]{ py, _mm_add_ps(py, ey), _mm_add_ps(_mm_add_ps(py, ey), fy), _mm_add_ps(py, fy) };
+
+			// Interleave x / y, so that every sprite gets its 4 consecutive vertices.
+			const __m128 lo0{ _mm_unpacklo_ps(x[0], y[0]) };
+			const __m128 lo1{ _mm_unpacklo_ps(x[1], y[1]) };
+			const __m128 lo2{ _mm_unpacklo_ps(x[2], y[2]) };
+			const __m128 lo3{ _mm_unpacklo_ps(x[3], y[3]) };
+			const __m128 hi0{ _mm_unpackhi_ps(x[0], y[0]) };
+			const __m128 hi1{ _mm_unpackhi_ps(x[1], y[1]) };
+			const __m128 hi2{ _mm_unpackhi_ps(x[2], y[2]) };
+			const __m128 hi3{ _mm_unpackhi_ps(x[3], y[3]) };
+			float* o{ &out[i * 4].x };
+			_mm_storeu_ps(o + 0, _mm_movelh_ps(lo0, lo1));
+			_mm_storeu_ps(o + 4, _mm_movelh_ps(lo2, lo3));
+			_mm_storeu_ps(o + 8, _mm_movehl_ps(lo1, lo0));
+			_mm_storeu_ps(o + 12, _mm_movehl_ps(lo3, lo2));
+			_mm_storeu_ps(o + 16, _mm_movelh_ps(hi0, hi1));
+			_mm_storeu_ps(o + 20, _mm_movelh_ps(hi2, hi3));
+			_mm_storeu_ps(o + 24, _mm_movehl_ps(hi1, hi0));
+			_mm_storeu_ps(o + 28, _mm_movehl_ps(hi3, hi2));
+		}
+#endif
+		for (; i < end; i++) {
+			sprite::quadVertices(transform,
+				{ s.positionX[i], s.positionY[i] },
+				{ s.rotationC[i], s.rotationS[i] },
+				{ s.scaleX[i], s.scaleY[i] },
+				{ s.pivotX[i], s.pivotY[i] },
+				out + i * 4);
+		}
+	}
+
+	void sprite::quadVerticesMany(const affine2& transform, const spriteArrays& sprites, vec2* out) {
+		MARMATH_PROBE(SpriteQuadVerticesMany, sprites.count);
+		const affine2 t{ transform };
+		const spriteArrays s{ sprites };
+		parallel::forEach(s.count, [&t, &s, out](size_t begin, size_t end) {
+			quadVerticesRange(t, s, out, begin, end);
+			MARMATH_CHECK_FINITE(&out[begin * 4].x, 8 * (end - begin), "sprite::quadVerticesMany");
+		});
+	}
+
+
+}
@@ -0,0 +1,102 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_SPRITE_H
+#define MAR_MATH_SPRITE_H
+
+
+#include "maths.h"
+
+
+namespace marengine::maths {
+
+	struct vec2;
+	struct rotor2;
+	struct affine2;
+
+
+	/**
+	 * \struct spriteArrays sprite.h "sprite.h"
+	 * \brief Structure of arrays view over sprite records, every pointer is array of count floats.
+	 * Rotation is kept as rotor2 lanes (cosine and sine), so that no trigonometry is done per
+	 * frame (update them with rotor2::fromAngle only when angle changes). Size of sprite is its
+	 * scale, pivot is normalized (0, 0 is bottom-left corner, 0.5, 0.5 is center). It doesn't own memory.
+	 */
+	struct spriteArrays {
+		/// \brief x positions of pivots
+		const float* positionX;
+		/// \brief y positions of pivots
+		const float* positionY;
+		/// \brief cosines of rotations (rotor2::c)
+		const float* rotationC;
+		/// \brief sines of rotations (rotor2::s)
+		const float* rotationS;
+		/// \brief widths
+		const float* scaleX;
+		/// \brief heights
+		const float* scaleY;
+		/// \brief normalized x pivots
+		const float* pivotX;
+		/// \brief normalized y pivots
+		const float* pivotY;
+		/// \brief count of sprites
+		size_t count;
+	};
+
+
+	/**
+	 * \struct sprite sprite.h "sprite.h"
+	 * \brief sprite generates quad vertex positions for 2D batcher. Every sprite produces 4 vertices
+	 * in counter-clockwise order: bottom-left, bottom-right, top-right, top-left (for indices
+	 * 0 1 2, 2 3 0). Vertices are transformed by given affine2 (ex: affine2::orthographic of
+	 * screen multiplied with 2D camera), so they can be uploaded directly.
+	 */
+	struct sprite {
+
+		/**
+		 * \brief Computes quad of single sprite.
+		 * \param transform transform applied after sprite transform
+		 * \param position position of pivot
+		 * \param rotation rotation around pivot
+		 * \param scale size of sprite
+		 * \param pivot normalized pivot
+		 * \param out array, to which 4 vertices will be written
+		 */
+		static void quadVertices(const affine2& transform, vec2 position, rotor2 rotation, vec2 scale, vec2 pivot, vec2* out);
+
+		/**
+		 * \brief Computes quads of every sprite in given arrays. Four sprites are processed at once
+		 * with SIMD, large arrays are split with parallel::forEach.
+		 * \param transform transform applied after sprite transform
+		 * \param sprites SoA sprite records
+		 * \param out array, to which 4 * sprites.count vertices will be written
+		 */
+		static void quadVerticesMany(const affine2& transform, const spriteArrays& sprites, vec2* out);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_SPRITE_H
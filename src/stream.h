@@ -0,0 +1,74 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_STREAM_H
+#define MAR_MATH_STREAM_H
+
+
+#include "text.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+#include "quat.h"
+#include "mat4.h"
+#include <ostream>
+
+
+/**
+ * Opt-in std::ostream support. It is not included by MARMaths.h, so that <iostream> is not
+ * pulled into every translation unit. Formatting is done with text::format.
+ */
+
+
+namespace marengine::maths {
+
+
+	namespace detail {
+
+		template<typename T>
+		std::ostream& streamFormatted(std::ostream& stream, const char* name, const T& value) {
+			char buffer[text::maxMat4Length];
+			const char* end{ text::format(buffer, buffer + text::maxMat4Length, value, textStyle::Plain) };
+			stream << name << ": ( ";
+			stream.write(buffer, end - buffer);
+			return stream << " )";
+		}
+
+	}
+
+	/// \brief self-explanatory
+	inline std::ostream& operator<<(std::ostream& stream, const vec2& v) { return detail::streamFormatted(stream, "vec2", v); }
+	/// \brief self-explanatory
+	inline std::ostream& operator<<(std::ostream& stream, const vec3& v) { return detail::streamFormatted(stream, "vec3", v); }
+	/// \brief self-explanatory
+	inline std::ostream& operator<<(std::ostream& stream, const vec4& v) { return detail::streamFormatted(stream, "vec4", v); }
+	/// \brief self-explanatory
+	inline std::ostream& operator<<(std::ostream& stream, const quat& q) { return detail::streamFormatted(stream, "quat", q); }
+	/// \brief self-explanatory
+	inline std::ostream& operator<<(std::ostream& stream, const mat4& m) { return detail::streamFormatted(stream, "mat4", m); }
+
+
+}
+
+
+#endif // !MAR_MATH_STREAM_H
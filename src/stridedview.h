@@ -0,0 +1,224 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_STRIDED_VIEW_H
+#define MAR_MATH_STRIDED_VIEW_H
+
+
+#include "maths.h"
+#include <cstring>
+
+
+namespace marengine::maths {
+
+
+	/**
+	 * \struct stridedView stridedview.h "stridedview.h"
+	 * \brief stridedView is non-owning view of count elements of type T, placed in memory
+	 * every stride bytes starting at base + offset. It allows batch methods to write results
+	 * directly into interleaved buffers (ex: mapped GPU / staging memory with mat4 + color + custom data
+	 * per instance), so that no copy pass is needed between computation and upload.
+	 *
+	 * Elements don't have to be aligned to alignof(T), they are accessed with memcpy.
+	 * Batch methods writing floats require only 4-byte alignment of offset and stride.
+	 *
+	 * \code
+	 *   struct instance { mat4 model; vec4 color; float custom[4]; };
+	 *   stridedView<mat4> models{ mapped, offsetof(instance, model), sizeof(instance), count };
+	 *   mat4::multiplyMany(viewProjection, locals.data(), models);
+	 * \endcode
+	 */
+	template<typename T>
+	struct stridedView {
+
+		/// \brief pointer to first element (base + offset)
+		unsigned char* data;
+		/// \brief distance in bytes between two consecutive elements
+		size_t stride;
+		/// \brief count of elements
+		size_t count;
+
+
+		/// \brief Default constructor, creates empty view.
+		stridedView() :
+			data(nullptr),
+			stride(sizeof(T)),
+			count(0)
+		{}
+
+		/**
+		 * \brief Constructor, that creates view over interleaved buffer.
+		 * \param base pointer to beginning of buffer
+		 * \param offset offset in bytes of first element from base
+		 * \param _stride distance in bytes between two consecutive elements
+		 * \param _count count of elements
+		 */
+		stridedView(void* base, size_t offset, size_t _stride, size_t _count) :
+			data((unsigned char*)base + offset),
+			stride(_stride),
+			count(_count)
+		{}
+
+		/**
+		 * \brief Constructor, that creates view over tightly packed array.
+		 * \param array pointer to first element
+		 * \param _count count of elements
+		 */
+		stridedView(T* array, size_t _count) :
+			data((unsigned char*)array),
+			stride(sizeof(T)),
+			count(_count)
+		{}
+
+		/**
+		 * \brief Returns address of element at index. Make sure, that index is in range <0;count).
+		 * \param index index of element
+		 * \return address of element
+		 */
+		void* address(size_t index) const {
+			return data + index * stride;
+		}
+
+		/**
+		 * \brief Reads element at index. Make sure, that index is in range <0;count).
+		 * \param index index of element
+		 * \return copy of element
+		 */
+		T get(size_t index) const {
+			T rtn;
+			memcpy(&rtn, address(index), sizeof(T));
+			return rtn;
+		}
+
+		/**
+		 * \brief Writes element at index. Make sure, that index is in range <0;count).
+		 * \param index index of element
+		 * \param value value, that will be written
+		 */
+		void set(size_t index, const T& value) const {
+			memcpy(address(index), &value, sizeof(T));
+		}
+
+		/**
+		 * \brief Returns view of count elements starting at begin.
+		 * \param begin index of first element of subview
+		 * \param _count count of elements in subview
+		 * \return subview
+		 */
+		stridedView subview(size_t begin, size_t _count) const {
+			stridedView rtn{ *this };
+			rtn.data = data + begin * stride;
+			rtn.count = _count;
+			return rtn;
+		}
+
+		/**
+		 * \brief Copies tightly packed array to view. Copies min(srcCount, count) elements.
+		 * \param src array of elements
+		 * \param srcCount count of elements in src
+		 */
+		void copyFrom(const T* src, size_t srcCount) const {
+			const size_t n{ srcCount < count ? srcCount : count };
+			if (stride == sizeof(T)) {
+				memcpy(data, src, n * sizeof(T));
+				return;
+			}
+			for (size_t i = 0; i < n; i++) {
+				set(i, src[i]);
+			}
+		}
+
+		/**
+		 * \brief Writes given value to every element of view.
+		 * \param value value, that will be written
+		 */
+		void fill(const T& value) const {
+			for (size_t i = 0; i < count; i++) {
+				set(i, value);
+			}
+		}
+
+	};
+
+
+	/**
+	 * \struct stridedWriter stridedview.h "stridedview.h"
+	 * \brief stridedWriter appends elements one after another to stridedView, ex: when
+	 * filling instance buffer with only visible objects.
+	 */
+	template<typename T>
+	struct stridedWriter {
+
+		/// \brief view, to which elements are written
+		stridedView<T> view;
+		/// \brief count of elements written so far
+		size_t written;
+
+
+		/**
+		 * \brief Constructor, creates writer at the beginning of view.
+		 * \param _view view, to which elements will be written
+		 */
+		explicit stridedWriter(const stridedView<T>& _view) :
+			view(_view),
+			written(0)
+		{}
+
+		/**
+		 * \brief Writes value at next free element.
+		 * \param value value, that will be written
+		 * \return false if view is full and nothing was written
+		 */
+		bool push(const T& value) {
+			if (written >= view.count) {
+				return false;
+			}
+			view.set(written++, value);
+			return true;
+		}
+
+		/**
+		 * \brief Returns view over elements, that are not written yet, so that batch method can
+		 * fill them. Call advance() after that.
+		 * \return view over remaining elements
+		 */
+		stridedView<T> remaining() const {
+			return view.subview(written, view.count - written);
+		}
+
+		/**
+		 * \brief Marks count next elements as written, ex: after batch method filled remaining().
+		 * \param count count of elements (clamped to remaining count)
+		 */
+		void advance(size_t count) {
+			const size_t left{ view.count - written };
+			written += count < left ? count : left;
+		}
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_STRIDED_VIEW_H
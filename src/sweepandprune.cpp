@@ -0,0 +1,235 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "sweepandprune.h"
+#include "aabb.h"
+#include "gjk.h"
+#include "radixsort.h"
+#include "parallel.h"
+#include "instrumentation.h"
+#include <cstring>
+
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+namespace marengine::maths {
+
+
+	static constexpr size_t g_sweepElementCost{ 4 };
+	// Insertion sort gives up and radix sort takes over after this many shifts per box.
+	static constexpr size_t g_maxShiftsPerBox{ 8 };
+	// Sorting axis is changed only, if other axis has this many times larger variance of centers.
+	static constexpr double g_axisHysteresis{ 1.5 };
+
+	static float component(vec3 v, uint32_t axis) {
+		return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+	}
+
+	// Maps float to unsigned integer with the same ordering.
+	static uint32_t sortableKey(float f) {
+		uint32_t bits;
+		std::memcpy(&bits, &f, sizeof(float));
+		return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+	}
+
+	sweepAndPrune::sweepAndPrune() :
+		m_axis(0)
+	{}
+
+	uint32_t sweepAndPrune::selectAxis(const aabb* boxes, size_t count) const {
+		double sum[3]{ 0.0, 0.0, 0.0 };
+		double sumSquared[3]{ 0.0, 0.0, 0.0 };
+		for (size_t i = 0; i < count; i++) {
+			const vec3 center{ (boxes[i].minimum + boxes[i].maximum) * 0.5f };
+			const double c[3]{ center.x, center.y, center.z };
+			for (size_t k = 0; k < 3; k++) {
+				sum[k] += c[k];
+				sumSquared[k] += c[k] * c[k];
+			}
+		}
+
+		double variance[3];
+		uint32_t best{ 0 };
+		for (uint32_t k = 0; k < 3; k++) {
+			variance[k] = sumSquared[k] - sum[k] * sum[k] / (double)(count ? count : 1);
+			best = variance[k] > variance[best] ? k : best;
+		}
+		if (m_order.size() == count && variance[best] < variance[m_axis] * g_axisHysteresis) {
+			return m_axis;
+		}
+		return best;
+	}
+
+	// Sorts previous order by new keys, returns false if boxes moved too much.
+	bool sweepAndPrune::insertionSort(const aabb* boxes, size_t count) {
+		float* keys{ m_keys.data() };
+		uint32_t* order{ m_order.data() };
+		for (size_t i = 0; i < count; i++) {
+			keys[i] = component(boxes[order[i]].minimum, m_axis);
+		}
+
+		const size_t maxShifts{ count * g_maxShiftsPerBox };
+		size_t shifts{ 0 };
+		for (size_t i = 1; i < count; i++) {
+			const float key{ keys[i] };
+			const uint32_t index{ order[i] };
+			size_t j{ i };
+			while (j > 0 && keys[j - 1] > key) {
+				keys[j] = keys[j - 1];
+				order[j] = order[j - 1];
+				j--;
+			}
+			keys[j] = key;
+			order[j] = index;
+			shifts += i - j;
+			if (shifts > maxShifts) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void sweepAndPrune::update(const aabb* boxes, size_t count) {
+		MARMATH_PROBE(SweepAndPruneUpdate, count);
+		const uint32_t axis{ selectAxis(boxes, count) };
+		bool sorted{ count == m_order.size() && axis == m_axis };
+		m_axis = axis;
+		m_order.resize(count);
+		m_keys.resize(count);
+		for (std::vector<float>& lane : m_minimum) {
+			lane.resize(count);
+		}
+		for (std::vector<float>& lane : m_maximum) {
+			lane.resize(count);
+		}
+
+		if (sorted) {
+			sorted = insertionSort(boxes, count);
+		}
+		if (!sorted) {
+			m_radixKeys.resize(count);
+			for (size_t i = 0; i < count; i++) {
+				m_radixKeys[i] = sortableKey(component(boxes[i].minimum, m_axis));
+			}
+			radixSort::sort(m_radixKeys.data(), m_order.data(), count, m_radixBuffers);
+		}
+
+		const uint32_t lanes[3]{ m_axis, (m_axis + 1) % 3, (m_axis + 2) % 3 };
+		parallel::forEach(count, [this, boxes, lanes](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const aabb& box{ boxes[m_order[i]] };
+				for (size_t k = 0; k < 3; k++) {
+					m_minimum[k][i] = component(box.minimum, lanes[k]);
+					m_maximum[k][i] = component(box.maximum, lanes[k]);
+				}
+			}
+		});
+	}
+
+	void sweepAndPrune::sweep(size_t i, std::vector<convexPair>& pairs) const {
+		const size_t count{ m_order.size() };
+		const float* minimum0{ m_minimum[0].data() };
+		const float* minimum1{ m_minimum[1].data() };
+		const float* minimum2{ m_minimum[2].data() };
+		const float* maximum1{ m_maximum[1].data() };
+		const float* maximum2{ m_maximum[2].data() };
+		const float end{ m_maximum[0][i] };
+		const uint32_t index{ m_order[i] };
+		const auto emit = [&pairs, index](uint32_t other) {
+			pairs.push_back(index < other ? convexPair{ index, other } : convexPair{ other, index });
+		};
+
+		size_t j{ i + 1 };
+#if MARMATH_SIMD_SSE
+		const __m128 sweepEnd{ _mm_set1_ps(end) };
+		const __m128 lowest1{ _mm_set1_ps(minimum1[i]) };
+		const __m128 highest1{ _mm_set1_ps(maximum1[i]) };
+		const __m128 lowest2{ _mm_set1_ps(minimum2[i]) };
+		const __m128 highest2{ _mm_set1_ps(maximum2[i]) };
+		for (; j + 4 <= count; j += 4) {
+			const __m128 inSweep{ _mm_cmple_ps(_mm_loadu_ps(minimum0 + j), sweepEnd) };
+			const __m128 overlap1{ _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minimum1 + j), highest1), _mm_cmpge_ps(_mm_loadu_ps(maximum1 + j), lowest1)) };
+			const __m128 overlap2{ _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minimum2 + j), highest2), _mm_cmpge_ps(_mm_loadu_ps(maximum2 + j), lowest2)) };
+			const int mask{ _mm_movemask_ps(_mm_and_ps(inSweep, _mm_and_ps(overlap1, overlap2))) };
+			for (size_t k = 0; k < 4; k++) {
+				if (mask & (1 << k)) {
+					emit(m_order[j + k]);
+				}
+			}
+			if (_mm_movemask_ps(inSweep) != 0xF) {
+				return; // keys are sorted, so the sweep ended inside of this group
+			}
+		}
+#endif
+		for (; j < count && minimum0[j] <= end; j++) {
+			if (minimum1[j] <= maximum1[i] && maximum1[j] >= minimum1[i] && minimum2[j] <= maximum2[i] && maximum2[j] >= minimum2[i]) {
+				emit(m_order[j]);
+			}
+		}
+	}
+
+	size_t sweepAndPrune::findPairs(convexPair* out, size_t capacity) {
+		MARMATH_PROBE(SweepAndPruneFindPairs, m_order.size());
+		const size_t count{ m_order.size() };
+		const size_t grainSize{ parallel::grainSize(g_sweepElementCost) };
+		const size_t chunkCount{ (count + grainSize - 1) / grainSize };
+		if (m_chunkPairs.size() < chunkCount) {
+			// new chunks start with room for pair per box, later ticks reuse grown capacity
+			const size_t previous{ m_chunkPairs.size() };
+			m_chunkPairs.resize(chunkCount);
+			for (size_t chunk = previous; chunk < chunkCount; chunk++) {
+				m_chunkPairs[chunk].reserve(grainSize);
+			}
+		}
+
+		parallel::forEach(count, grainSize, [this, grainSize](size_t begin, size_t end) {
+			std::vector<convexPair>& pairs{ m_chunkPairs[begin / grainSize] };
+			pairs.clear();
+			for (size_t i = begin; i < end; i++) {
+				sweep(i, pairs);
+			}
+		});
+
+		size_t total{ 0 };
+		for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+			const std::vector<convexPair>& pairs{ m_chunkPairs[chunk] };
+			for (size_t k = 0; k < pairs.size() && total + k < capacity; k++) {
+				out[total + k] = pairs[k];
+			}
+			total += pairs.size();
+		}
+		return total;
+	}
+
+	uint32_t sweepAndPrune::axis() const {
+		return m_axis;
+	}
+
+	size_t sweepAndPrune::size() const {
+		return m_order.size();
+	}
+
+
+}
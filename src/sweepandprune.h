@@ -0,0 +1,116 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_SWEEPANDPRUNE_H
+#define MAR_MATH_SWEEPANDPRUNE_H
+
+
+#include "maths.h"
+#include "radixsort.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace marengine::maths {
+
+	struct aabb;
+	struct convexPair;
+
+
+	/**
+	 * \struct sweepAndPrune sweepandprune.h "sweepandprune.h"
+	 * \brief Broadphase, which sorts boxes by minimum along the axis with the largest spread of
+	 * centers and sweeps that list, testing the two remaining axes four boxes at once with SSE.
+	 * Order of previous update() is kept, so for moving bodies it is only fixed by insertion sort,
+	 * which is close to linear thanks to temporal coherence (radix sort is used on first update,
+	 * on axis change and when too many boxes moved). Bounds are kept as SoA arrays in sorted order.
+	 * Storage, radix sort scratch and per-chunk pair lists are reused between updates and only grow,
+	 * so once they have seen the largest count of boxes and pairs, calling update() and findPairs()
+	 * every tick doesn't allocate.
+	 *
+	 * \code
+	 *   broadphase.update(bounds, count);
+	 *   const size_t found{ broadphase.findPairs(pairs.data(), pairs.size()) };
+	 *   gjk::penetrationMany(shapes, pairs.data(), found, results);
+	 * \endcode
+	 */
+	struct sweepAndPrune {
+
+		/// \brief Default constructor, creates empty broadphase.
+		sweepAndPrune();
+
+		/**
+		 * \brief Updates broadphase with current bounds of bodies. Body i keeps index i between
+		 * updates, if count changes, order is rebuilt from scratch.
+		 * \param boxes array of bounds, which are copied (array doesn't have to outlive broadphase)
+		 * \param count count of boxes, must be less than 2^32
+		 */
+		void update(const aabb* boxes, size_t count);
+
+		/**
+		 * \brief Finds every pair of overlapping boxes (touching boxes overlap) on parallel pool.
+		 * In every pair a < b, pairs are in deterministic order regardless of thread count.
+		 * Uses internal buffers, so it must not be called concurrently on the same object.
+		 * \param out array, to which at most capacity pairs will be written
+		 * \param capacity size of out array
+		 * \return count of found pairs, may be greater than capacity (then call again with larger array)
+		 */
+		size_t findPairs(convexPair* out, size_t capacity);
+
+		/**
+		 * \brief Returns axis, along which boxes are sorted.
+		 * \return 0 for x, 1 for y, 2 for z
+		 */
+		uint32_t axis() const;
+
+		/**
+		 * \brief Returns count of boxes given to last update().
+		 * \return count of boxes
+		 */
+		size_t size() const;
+
+	private:
+
+		uint32_t selectAxis(const aabb* boxes, size_t count) const;
+
+		bool insertionSort(const aabb* boxes, size_t count);
+
+		void sweep(size_t index, std::vector<convexPair>& pairs) const;
+
+		std::vector<uint32_t> m_order;
+		std::vector<float> m_keys;
+		std::vector<uint32_t> m_radixKeys;
+		radixSort::buffers m_radixBuffers;
+		// lane 0 is sorting axis, lanes 1 and 2 are the remaining axes
+		std::vector<float> m_minimum[3];
+		std::vector<float> m_maximum[3];
+		std::vector<std::vector<convexPair>> m_chunkPairs;
+		uint32_t m_axis;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_SWEEPANDPRUNE_H
@@ -0,0 +1,213 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "text.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+#include "quat.h"
+#include "mat4.h"
+#include <charconv>
+
+
+namespace marengine::maths {
+
+
+	static bool isSeparator(char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';' ||
+			c == '[' || c == ']' || c == '(' || c == ')';
+	}
+
+	static const char* skipSeparators(const char* first, const char* last) {
+		while (first != last && isSeparator(*first)) {
+			first++;
+		}
+		return first;
+	}
+
+
+	char* text::formatFloats(char* first, char* last, const float* values, size_t count, textStyle style) {
+		if (style == textStyle::Json) {
+			if (first == last) {
+				return nullptr;
+			}
+			*first++ = '[';
+		}
+		const char separator{ style == textStyle::Plain ? ' ' : ',' };
+		for (size_t i = 0; i < count; i++) {
+			if (i != 0) {
+				if (first == last) {
+					return nullptr;
+				}
+				*first++ = separator;
+			}
+			const std::to_chars_result result{ std::to_chars(first, last, values[i]) };
+			if (result.ec != std::errc()) {
+				return nullptr;
+			}
+			first = result.ptr;
+		}
+		if (style == textStyle::Json) {
+			if (first == last) {
+				return nullptr;
+			}
+			*first++ = ']';
+		}
+		return first;
+	}
+
+	const char* text::parseFloats(const char* first, const char* last, float* values, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			first = skipSeparators(first, last);
+			// from_chars doesn't accept leading '+'
+			if (first != last && *first == '+') {
+				first++;
+			}
+			const std::from_chars_result result{ std::from_chars(first, last, values[i]) };
+			if (result.ec != std::errc()) {
+				return nullptr;
+			}
+			first = result.ptr;
+		}
+		// consume closing bracket of JSON / tuple, so that reader stops right after value
+		while (first != last && (*first == ']' || *first == ')')) {
+			first++;
+		}
+		return first;
+	}
+
+	char* text::format(char* first, char* last, float f, textStyle style) {
+		return formatFloats(first, last, &f, 1, style == textStyle::Json ? textStyle::Plain : style);
+	}
+
+	char* text::format(char* first, char* last, const vec2& v, textStyle style) {
+		const float values[]{ v.x, v.y };
+		return formatFloats(first, last, values, 2, style);
+	}
+
+	char* text::format(char* first, char* last, const vec3& v, textStyle style) {
+		const float values[]{ v.x, v.y, v.z };
+		return formatFloats(first, last, values, 3, style);
+	}
+
+	char* text::format(char* first, char* last, const vec4& v, textStyle style) {
+		const float values[]{ v.x, v.y, v.z, v.w };
+		return formatFloats(first, last, values, 4, style);
+	}
+
+	char* text::format(char* first, char* last, const quat& q, textStyle style) {
+		const float values[]{ q.w, q.x, q.y, q.z };
+		return formatFloats(first, last, values, 4, style);
+	}
+
+	char* text::format(char* first, char* last, const mat4& m, textStyle style) {
+		return formatFloats(first, last, m.elements, 16, style);
+	}
+
+	const char* text::parse(const char* first, const char* last, float& f) {
+		return parseFloats(first, last, &f, 1);
+	}
+
+	const char* text::parse(const char* first, const char* last, vec2& v) {
+		float values[2];
+		const char* end{ parseFloats(first, last, values, 2) };
+		if (end) {
+			v = { values[0], values[1] };
+		}
+		return end;
+	}
+
+	const char* text::parse(const char* first, const char* last, vec3& v) {
+		float values[3];
+		const char* end{ parseFloats(first, last, values, 3) };
+		if (end) {
+			v = { values[0], values[1], values[2] };
+		}
+		return end;
+	}
+
+	const char* text::parse(const char* first, const char* last, vec4& v) {
+		float values[4];
+		const char* end{ parseFloats(first, last, values, 4) };
+		if (end) {
+			v = { values[0], values[1], values[2], values[3] };
+		}
+		return end;
+	}
+
+	const char* text::parse(const char* first, const char* last, quat& q) {
+		float values[4];
+		const char* end{ parseFloats(first, last, values, 4) };
+		if (end) {
+			q = { values[0], values[1], values[2], values[3] };
+		}
+		return end;
+	}
+
+	const char* text::parse(const char* first, const char* last, mat4& m) {
+		float values[16];
+		const char* end{ parseFloats(first, last, values, 16) };
+		if (end) {
+			for (size_t i = 0; i < 16; i++) {
+				m.elements[i] = values[i];
+			}
+		}
+		return end;
+	}
+
+
+	textWriter::textWriter(sink output, textStyle style, size_t bufferSize) :
+		m_sink(std::move(output)),
+		m_style(style),
+		m_buffer(bufferSize > text::maxMat4Length + 1 ? bufferSize : text::maxMat4Length + 1)
+	{}
+
+	textWriter::~textWriter() {
+		flush();
+	}
+
+	void textWriter::flush() {
+		if (m_used != 0) {
+			m_sink(m_buffer.data(), m_used);
+			m_used = 0;
+		}
+	}
+
+	void textWriter::reserve(size_t size) {
+		if (m_buffer.size() - m_used < size) {
+			flush();
+		}
+	}
+
+
+	textReader::textReader(const char* first, const char* last) :
+		m_position(first),
+		m_last(last)
+	{}
+
+	bool textReader::finished() const {
+		return skipSeparators(m_position, m_last) == m_last;
+	}
+
+
+}
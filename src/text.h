@@ -0,0 +1,236 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_TEXT_H
+#define MAR_MATH_TEXT_H
+
+
+#include "maths.h"
+#include <functional>
+#include <vector>
+
+
+namespace marengine::maths {
+
+	struct vec2;
+	struct vec3;
+	struct vec4;
+	struct quat;
+	struct mat4;
+
+
+	/**
+	 * \brief Style of formatted text. Parsing accepts every style.
+	 */
+	enum class textStyle {
+		/// \brief values separated with space: 1 2 3
+		Plain,
+		/// \brief values separated with comma: 1,2,3
+		Csv,
+		/// \brief JSON array: [1,2,3]
+		Json
+	};
+
+
+	/**
+	 * \struct text text.h "text.h"
+	 * \brief text gives fast, locale-independent formatting and parsing of vectors and matrices
+	 * built on std::to_chars / std::from_chars. Floats are written in shortest form, which parses
+	 * back to exactly the same value. No iostream is used.
+	 *
+	 * Format methods write to [first;last) and return pointer past last written character or nullptr,
+	 * if buffer is too small (nothing useful is written then). Parse methods skip separators
+	 * (whitespace, ',', ';', '[', ']', '(', ')') before every value and return pointer past last parsed
+	 * character or nullptr on failure. Every vector is written as its members (quat as w x y z),
+	 * mat4 as its 16 elements in column major order.
+	 */
+	struct text {
+
+		/// \brief Maximum count of characters written by format for single mat4 (16 floats, separators and brackets).
+		static constexpr size_t maxMat4Length{ 16 * 16 + 2 };
+
+		/// \brief self-explanatory
+		static char* format(char* first, char* last, float f, textStyle style = textStyle::Plain);
+		/// \brief self-explanatory
+		static char* format(char* first, char* last, const vec2& v, textStyle style = textStyle::Plain);
+		/// \brief self-explanatory
+		static char* format(char* first, char* last, const vec3& v, textStyle style = textStyle::Plain);
+		/// \brief self-explanatory
+		static char* format(char* first, char* last, const vec4& v, textStyle style = textStyle::Plain);
+		/// \brief self-explanatory
+		static char* format(char* first, char* last, const quat& q, textStyle style = textStyle::Plain);
+		/// \brief self-explanatory
+		static char* format(char* first, char* last, const mat4& m, textStyle style = textStyle::Plain);
+
+		/// \brief self-explanatory
+		static const char* parse(const char* first, const char* last, float& f);
+		/// \brief self-explanatory
+		static const char* parse(const char* first, const char* last, vec2& v);
+		/// \brief self-explanatory
+		static const char* parse(const char* first, const char* last, vec3& v);
+		/// \brief self-explanatory
+		static const char* parse(const char* first, const char* last, vec4& v);
+		/// \brief self-explanatory
+		static const char* parse(const char* first, const char* last, quat& q);
+		/// \brief self-explanatory
+		static const char* parse(const char* first, const char* last, mat4& m);
+
+		/**
+		 * \brief Formats count floats separated according to style.
+		 * \param first beginning of output buffer
+		 * \param last end of output buffer
+		 * \param values array of floats
+		 * \param count count of floats
+		 * \param style style of output
+		 * \return pointer past last written character or nullptr, if buffer is too small
+		 */
+		static char* formatFloats(char* first, char* last, const float* values, size_t count, textStyle style);
+
+		/**
+		 * \brief Parses count floats, skipping separators before each of them.
+		 * \param first beginning of input
+		 * \param last end of input
+		 * \param values array, to which count floats will be written
+		 * \param count count of floats
+		 * \return pointer past last parsed character or nullptr on failure
+		 */
+		static const char* parseFloats(const char* first, const char* last, float* values, size_t count);
+
+	};
+
+
+	/**
+	 * \struct textWriter text.h "text.h"
+	 * \brief textWriter formats values one per line into internal buffer and passes full
+	 * buffers to sink, so that millions of values can be exported without building whole string.
+	 */
+	struct textWriter {
+
+		/// \brief Function, which receives formatted text.
+		using sink = std::function<void(const char* data, size_t size)>;
+
+		/**
+		 * \brief Constructor.
+		 * \param output sink, that receives formatted text
+		 * \param style style of every written value
+		 * \param bufferSize size of internal buffer (at least text::maxMat4Length + 1 is used)
+		 */
+		textWriter(sink output, textStyle style = textStyle::Plain, size_t bufferSize = 64 * 1024);
+
+		/// \brief Flushes remaining text to sink.
+		~textWriter();
+
+		/// \brief Writes value and new line character.
+		template<typename T>
+		void write(const T& value) {
+			reserve(text::maxMat4Length + 1);
+			char* end{ text::format(m_buffer.data() + m_used, m_buffer.data() + m_buffer.size(), value, m_style) };
+			m_used = end - m_buffer.data();
+			m_buffer[m_used++] = '\n';
+		}
+
+		/// \brief Writes count values from array, one per line.
+		template<typename T>
+		void write(const T* values, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				write(values[i]);
+			}
+		}
+
+		/// \brief Passes buffered text to sink.
+		void flush();
+
+	private:
+
+		void reserve(size_t size);
+
+		sink m_sink;
+		textStyle m_style;
+		std::vector<char> m_buffer;
+		size_t m_used{ 0 };
+
+	};
+
+
+	/**
+	 * \struct textReader text.h "text.h"
+	 * \brief textReader parses consecutive values from buffer (ex: memory-mapped file), without copying it.
+	 */
+	struct textReader {
+
+		/**
+		 * \brief Constructor.
+		 * \param first beginning of text
+		 * \param last end of text
+		 */
+		textReader(const char* first, const char* last);
+
+		/**
+		 * \brief Parses next value.
+		 * \param value reference, to which parsed value will be written
+		 * \return false on end of text or parse error, position is not changed then
+		 */
+		template<typename T>
+		bool read(T& value) {
+			const char* next{ text::parse(m_position, m_last, value) };
+			if (!next) {
+				return false;
+			}
+			m_position = next;
+			return true;
+		}
+
+		/**
+		 * \brief Parses values until end of text or parse error.
+		 * \param out vector, to which parsed values are appended
+		 * \return count of parsed values
+		 */
+		template<typename T>
+		size_t readAll(std::vector<T>& out) {
+			size_t count{ 0 };
+			T value;
+			while (read(value)) {
+				out.push_back(value);
+				count++;
+			}
+			return count;
+		}
+
+		/**
+		 * \brief Returns true, if only separators are left in text.
+		 * \return true, if whole text is parsed
+		 */
+		bool finished() const;
+
+	private:
+
+		const char* m_position;
+		const char* m_last;
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_TEXT_H
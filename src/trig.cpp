@@ -21,6 +21,7 @@
 
 
 #include "trig.h"
+#include <cmath>
 
 
 namespace marengine::maths {
@@ -22,6 +22,11 @@
 
 #include "vec2.h"
 #include "basic.h"
+#include "diagnostics.h"
+#include "instrumentation.h"
+#include "kernels.h"
+#include "parallel.h"
+#include <cfloat>
 
 
 namespace marengine::maths {
@@ -60,7 +65,7 @@ namespace marengine::maths {
 
 	vec2 vec2::divide(float f) const {
 		if (f == 0.f) {
-			static_assert(true, "vec2::divide(0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec2::divide(0.f) - cannot divide by zero!");
 		};
 		return {
 			x / f,
@@ -91,7 +96,7 @@ namespace marengine::maths {
 
 	vec2 vec2::divide(vec2 other) const {
 		if (other.x == 0.f || other.y == 0.f) {
-			static_assert(true, "vec2::divide({0.f, 0.f}) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec2::divide({0.f, 0.f}) - cannot divide by zero!");
 		}
 		return {
 			x / other.x,
@@ -121,12 +126,41 @@ namespace marengine::maths {
 	}
 
 	vec2 vec2::normalize(vec2 other) {
+		MARMATH_PROBE(Vec2Normalize, 1);
 		const float magnitude{ length(other) };
 		if (magnitude == 0.f) {
-			static_assert(true, "vec2::normalize(magnitude=0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(ZeroLengthNormalize, "vec2::normalize(magnitude=0.f) - cannot divide by zero!");
 		}
 		const float inverseMagnitude{ 1.f / magnitude };
-		return other * inverseMagnitude;
+		const vec2 result{ other * inverseMagnitude };
+		MARMATH_CHECK_FINITE(&result.x, 2, "vec2::normalize");
+		return result;
+	}
+
+	vec2 vec2::normalizeFast() const {
+		return normalizeFast(*this);
+	}
+
+	vec2 vec2::normalizeFast(vec2 other) {
+		return other * basic::rsqrt(dot(other, other));
+	}
+
+	vec2 vec2::normalizeSafe(vec2 other, vec2 fallback) {
+		const float lengthSquared{ dot(other, other) };
+		const bool canBeNormalized{ lengthSquared > FLT_MIN && lengthSquared <= FLT_MAX };
+		if (!canBeNormalized) {
+			return fallback;
+		}
+		return normalize(other);
+	}
+
+	void vec2::normalizeFastMany(const vec2* in, vec2* out, size_t count) {
+		MARMATH_PROBE(Vec2NormalizeFastMany, count);
+		parallel::forEach(count, [in, out](size_t begin, size_t end) {
+			MARMATH_CHECK_DENORMALS(&in[begin].x, 2 * (end - begin), "vec2::normalizeFastMany");
+			kernels::normalizeFastRange<2>(in, out, begin, end);
+			MARMATH_CHECK_FINITE(&out[begin].x, 2 * (end - begin), "vec2::normalizeFastMany");
+		});
 	}
 
 	vec2 operator+(vec2 left, float right) {
@@ -165,6 +165,42 @@ namespace marengine::maths {
 		 * \return normalized vec2
 		 */
 		static vec2 normalize(vec2 other);
+
+		/**
+		 * \brief Computes normalized vec2 with basic::rsqrt instead of sqrt and division.
+		 * Relative error of every component is below 1e-6. Magnitude must not be equal to 0.f,
+		 * otherwise result contains NaN's (use normalizeSafe, if it can happen).
+		 * \return normalized vec2
+		 */
+		vec2 normalizeFast() const;
+
+		/**
+		 * \brief Computes normalized vec2 with basic::rsqrt instead of sqrt and division.
+		 * Relative error of every component is below 1e-6. Magnitude must not be equal to 0.f,
+		 * otherwise result contains NaN's (use normalizeSafe, if it can happen).
+		 * \param other vec2, which will be normalized
+		 * \return normalized vec2
+		 */
+		static vec2 normalizeFast(vec2 other);
+
+		/**
+		 * \brief Computes normalized vec2 exactly as normalize(), but if magnitude is equal to 0.f,
+		 * too small to be divided by or not finite, fallback is returned instead.
+		 * \param other vec2, which will be normalized
+		 * \param fallback vec2 returned, when other cannot be normalized
+		 * \return normalized vec2 or fallback
+		 */
+		static vec2 normalizeSafe(vec2 other, vec2 fallback);
+
+		/**
+		 * \brief Normalizes every vec2 in array with the same precision as normalizeFast().
+		 * Reciprocal square roots are computed 4 at once, large arrays are split with parallel::forEach.
+		 * In and out may be the same array.
+		 * \param in array of vec2
+		 * \param out array, to which normalized vectors will be written
+		 * \param count count of vectors
+		 */
+		static void normalizeFastMany(const vec2* in, vec2* out, size_t count);
 		
 		/// \brief self-explanatory
 		friend vec2 operator+(vec2 left, float right);
@@ -23,6 +23,12 @@
 #include "vec3.h"
 #include "vec4.h"
 #include "basic.h"
+#include "diagnostics.h"
+#include "instrumentation.h"
+#include "kernels.h"
+#include "parallel.h"
+#include <cfloat>
+#include <cmath>
 
 
 namespace marengine::maths {
@@ -72,7 +78,7 @@ namespace marengine::maths {
 
 	vec3 vec3::divide(float f) const {
 		if (f == 0.f) {
-			static_assert(true, "vec3::divide(0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec3::divide(0.f) - cannot divide by zero!");
 		};
 		return {
 			x / f,
@@ -108,7 +114,7 @@ namespace marengine::maths {
 
 	vec3 vec3::divide(vec3 other) const {
 		if (other.x == 0.f || other.y == 0.f || other.z == 0.f) {
-			static_assert(true, "vec3::divide({0.f, 0.f, 0.f}) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec3::divide({0.f, 0.f, 0.f}) - cannot divide by zero!");
 		}
 		return {
 			x / other.x,
@@ -151,12 +157,41 @@ namespace marengine::maths {
 	}
 
 	vec3 vec3::normalize(vec3 other) {
+		MARMATH_PROBE(Vec3Normalize, 1);
 		const float magnitude{ length(other) };
 		if (magnitude == 0.f) {
-			static_assert(true, "vec3::normalize(magnitude=0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(ZeroLengthNormalize, "vec3::normalize(magnitude=0.f) - cannot divide by zero!");
 		}
 		const float inverseMagnitude{ 1.f / magnitude };
-		return other * inverseMagnitude;
+		const vec3 result{ other * inverseMagnitude };
+		MARMATH_CHECK_FINITE(&result.x, 3, "vec3::normalize");
+		return result;
+	}
+
+	vec3 vec3::normalizeFast() const {
+		return normalizeFast(*this);
+	}
+
+	vec3 vec3::normalizeFast(vec3 other) {
+		return other * basic::rsqrt(dot(other, other));
+	}
+
+	vec3 vec3::normalizeSafe(vec3 other, vec3 fallback) {
+		const float lengthSquared{ dot(other, other) };
+		const bool canBeNormalized{ lengthSquared > FLT_MIN && lengthSquared <= FLT_MAX };
+		if (!canBeNormalized) {
+			return fallback;
+		}
+		return normalize(other);
+	}
+
+	void vec3::normalizeFastMany(const vec3* in, vec3* out, size_t count) {
+		MARMATH_PROBE(Vec3NormalizeFastMany, count);
+		parallel::forEach(count, [in, out](size_t begin, size_t end) {
+			MARMATH_CHECK_DENORMALS(&in[begin].x, 3 * (end - begin), "vec3::normalizeFastMany");
+			kernels::normalizeFastRange<3>(in, out, begin, end);
+			MARMATH_CHECK_FINITE(&out[begin].x, 3 * (end - begin), "vec3::normalizeFastMany");
+		});
 	}
 
 	float vec3::angleBetween(vec3 other) const {
@@ -167,7 +202,7 @@ namespace marengine::maths {
 		const float angle{ dot(left, right) };
 		const float len{ left.length() * right.length() };
 		if (len == 0.f) {
-			static_assert(true, "vec3::angleBetween(len=0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec3::angleBetween(len=0.f) - cannot divide by zero!");
 		}
 		return acosf(angle / len);
 	}
@@ -179,7 +214,7 @@ namespace marengine::maths {
 	vec3 vec3::projectOnto(vec3 left, vec3 right) {
 		const float magnitude{ right.length() };
 		if (magnitude == 0.f) {
-			static_assert(true, "vec3::projectOnto(magnitude=0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec3::projectOnto(magnitude=0.f) - cannot divide by zero!");
 		}
 		const auto normalizedRight{ right / magnitude };
 		return normalizedRight * dot(left, right);
@@ -222,10 +257,6 @@ namespace marengine::maths {
 		return false;
 	}
 
-	const float* vec3::value_ptr(const std::vector<vec3>& vec) {
-		return &(*vec.data()).x;
-	}
-
 	const float* vec3::value_ptr(const vec3& vec) {
 		return &vec.x;
 	}
@@ -191,6 +191,42 @@ namespace marengine::maths {
 		 */
 		static vec3 normalize(vec3 other);
 
+		/**
+		 * \brief Computes normalized vec3 with basic::rsqrt instead of sqrt and division.
+		 * Relative error of every component is below 1e-6. Magnitude must not be equal to 0.f,
+		 * otherwise result contains NaN's (use normalizeSafe, if it can happen).
+		 * \return normalized vec3
+		 */
+		vec3 normalizeFast() const;
+
+		/**
+		 * \brief Computes normalized vec3 with basic::rsqrt instead of sqrt and division.
+		 * Relative error of every component is below 1e-6. Magnitude must not be equal to 0.f,
+		 * otherwise result contains NaN's (use normalizeSafe, if it can happen).
+		 * \param other vec3, which will be normalized
+		 * \return normalized vec3
+		 */
+		static vec3 normalizeFast(vec3 other);
+
+		/**
+		 * \brief Computes normalized vec3 exactly as normalize(), but if magnitude is equal to 0.f,
+		 * too small to be divided by or not finite, fallback is returned instead.
+		 * \param other vec3, which will be normalized
+		 * \param fallback vec3 returned, when other cannot be normalized
+		 * \return normalized vec3 or fallback
+		 */
+		static vec3 normalizeSafe(vec3 other, vec3 fallback);
+
+		/**
+		 * \brief Normalizes every vec3 in array with the same precision as normalizeFast().
+		 * Reciprocal square roots are computed 4 at once, large arrays are split with parallel::forEach.
+		 * In and out may be the same array.
+		 * \param in array of vec3
+		 * \param out array, to which normalized vectors will be written
+		 * \param count count of vectors
+		 */
+		static void normalizeFastMany(const vec3* in, vec3* out, size_t count);
+
 		/**
 		 * \brief Calculates angle between 'this' vec3 and other
 		 * If (*this.length)*(other.length) is equal to 0.f, we have debug break.
@@ -255,11 +291,15 @@ namespace marengine::maths {
 		static bool inTriangle(vec3 point, vec3 t1, vec3 t2, vec3 t3);
 
 		/**
-		 * \brief Returns value_ptr to first vec3 at vector. Used especially in shaders.
-		 * \param vec vector of vec3
+		 * \brief Returns value_ptr to first vec3 at contiguous container (std::vector, std::array...).
+		 * Used especially in shaders. Template, so that vec3.h doesn't need to include any container.
+		 * \param vec container of vec3
 		 * \return value pointer
 		 */
-		static const float* value_ptr(const std::vector<vec3>& vec);
+		template<typename TContainer>
+		static auto value_ptr(const TContainer& vec) -> decltype(&vec.data()->x) {
+			return &vec.data()->x;
+		}
 
 		/**
 		 * \brief Returns const value_ptr to vec3. Used especially in shaders.
@@ -23,11 +23,25 @@
 #include "vec4.h"
 #include "vec3.h"
 #include "basic.h"
+#include "diagnostics.h"
+#include "instrumentation.h"
+#include "kernels.h"
+#include "parallel.h"
+#include <cfloat>
+#include <cmath>
 
 
 namespace marengine::maths {
 
 
+#if MARMATH_SIMD_SSE
+	static vec4 fromSimd(__m128 m) {
+		vec4 rtn;
+		rtn.simd = m;
+		return rtn;
+	}
+#endif
+
 	vec4::vec4() {
 		x = 0.0f;
 		y = 0.0f;
@@ -50,81 +64,113 @@ namespace marengine::maths {
 	}
 
 	vec4 vec4::add(float f) const {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_add_ps(simd, _mm_set1_ps(f)));
+#else
 		return {
 			x + f,
 			y + f,
 			z + f,
 			w + f
 		};
+#endif
 	}
 
 	vec4 vec4::subtract(float f) const {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_sub_ps(simd, _mm_set1_ps(f)));
+#else
 		return {
 			x - f,
 			y - f,
 			z - f,
 			w - f
 		};
+#endif
 	}
 
 	vec4 vec4::multiply(float f) const {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_mul_ps(simd, _mm_set1_ps(f)));
+#else
 		return {
 			x * f,
 			y * f,
 			z * f,
 			w * f
 		};
+#endif
 	}
 
 	vec4 vec4::divide(float f) const {
 		if (f == 0.f) {
-			static_assert(true, "vec4::divide(0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec4::divide(0.f) - cannot divide by zero!");
 		};
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_div_ps(simd, _mm_set1_ps(f)));
+#else
 		return {
 			x / f,
 			y / f,
 			z / f,
 			w / f
 		};
+#endif
 	}
 
 	vec4 vec4::add(vec4 other) const {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_add_ps(simd, other.simd));
+#else
 		return {
 			x + other.x,
 			y + other.y,
 			z + other.z,
 			w + other.w
 		};
+#endif
 	}
 
 	vec4 vec4::subtract(vec4 other) const {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_sub_ps(simd, other.simd));
+#else
 		return {
 			x - other.x,
 			y - other.y,
 			z - other.z,
 			w - other.w
 		};
+#endif
 	}
 
 	vec4 vec4::multiply(vec4 other) const {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_mul_ps(simd, other.simd));
+#else
 		return {
 			x * other.x,
 			y * other.y,
 			z * other.z,
 			w * other.w
 		};
+#endif
 	}
 
 	vec4 vec4::divide(vec4 other) const {
 		if (other.x == 0.f || other.y == 0.f || other.z == 0.f || other.w == 0.f) {
-			static_assert(true, "vec4::divide({0.f, 0.f, 0.f, 0.f}) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(DivisionByZero, "vec4::divide({0.f, 0.f, 0.f, 0.f}) - cannot divide by zero!");
 		}
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_div_ps(simd, other.simd));
+#else
 		return {
 			x / other.x,
 			y / other.y,
 			z / other.z,
 			w / other.w
 		};
+#endif
 	}
 
 	float vec4::dot(vec4 other) const {
@@ -132,8 +178,15 @@ namespace marengine::maths {
 	}
 
 	float vec4::dot(vec4 left, vec4 right) {
+#if MARMATH_SIMD_SSE
+		// (x + y) + (z + w) with shuffles only, so result is the same as in scalar version
+		const __m128 tmp{ _mm_mul_ps(left.simd, right.simd) };
+		const __m128 pairs{ _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(2, 3, 0, 1))) };
+		return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_movehl_ps(pairs, pairs)));
+#else
 		const vec4 tmp{ left * right };
 		return (tmp.x + tmp.y) + (tmp.z + tmp.w);//left.x * right.x + left.y * right.y + left.z * right.z + left.w * right.w;
+#endif
 	}
 
 	float vec4::length() const {
@@ -149,16 +202,134 @@ namespace marengine::maths {
 	}
 
 	vec4 vec4::normalize(vec4 other) {
+		MARMATH_PROBE(Vec4Normalize, 1);
 		const float magnitude{ other.length() };
 		if (magnitude == 0.f) {
-			static_assert(true, "vec4::normalize(magnitude=0.f) - cannot divide by zero!");
+			MARMATH_DIAGNOSE(ZeroLengthNormalize, "vec4::normalize(magnitude=0.f) - cannot divide by zero!");
 		}
 		const float inverseMagnitude{ 1.f / magnitude };
-		return other * inverseMagnitude;
+		const vec4 result{ other * inverseMagnitude };
+		MARMATH_CHECK_FINITE(&result.x, 4, "vec4::normalize");
+		return result;
+	}
+
+	vec4 vec4::normalizeFast() const {
+		return normalizeFast(*this);
+	}
+
+	vec4 vec4::normalizeFast(vec4 other) {
+		return other * basic::rsqrt(dot(other, other));
+	}
+
+	vec4 vec4::normalizeSafe(vec4 other, vec4 fallback) {
+		const float lengthSquared{ dot(other, other) };
+		const bool canBeNormalized{ lengthSquared > FLT_MIN && lengthSquared <= FLT_MAX };
+		if (!canBeNormalized) {
+			return fallback;
+		}
+		return normalize(other);
+	}
+
+	void vec4::normalizeFastMany(const vec4* in, vec4* out, size_t count) {
+		MARMATH_PROBE(Vec4NormalizeFastMany, count);
+		parallel::forEach(count, [in, out](size_t begin, size_t end) {
+			MARMATH_CHECK_DENORMALS(&in[begin].x, 4 * (end - begin), "vec4::normalizeFastMany");
+			kernels::normalizeFastRange<4>(in, out, begin, end);
+			MARMATH_CHECK_FINITE(&out[begin].x, 4 * (end - begin), "vec4::normalizeFastMany");
+		});
+	}
+
+	vec4 vec4::min(vec4 left, vec4 right) {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_min_ps(left.simd, right.simd));
+#else
+		return {
+			left.x < right.x ? left.x : right.x,
+			left.y < right.y ? left.y : right.y,
+			left.z < right.z ? left.z : right.z,
+			left.w < right.w ? left.w : right.w
+		};
+#endif
+	}
+
+	vec4 vec4::max(vec4 left, vec4 right) {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_max_ps(left.simd, right.simd));
+#else
+		return {
+			left.x > right.x ? left.x : right.x,
+			left.y > right.y ? left.y : right.y,
+			left.z > right.z ? left.z : right.z,
+			left.w > right.w ? left.w : right.w
+		};
+#endif
+	}
+
+	vec4 vec4::abs(vec4 v) {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_andnot_ps(_mm_set1_ps(-0.f), v.simd));
+#else
+		return {
+			fabsf(v.x),
+			fabsf(v.y),
+			fabsf(v.z),
+			fabsf(v.w)
+		};
+#endif
+	}
+
+	vec4 vec4::clamp(vec4 v, vec4 low, vec4 high) {
+		return min(max(v, low), high);
+	}
+
+	vec4 vec4::lessThan(vec4 left, vec4 right) {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_and_ps(_mm_cmplt_ps(left.simd, right.simd), _mm_set1_ps(1.f)));
+#else
+		return {
+			left.x < right.x ? 1.f : 0.f,
+			left.y < right.y ? 1.f : 0.f,
+			left.z < right.z ? 1.f : 0.f,
+			left.w < right.w ? 1.f : 0.f
+		};
+#endif
+	}
+
+	vec4 vec4::greaterThan(vec4 left, vec4 right) {
+		return lessThan(right, left);
+	}
+
+	vec4 vec4::select(vec4 condition, vec4 ifTrue, vec4 ifFalse) {
+#if MARMATH_SIMD_SSE
+		const __m128 mask{ _mm_cmpneq_ps(condition.simd, _mm_setzero_ps()) };
+		return fromSimd(_mm_or_ps(_mm_and_ps(mask, ifTrue.simd), _mm_andnot_ps(mask, ifFalse.simd)));
+#else
+		return {
+			condition.x != 0.f ? ifTrue.x : ifFalse.x,
+			condition.y != 0.f ? ifTrue.y : ifFalse.y,
+			condition.z != 0.f ? ifTrue.z : ifFalse.z,
+			condition.w != 0.f ? ifTrue.w : ifFalse.w
+		};
+#endif
+	}
+
+	vec4 vec4::load(const float* data) {
+#if MARMATH_SIMD_SSE
+		return fromSimd(_mm_loadu_ps(data));
+#else
+		return { data[0], data[1], data[2], data[3] };
+#endif
 	}
 
-	const float* vec4::value_ptr(const std::vector<vec4>& vec) {
-		return &(*vec.data()).x;
+	void vec4::store(vec4 v, float* data) {
+#if MARMATH_SIMD_SSE
+		_mm_storeu_ps(data, v.simd);
+#else
+		data[0] = v.x;
+		data[1] = v.y;
+		data[2] = v.z;
+		data[3] = v.w;
+#endif
 	}
 
 	const float* vec4::value_ptr() const {
@@ -202,7 +373,11 @@ namespace marengine::maths {
 	}
 
 	bool vec4::operator==(vec4 other) const {
+#if MARMATH_SIMD_SSE
+		return _mm_movemask_ps(_mm_cmpeq_ps(simd, other.simd)) == 0xF;
+#else
 		return x == other.x && y == other.y && z == other.z && w == other.w;
+#endif
 	}
 
 	bool vec4::operator!=(vec4 other) const {
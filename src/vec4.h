@@ -26,6 +26,10 @@
 
 #include "maths.h"
 
+#if MARMATH_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
 
 namespace marengine::maths {
 
@@ -34,18 +38,28 @@ namespace marengine::maths {
 
 	/**
 	 * \struct vec4 vec4.h "vec4.h"
-	 * \brief 4-dimensional vector.
+	 * \brief 4-dimensional vector. It is 16-byte aligned, with SSE enabled (see MARMATH_SIMD_SSE
+	 * in maths.h) data is stored in __m128 and every operation works on all 4 lanes at once.
+	 * Without SSE the same layout is kept (also for NEON targets) and scalar code is used.
 	 */
-	struct vec4 {
+	struct alignas(16) vec4 {
 		
-		/// \brief x value of vec4
-		float x;
-		/// \brief y value of vec4
-		float y; 
-		/// \brief z value of vec4
-		float z;
-		/// \brief w value of vec4
-		float w;
+		union {
+			struct {
+				/// \brief x value of vec4
+				float x;
+				/// \brief y value of vec4
+				float y; 
+				/// \brief z value of vec4
+				float z;
+				/// \brief w value of vec4
+				float w;
+			};
+#if MARMATH_SIMD_SSE
+			/// \brief SSE register view of x, y, z, w
+			__m128 simd;
+#endif
+		};
 
 
 		/// \brief Default constructor, creates vec4(0.f, 0.f, 0.f, 0.f).
@@ -182,11 +196,141 @@ namespace marengine::maths {
 		static vec4 normalize(vec4 other);
 
 		/**
-		 * \brief Returns value_ptr to first vec4 at vector. Used especially in shaders.
-		 * \param vec vector of vec4
+		 * \brief Computes normalized vec4 with basic::rsqrt instead of sqrt and division.
+		 * Relative error of every component is below 1e-6. Magnitude must not be equal to 0.f,
+		 * otherwise result contains NaN's (use normalizeSafe, if it can happen).
+		 * \return normalized vec4
+		 */
+		vec4 normalizeFast() const;
+
+		/**
+		 * \brief Computes normalized vec4 with basic::rsqrt instead of sqrt and division.
+		 * Relative error of every component is below 1e-6. Magnitude must not be equal to 0.f,
+		 * otherwise result contains NaN's (use normalizeSafe, if it can happen).
+		 * \param other vec4, which will be normalized
+		 * \return normalized vec4
+		 */
+		static vec4 normalizeFast(vec4 other);
+
+		/**
+		 * \brief Computes normalized vec4 exactly as normalize(), but if magnitude is equal to 0.f,
+		 * too small to be divided by or not finite, fallback is returned instead.
+		 * \param other vec4, which will be normalized
+		 * \param fallback vec4 returned, when other cannot be normalized
+		 * \return normalized vec4 or fallback
+		 */
+		static vec4 normalizeSafe(vec4 other, vec4 fallback);
+
+		/**
+		 * \brief Normalizes every vec4 in array with the same precision as normalizeFast().
+		 * Reciprocal square roots are computed 4 at once, large arrays are split with parallel::forEach.
+		 * In and out may be the same array.
+		 * \param in array of vec4
+		 * \param out array, to which normalized vectors will be written
+		 * \param count count of vectors
+		 */
+		static void normalizeFastMany(const vec4* in, vec4* out, size_t count);
+
+		/**
+		 * \brief Returns vec4 with lanes reordered by given indices, ex: swizzle<2, 1, 0, 3>()
+		 * returns vec4(z, y, x, w), swizzle<0, 0, 0, 0>() broadcasts x.
+		 * \return swizzled vec4
+		 */
+		template<size_t X, size_t Y, size_t Z, size_t W>
+		vec4 swizzle() const {
+			static_assert(X < 4 && Y < 4 && Z < 4 && W < 4, "vec4::swizzle - lane index out of range!");
+#if MARMATH_SIMD_SSE
+			vec4 rtn;
+			rtn.simd = _mm_shuffle_ps(simd, simd, _MM_SHUFFLE(W, Z, Y, X));
+			return rtn;
+#else
+			const float* lanes{ &x };
+			return { lanes[X], lanes[Y], lanes[Z], lanes[W] };
+#endif
+		}
+
+		/**
+		 * \brief Component-wise minimum of 2 given vec4's.
+		 * \param left first vec4
+		 * \param right second vec4
+		 * \return vec4(min(left.x, right.x), ...)
+		 */
+		static vec4 min(vec4 left, vec4 right);
+
+		/**
+		 * \brief Component-wise maximum of 2 given vec4's.
+		 * \param left first vec4
+		 * \param right second vec4
+		 * \return vec4(max(left.x, right.x), ...)
+		 */
+		static vec4 max(vec4 left, vec4 right);
+
+		/**
+		 * \brief Component-wise absolute value of given vec4.
+		 * \param v vec4
+		 * \return vec4(|v.x|, |v.y|, |v.z|, |v.w|)
+		 */
+		static vec4 abs(vec4 v);
+
+		/**
+		 * \brief Component-wise clamp of given vec4 to range <low;high>.
+		 * \param v vec4, which will be clamped
+		 * \param low lower bound
+		 * \param high upper bound
+		 * \return clamped vec4
+		 */
+		static vec4 clamp(vec4 v, vec4 low, vec4 high);
+
+		/**
+		 * \brief Component-wise compare, lane is set to 1.f if left < right, else 0.f.
+		 * \param left first vec4
+		 * \param right second vec4
+		 * \return vec4 of 1.f / 0.f, which can be passed to select()
+		 */
+		static vec4 lessThan(vec4 left, vec4 right);
+
+		/**
+		 * \brief Component-wise compare, lane is set to 1.f if left > right, else 0.f.
+		 * \param left first vec4
+		 * \param right second vec4
+		 * \return vec4 of 1.f / 0.f, which can be passed to select()
+		 */
+		static vec4 greaterThan(vec4 left, vec4 right);
+
+		/**
+		 * \brief Component-wise select without branches. Lane is taken from ifTrue, when
+		 * condition lane is not equal to 0.f, otherwise from ifFalse.
+		 * \param condition vec4, ex: returned from lessThan() or greaterThan()
+		 * \param ifTrue vec4, which lanes are chosen for non-zero condition
+		 * \param ifFalse vec4, which lanes are chosen for zero condition
+		 * \return selected vec4
+		 */
+		static vec4 select(vec4 condition, vec4 ifTrue, vec4 ifFalse);
+
+		/**
+		 * \brief Loads vec4 from 4 floats, that don't have to be aligned.
+		 * \param data pointer to 4 floats
+		 * \return loaded vec4
+		 */
+		static vec4 load(const float* data);
+
+		/**
+		 * \brief Stores vec4 to 4 floats, that don't have to be aligned.
+		 * \param v vec4, which will be stored
+		 * \param data pointer to 4 floats
+		 */
+		static void store(vec4 v, float* data);
+
+		/**
+		 * \brief Returns value_ptr to first vec4 at contiguous container (std::vector, std::array...).
+		 * Used especially in shaders. Template, so that vec4.h doesn't need to include any container.
+		 * \param vec container of vec4
 		 * \return value pointer
 		 */
-		static const float* value_ptr(const std::vector<vec4>& vec);
+		template<typename TContainer>
+		static auto value_ptr(const TContainer& vec) -> decltype(&vec.data()->x) {
+			return &vec.data()->x;
+		}
 
 		/**
 		 * \brief Returns const value_ptr to vec4. Used especially in shaders.
@@ -0,0 +1,113 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#include "world.h"
+#include "mat4.h"
+#include "vec3.h"
+#include "parallel.h"
+#include "instrumentation.h"
+#include "diagnostics.h"
+#include "stridedview.h"
+
+
+namespace marengine::maths {
+
+
+	// Computes translation(relative) * local in place. Written for every column, so that
+	// also non-affine local matrices are handled properly.
+	static void translateLocal(mat4& local, vec3 relative) {
+		for (size_t col = 0; col < 4; col++) {
+			const float w{ local[3 + col * 4] };
+			local[0 + col * 4] += relative.x * w;
+			local[1 + col * 4] += relative.y * w;
+			local[2 + col * 4] += relative.z * w;
+		}
+	}
+
+	mat4 world::lookAtRelative(dvec3 eye, dvec3 center, vec3 y) {
+		const dvec3 direction{ center - eye };
+		const double len{ dvec3::length(direction) };
+		if (len == 0.0) {
+			MARMATH_DIAGNOSE(ZeroLengthNormalize, "world::lookAtRelative(eye == center) - cannot divide by zero!");
+		}
+		const vec3 fwd{ direction.multiply(1.0 / len).toVec3() };
+		return mat4::lookAt(vec3(), fwd, y);
+	}
+
+	mat4 world::translationRelative(dvec3 position, dvec3 origin) {
+		return mat4::translation((position - origin).toVec3());
+	}
+
+	mat4 world::modelViewRelative(const mat4& viewRelative, dvec3 cameraPosition, dvec3 position, const mat4& local) {
+		mat4 model{ local };
+		translateLocal(model, (position - cameraPosition).toVec3());
+		return viewRelative.multiply(model);
+	}
+
+	void world::modelViewMany(const mat4& viewRelative, dvec3 cameraPosition, const dvec3* positions,
+		const mat4* locals, mat4* out, size_t count) {
+		MARMATH_PROBE(WorldModelViewMany, count);
+		parallel::forEach(count, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				mat4 model{ locals[i] };
+				translateLocal(model, (positions[i] - cameraPosition).toVec3());
+				out[i] = viewRelative.multiply(model);
+			}
+			MARMATH_CHECK_FINITE(out[begin].elements, 16 * (end - begin), "world::modelViewMany");
+		});
+	}
+
+	void world::modelViewMany(const mat4& viewRelative, dvec3 cameraPosition, const std::vector<dvec3>& positions,
+		const std::vector<mat4>& locals, std::vector<mat4>& out) {
+		out.resize(positions.size());
+		modelViewMany(viewRelative, cameraPosition, positions.data(), locals.data(), out.data(), positions.size());
+	}
+
+	void world::modelViewMany(const mat4& viewRelative, dvec3 cameraPosition, const dvec3* positions,
+		const mat4* locals, const stridedView<mat4>& out) {
+		MARMATH_PROBE(WorldModelViewMany, out.count);
+		parallel::forEach(out.count, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				mat4 model{ locals[i] };
+				translateLocal(model, (positions[i] - cameraPosition).toVec3());
+				out.set(i, viewRelative.multiply(model));
+			}
+		});
+	}
+
+	void world::modelViewManySplit(const mat4& viewRelative, vec3 cameraHigh, vec3 cameraLow, const vec3* positionsHigh,
+		const vec3* positionsLow, const mat4* locals, mat4* out, size_t count) {
+		MARMATH_PROBE(WorldModelViewManySplit, count);
+		parallel::forEach(count, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const vec3 relative{ (positionsHigh[i] - cameraHigh) + (positionsLow[i] - cameraLow) };
+				mat4 model{ locals[i] };
+				translateLocal(model, relative);
+				out[i] = viewRelative.multiply(model);
+			}
+			MARMATH_CHECK_FINITE(out[begin].elements, 16 * (end - begin), "world::modelViewManySplit");
+		});
+	}
+
+
+}
@@ -0,0 +1,141 @@
+/***********************************************************************
+* @internal @copyright
+*
+*        MARMaths - open source computing library for MAREngine
+*
+* Copyright (C) 2020-present Mateusz Rzeczyca <info@mateuszrzeczyca.pl>
+* All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+************************************************************************/
+
+
+
+#ifndef MAR_MATH_WORLD_H
+#define MAR_MATH_WORLD_H
+
+
+#include "maths.h"
+#include "dvec3.h"
+#include <vector>
+
+
+namespace marengine::maths {
+
+	struct vec3;
+	struct mat4;
+	template<typename T> struct stridedView;
+
+
+	/**
+	 * \struct world world.h "world.h"
+	 * \brief world gives methods for large-world rendering. World positions are kept in
+	 * dvec3 (or in split high / low vec3 pairs), camera position is subtracted in double
+	 * precision and only the small, camera-relative result is narrowed to float. Thanks to
+	 * that entities never have to be rebased when camera travels far from origin.
+	 *
+	 * Every local transform passed to world methods describes rotation and scale of an object
+	 * (with optional small local offset in last column), its world position is given separately.
+	 */
+	struct world {
+
+		/**
+		 * \brief Get camera-relative lookAt matrix. Direction is computed in double precision,
+		 * eye is placed at origin, so that returned matrix contains no translation.
+		 * \param eye defines position of camera in world
+		 * \param center defines place in world, where the camera is looking
+		 * \param y specifies the up direction of the camera
+		 * \return created camera-relative view matrix
+		 */
+		static mat4 lookAtRelative(dvec3 eye, dvec3 center, vec3 y);
+
+		/**
+		 * \brief Get translation matrix of position relative to given origin. Subtraction
+		 * is done in double precision before narrowing to float.
+		 * \param position world position of the object
+		 * \param origin world position of origin (usually camera)
+		 * \return created translation matrix
+		 */
+		static mat4 translationRelative(dvec3 position, dvec3 origin);
+
+		/**
+		 * \brief Computes camera-relative model-view matrix of single object.
+		 * \param viewRelative view matrix without translation (see lookAtRelative)
+		 * \param cameraPosition world position of camera
+		 * \param position world position of object
+		 * \param local rotation and scale of object
+		 * \return viewRelative * translation(position - cameraPosition) * local
+		 */
+		static mat4 modelViewRelative(const mat4& viewRelative, dvec3 cameraPosition, dvec3 position, const mat4& local);
+
+		/**
+		 * \brief Computes camera-relative model-view matrices for given arrays. Output is
+		 * written as contiguous mat4 array, so it can be uploaded directly.
+		 * \param viewRelative view matrix without translation (see lookAtRelative)
+		 * \param cameraPosition world position of camera
+		 * \param positions world positions of objects
+		 * \param locals rotation and scale of objects
+		 * \param out array, to which count model-view matrices will be written
+		 * \param count count of objects
+		 */
+		static void modelViewMany(const mat4& viewRelative, dvec3 cameraPosition, const dvec3* positions,
+			const mat4* locals, mat4* out, size_t count);
+
+		/**
+		 * \brief Computes camera-relative model-view matrices for given vectors. Out is resized
+		 * to positions.size(), so mat4::value_ptr(out) can be used right after this call.
+		 * Make sure, that locals has at least positions.size() elements. Method won't check that!
+		 * \param viewRelative view matrix without translation (see lookAtRelative)
+		 * \param cameraPosition world position of camera
+		 * \param positions world positions of objects
+		 * \param locals rotation and scale of objects
+		 * \param out vector, to which model-view matrices will be written
+		 */
+		static void modelViewMany(const mat4& viewRelative, dvec3 cameraPosition, const std::vector<dvec3>& positions,
+			const std::vector<mat4>& locals, std::vector<mat4>& out);
+
+		/**
+		 * \brief Computes camera-relative model-view matrices directly into strided (ex: interleaved
+		 * instance) buffer. Positions and locals must have at least out.count elements.
+		 * \param viewRelative view matrix without translation (see lookAtRelative)
+		 * \param cameraPosition world position of camera
+		 * \param positions world positions of objects
+		 * \param locals rotation and scale of objects
+		 * \param out view, to which out.count model-view matrices will be written
+		 */
+		static void modelViewMany(const mat4& viewRelative, dvec3 cameraPosition, const dvec3* positions,
+			const mat4* locals, const stridedView<mat4>& out);
+
+		/**
+		 * \brief Computes camera-relative model-view matrices, where world positions are stored
+		 * as split high / low vec3 pairs (see dvec3::split). Everything is computed in float,
+		 * (high - cameraHigh) + (low - cameraLow) keeps precision of the double subtraction.
+		 * \param viewRelative view matrix without translation (see lookAtRelative)
+		 * \param cameraHigh high part of camera world position
+		 * \param cameraLow low part of camera world position
+		 * \param positionsHigh high parts of objects world positions
+		 * \param positionsLow low parts of objects world positions
+		 * \param locals rotation and scale of objects
+		 * \param out array, to which count model-view matrices will be written
+		 * \param count count of objects
+		 */
+		static void modelViewManySplit(const mat4& viewRelative, vec3 cameraHigh, vec3 cameraLow, const vec3* positionsHigh,
+			const vec3* positionsLow, const mat4* locals, mat4* out, size_t count);
+
+	};
+
+
+}
+
+
+#endif // !MAR_MATH_WORLD_H
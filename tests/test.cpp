@@ -24,8 +24,18 @@
 
 
 #include "pch.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 
 #include "MARMaths.h"
@@ -164,6 +174,1693 @@ TEST(MAT4Testcase, MAT4multiplication2) {
 
 }
 
+TEST(WORLDTestcase, WORLDModelViewFarFromOrigin) {
+	const dvec3 camera{ 250000.0, 10.0, -350000.0 };
+	const dvec3 offsets[]{ { 1.25, 0.5, -2.0 }, { -3.0, 0.0, 0.75 } };
+	const mat4 view{ world::lookAtRelative(camera, camera + dvec3{ 0.0, 0.0, -1.0 }, { 0.f, 1.f, 0.f }) };
+	const mat4 local{ mat4::scale({ 2.f, 2.f, 2.f }) };
+
+	std::vector<dvec3> positions;
+	std::vector<mat4> locals;
+	for (const dvec3& offset : offsets) {
+		positions.push_back(camera + offset);
+		locals.push_back(local);
+	}
+
+	std::vector<mat4> out;
+	world::modelViewMany(view, camera, positions, locals, out);
+	ASSERT_EQ(out.size(), positions.size());
+
+	for (size_t i = 0; i < out.size(); i++) {
+		// same object placed near origin must give identical model-view matrix
+		const mat4 expected{ view * mat4::translation(offsets[i].toVec3()) * local };
+		ASSERT_TRUE(out[i] == expected);
+		ASSERT_TRUE(world::modelViewRelative(view, camera, positions[i], local) == expected);
+	}
+
+	vec3 cameraHigh, cameraLow;
+	dvec3::split(camera, cameraHigh, cameraLow);
+	std::vector<vec3> high(positions.size()), low(positions.size());
+	for (size_t i = 0; i < positions.size(); i++) {
+		dvec3::split(positions[i], high[i], low[i]);
+	}
+
+	std::vector<mat4> outSplit(positions.size());
+	world::modelViewManySplit(view, cameraHigh, cameraLow, high.data(), low.data(), locals.data(), outSplit.data(), outSplit.size());
+	for (size_t i = 0; i < out.size(); i++) {
+		for (size_t j = 0; j < 16; j++) {
+			ASSERT_TRUE(basic::epsilonEqual(outSplit[i][j], out[i][j], 1e-4f));
+		}
+	}
+}
+
+TEST(PARALLELTestcase, PARALLELForEachCoversRangeOnce) {
+	parallel::setThreadCount(4);
+	ASSERT_EQ(parallel::threadCount(), 4);
+
+	const size_t count{ 100003 };
+	std::vector<int> visited(count, 0);
+	for (size_t grain : { 1, 7, 1024, 200000 }) {
+		std::fill(visited.begin(), visited.end(), 0);
+		parallel::forEach(count, grain, [&](size_t begin, size_t end) {
+			ASSERT_TRUE(end - begin <= grain);
+			for (size_t i = begin; i < end; i++) {
+				visited[i]++;
+			}
+		});
+		ASSERT_TRUE(std::all_of(visited.begin(), visited.end(), [](int v) { return v == 1; }));
+	}
+
+	// batch methods must give the same output regardless of thread count
+	const dvec3 camera{ 1.0e6, 0.0, 1.0e6 };
+	std::vector<dvec3> positions(5000);
+	std::vector<mat4> locals(5000, mat4::identity());
+	for (size_t i = 0; i < positions.size(); i++) {
+		positions[i] = camera + dvec3{ (double)i * 0.5, 1.0, -(double)i };
+	}
+	std::vector<mat4> multiThreaded;
+	world::modelViewMany(mat4::identity(), camera, positions, locals, multiThreaded);
+
+	parallel::setThreadCount(1);
+	std::vector<mat4> singleThreaded;
+	world::modelViewMany(mat4::identity(), camera, positions, locals, singleThreaded);
+	ASSERT_TRUE(multiThreaded == singleThreaded);
+
+	// exception thrown by any chunk reaches caller and pool stays usable
+	parallel::setThreadCount(4);
+	for (size_t throwingChunk : { 0, 57 }) {
+		bool caught{ false };
+		try {
+			parallel::forEach(count, 1024, [throwingChunk](size_t begin, size_t) {
+				if (begin == throwingChunk * 1024) {
+					throw std::runtime_error("task failed");
+				}
+			});
+		}
+		catch (const std::runtime_error&) {
+			caught = true;
+		}
+		ASSERT_TRUE(caught);
+	}
+	std::atomic<size_t> processed{ 0 };
+	parallel::forEach(count, 1024, [&processed](size_t begin, size_t end) { processed += end - begin; });
+	ASSERT_EQ(processed.load(), count);
+	parallel::setThreadCount(1);
+}
+
+TEST(EXPRTestcase, EXPRLazyEqualsEager) {
+	const vec3 v1{ 1.f, 2.f, 3.f };
+	const vec3 v2{ 4.f, -5.f, 6.f };
+	const vec3 v3{ 0.5f, 0.25f, 2.f };
+	const vec3 v4{ 1.f, 1.f, -1.f };
+	const float s{ 3.f };
+
+	// lazy expression may be contracted to FMA, so compare with epsilon
+	const vec3 lazy = expr::lazy(v1) * v2 + expr::lazy(v3) * s - v4;
+	const vec3 eager{ v1 * v2 + v3 * s - v4 };
+	ASSERT_TRUE(basic::epsilonEqual(lazy.x, eager.x, 1e-5f));
+	ASSERT_TRUE(basic::epsilonEqual(lazy.y, eager.y, 1e-5f));
+	ASSERT_TRUE(basic::epsilonEqual(lazy.z, eager.z, 1e-5f));
+
+	const vec4 w1{ v1, 1.f };
+	const vec4 w2{ v2, 2.f };
+	const vec4 lazy4 = -(expr::lazy(w1) / 2.f) + w2;
+	ASSERT_TRUE(lazy4 == w2 - w1 / 2.f);
+}
+
+TEST(EXPRTestcase, EXPRAssignSoA) {
+	const size_t count{ 37 };
+	std::vector<float> px(count), py(count), pz(count);
+	std::vector<float> vx(count), vy(count), vz(count);
+	for (size_t i = 0; i < count; i++) {
+		px[i] = (float)i;
+		py[i] = 2.f * (float)i;
+		pz[i] = -(float)i;
+		vx[i] = 1.f;
+		vy[i] = (float)i * 0.5f;
+		vz[i] = 3.f;
+	}
+	const expr::soa3 positions{ { px.data(), py.data(), pz.data() }, count };
+	const expr::soa3 velocities{ { vx.data(), vy.data(), vz.data() }, count };
+	const vec3 gravity{ 0.f, -9.81f, 0.f };
+	const float dt{ 0.25f };
+
+	std::vector<vec3> expected(count);
+	for (size_t i = 0; i < count; i++) {
+		const vec3 p{ px[i], py[i], pz[i] };
+		const vec3 v{ vx[i], vy[i], vz[i] };
+		expected[i] = p + (v + gravity * dt) * dt;
+	}
+
+	// writes back to positions, every lane reads only its own lane
+	expr::assign(positions, expr::lazy(positions) + (expr::lazy(velocities) + gravity * dt) * dt);
+	for (size_t i = 0; i < count; i++) {
+		ASSERT_TRUE(basic::epsilonEqual(px[i], expected[i].x, 1e-4f));
+		ASSERT_TRUE(basic::epsilonEqual(py[i], expected[i].y, 1e-4f));
+		ASSERT_TRUE(basic::epsilonEqual(pz[i], expected[i].z, 1e-4f));
+	}
+}
+
+TEST(VEC4Testcase, VEC4LaneWiseOperations) {
+	const vec4 a{ 1.f, -2.f, 3.f, -4.f };
+	const vec4 b{ -1.f, 5.f, 2.f, 0.f };
+
+	ASSERT_TRUE((a.swizzle<3, 2, 1, 0>() == vec4{ -4.f, 3.f, -2.f, 1.f }));
+	ASSERT_TRUE((a.swizzle<1, 1, 1, 1>() == vec4{ -2.f, -2.f, -2.f, -2.f }));
+	ASSERT_TRUE((vec4::min(a, b) == vec4{ -1.f, -2.f, 2.f, -4.f }));
+	ASSERT_TRUE((vec4::max(a, b) == vec4{ 1.f, 5.f, 3.f, 0.f }));
+	ASSERT_TRUE((vec4::abs(a) == vec4{ 1.f, 2.f, 3.f, 4.f }));
+	ASSERT_TRUE((vec4::clamp(a, vec4{ -1.f, -1.f, -1.f, -1.f }, vec4{ 2.f, 2.f, 2.f, 2.f }) == vec4{ 1.f, -1.f, 2.f, -1.f }));
+	ASSERT_TRUE((vec4::lessThan(a, b) == vec4{ 0.f, 1.f, 0.f, 1.f }));
+	ASSERT_TRUE((vec4::select(vec4::greaterThan(a, b), a, b) == vec4::max(a, b)));
+	ASSERT_EQ(vec4::dot(a, b), (1.f * -1.f + -2.f * 5.f) + (3.f * 2.f + -4.f * 0.f));
+
+	mat4 m;
+	for (size_t i = 0; i < 16; i++) {
+		m[i] = (float)i;
+	}
+	float column[4];
+	vec4::store(m.getColumn4(2), column);
+	ASSERT_TRUE((vec4::load(column) == vec4{ 8.f, 9.f, 10.f, 11.f }));
+}
+
+TEST(VEC3Testcase, VEC3NormalizeFastAndSafe) {
+	std::vector<vec3> directions;
+	for (int i = 1; i < 200; i++) {
+		directions.push_back({ (float)i * 0.37f, -(float)(i % 7) * 1.5f, 1000.f / (float)i });
+	}
+
+	std::vector<vec3> batched(directions.size());
+	vec3::normalizeFastMany(directions.data(), batched.data(), directions.size());
+
+	for (size_t i = 0; i < directions.size(); i++) {
+		const vec3 exact{ directions[i].normalize() };
+		const vec3 fast{ directions[i].normalizeFast() };
+		ASSERT_TRUE(basic::epsilonEqual(exact.x, fast.x, 1e-6f));
+		ASSERT_TRUE(basic::epsilonEqual(exact.y, fast.y, 1e-6f));
+		ASSERT_TRUE(basic::epsilonEqual(exact.z, fast.z, 1e-6f));
+		ASSERT_TRUE(batched[i] == fast);
+	}
+
+	const vec3 up{ 0.f, 1.f, 0.f };
+	ASSERT_TRUE(vec3::normalizeSafe(vec3{}, up) == up);
+	ASSERT_TRUE(vec3::normalizeSafe({ 0.f, 0.f, 2.f }, up) == vec3(0.f, 0.f, 1.f));
+	ASSERT_TRUE(vec2::normalizeSafe(vec2{}, vec2{ 1.f, 0.f }) == vec2(1.f, 0.f));
+	ASSERT_TRUE(vec4::normalizeSafe(vec4{}, vec4{ 0.f, 0.f, 0.f, 1.f }) == vec4(0.f, 0.f, 0.f, 1.f));
+	ASSERT_TRUE(std::isinf(basic::rsqrt(0.f)));
+	ASSERT_EQ(basic::rsqrt(INFINITY), 0.f);
+	ASSERT_TRUE(basic::rsqrt(1e-40f) > 1e19f); // denormal
+	const float edges[]{ 1e-40f, INFINITY, 4.f, 1e-40f, INFINITY };
+	float edgesRsqrt[5];
+	basic::rsqrtMany(edges, edgesRsqrt, 5);
+	for (size_t i = 0; i < 5; i++) {
+		ASSERT_EQ(edgesRsqrt[i], basic::rsqrt(edges[i]));
+	}
+	const vec3 tiny{ vec3::normalizeFast({ 1e-20f, 0.f, 0.f }) };
+	ASSERT_TRUE(tiny.x > 0.f);
+}
+
+TEST(MAT4Testcase, MAT4MultiplyManyAndPairwise) {
+	const mat4 viewProjection{ mat4::perspective(trig::toRadians(60.f), 16.f / 9.f, 0.1f, 100.f) * mat4::lookAt({ 1.f, 2.f, 3.f }, {}, { 0.f, 1.f, 0.f }) };
+	std::vector<mat4> models;
+	std::vector<mat4> parents;
+	for (size_t i = 0; i < 1001; i++) {
+		models.push_back(mat4::translation({ (float)i, 0.5f * (float)i, -1.f }) * mat4::rotation((float)i * 0.01f, { 0.f, 1.f, 0.f }));
+		parents.push_back(mat4::scale({ 1.f + (float)i * 0.001f, 2.f, 1.f }));
+	}
+
+	std::vector<mat4> out(models.size());
+	mat4::multiplyMany(viewProjection, models.data(), out.data(), models.size());
+	for (size_t i = 0; i < models.size(); i++) {
+		ASSERT_TRUE(out[i] == viewProjection * models[i]);
+	}
+
+	mat4::multiplyPairwise(parents.data(), models.data(), out.data(), models.size());
+	for (size_t i = 0; i < models.size(); i++) {
+		ASSERT_TRUE(out[i] == parents[i] * models[i]);
+	}
+
+	// in place, result is written to right array
+	std::vector<mat4> inPlace{ models };
+	mat4::multiplyPairwise(parents.data(), inPlace.data(), inPlace.data(), inPlace.size());
+	for (size_t i = 0; i < models.size(); i++) {
+		ASSERT_TRUE(inPlace[i] == out[i]);
+	}
+	ASSERT_EQ(mat4::value_ptr(out), out[0].elements);
+
+	std::array<maths::vec3, 2> positions{};
+	ASSERT_EQ(maths::vec3::value_ptr(positions), &positions[0].x);
+}
+
+TEST(STRIDEDVIEWTestcase, STRIDEDVIEWInterleavedInstanceBuffer) {
+	struct instance {
+		float model[16];
+		float color[4];
+		int custom;
+	};
+
+	const size_t count{ 67 };
+	std::vector<mat4> locals;
+	for (size_t i = 0; i < count; i++) {
+		locals.push_back(mat4::translation({ (float)i, 1.f, 2.f }));
+	}
+	const mat4 viewProjection{ mat4::perspective(1.f, 1.f, 0.1f, 10.f) };
+
+	std::vector<instance> buffer(count);
+	const stridedView<mat4> models{ buffer.data(), offsetof(instance, model), sizeof(instance), count };
+	const stridedView<vec4> colors{ buffer.data(), offsetof(instance, color), sizeof(instance), count };
+	colors.fill({ 1.f, 0.f, 0.f, 1.f });
+	for (size_t i = 0; i < count; i++) {
+		buffer[i].custom = (int)i;
+	}
+
+	mat4::multiplyMany(viewProjection, locals.data(), models);
+	for (size_t i = 0; i < count; i++) {
+		ASSERT_TRUE(models.get(i) == viewProjection * locals[i]);
+		ASSERT_TRUE((colors.get(i) == vec4{ 1.f, 0.f, 0.f, 1.f }));
+		ASSERT_EQ(buffer[i].custom, (int)i);
+	}
+
+	stridedWriter<mat4> writer{ models };
+	ASSERT_TRUE(writer.push(mat4::identity()));
+	mat4::multiplyPairwise(locals.data(), locals.data(), writer.remaining().subview(0, 10));
+	writer.advance(10);
+	ASSERT_EQ(writer.written, 11);
+	ASSERT_TRUE(models.get(0) == mat4::identity());
+	ASSERT_TRUE(models.get(1) == locals[0] * locals[0]);
+	ASSERT_TRUE(models.get(11) == viewProjection * locals[11]);
+}
+
+TEST(ARCHIVETestcase, ARCHIVEWriteAndMap) {
+	const char* path{ "marmaths_archive_test.bin" };
+
+	std::vector<mat4> poses;
+	std::vector<vec3> points;
+	std::vector<float> xs, ys;
+	for (size_t i = 0; i < 300; i++) {
+		poses.push_back(mat4::translation({ (float)i, 0.f, -(float)i }));
+		points.push_back({ (float)i, 2.f * (float)i, 3.f });
+		xs.push_back((float)i);
+		ys.push_back(-(float)i);
+	}
+	const quat orientation{ 1.f, 0.f, 0.f, 0.f };
+
+	archiveWriter writer;
+	writer.add("poses", poses.data(), poses.size());
+	writer.add("points", points.data(), points.size());
+	writer.add("orientation", &orientation, 1);
+	const float* lanes[]{ xs.data(), ys.data() };
+	writer.addSoA("soa", lanes, 2, xs.size());
+	ASSERT_TRUE(writer.write(path));
+
+	{
+		archive mapped;
+		ASSERT_TRUE(mapped.open(path, true));
+		ASSERT_EQ(mapped.chunkCount(), 4);
+
+		size_t count{ 0 };
+		const mat4* mappedPoses{ mapped.get<mat4>("poses", count) };
+		ASSERT_EQ(count, poses.size());
+		ASSERT_EQ((uintptr_t)mappedPoses % archive::alignment, 0);
+		for (size_t i = 0; i < count; i++) {
+			ASSERT_TRUE(mappedPoses[i] == poses[i]);
+		}
+
+		const vec3* mappedPoints{ mapped.get<vec3>("points", count) };
+		ASSERT_EQ(count, points.size());
+		ASSERT_TRUE(mappedPoints[299] == points[299]);
+		ASSERT_TRUE(mapped.get<quat>("orientation", count)->w == 1.f);
+		ASSERT_EQ(mapped.getLane("soa", 1, count)[7], -7.f);
+		ASSERT_EQ(mapped.get<vec3>("poses", count), nullptr); // wrong type
+		ASSERT_EQ(mapped.get<mat4>("missing", count), nullptr);
+	}
+
+	std::remove(path);
+}
+
+TEST(ARCHIVETestcase, ARCHIVERejectsCorrupted) {
+	const char* path{ "marmaths_archive_corrupted.bin" };
+	std::vector<vec3> points(10, vec3{ 1.f, 2.f, 3.f });
+	archiveWriter writer;
+	writer.add("pos", points.data(), points.size());
+	ASSERT_TRUE(writer.write(path));
+
+	std::vector<unsigned char> original;
+	{
+		FILE* file{ fopen(path, "rb") };
+		ASSERT_NE(file, nullptr);
+		unsigned char byte[256];
+		size_t n{ 0 };
+		while ((n = fread(byte, 1, sizeof(byte), file)) != 0) {
+			original.insert(original.end(), byte, byte + n);
+		}
+		fclose(file);
+	}
+	const auto opens = [path](const std::vector<unsigned char>& bytes) {
+		FILE* file{ fopen(path, "wb") };
+		fwrite(bytes.data(), 1, bytes.size(), file);
+		fclose(file);
+		archive mapped;
+		return mapped.open(path);
+	};
+	const auto patched = [&original](size_t offset, auto value) {
+		std::vector<unsigned char> bytes{ original };
+		memcpy(bytes.data() + offset, &value, sizeof(value));
+		return bytes;
+	};
+	const size_t chunkAt{ sizeof(archiveHeader) };
+
+	ASSERT_TRUE(opens(original));
+	ASSERT_FALSE(opens(patched(chunkAt + offsetof(archiveChunk, count), (uint64_t)(1ull << 62) + 10)));
+	ASSERT_FALSE(opens(patched(chunkAt + offsetof(archiveChunk, elementSize), (uint32_t)sizeof(float))));
+	ASSERT_FALSE(opens(patched(chunkAt + offsetof(archiveChunk, type), archiveType::Mat4)));
+	ASSERT_FALSE(opens(patched(chunkAt + offsetof(archiveChunk, lanes), (uint32_t)3))); // lane stride stays 0
+	ASSERT_FALSE(opens(patched(offsetof(archiveHeader, chunkTableOffset), ~(uint64_t)0 - 8)));
+	ASSERT_FALSE(opens(patched(offsetof(archiveHeader, chunkTableOffset), (uint64_t)sizeof(archiveHeader) + 4)));
+	ASSERT_FALSE(opens(patched(offsetof(archiveHeader, chunkCount), (uint32_t)0xFFFFFFFF)));
+
+	std::vector<unsigned char> truncated{ patched(offsetof(archiveHeader, fileSize), (uint64_t)(original.size() - 64)) };
+	truncated.resize(original.size() - 64);
+	ASSERT_FALSE(opens(truncated));
+
+	std::remove(path);
+}
+
+TEST(TEXTTestcase, TEXTRoundTrip) {
+	const maths::vec3 v{ 0.1f, -2.5e-7f, 123456.789f };
+	const maths::quat q{ 0.7071068f, 0.f, 0.7071068f, -0.f };
+	maths::mat4 m{ maths::mat4::perspective(maths::trig::toRadians(45.f), 1.77f, 0.1f, 1000.f) };
+	const maths::textStyle styles[]{ maths::textStyle::Plain, maths::textStyle::Csv, maths::textStyle::Json };
+
+	for (maths::textStyle style : styles) {
+		char buffer[maths::text::maxMat4Length];
+		char* end{ maths::text::format(buffer, buffer + sizeof(buffer), v, style) };
+		ASSERT_NE(end, nullptr);
+		maths::vec3 parsedVector;
+		ASSERT_EQ(maths::text::parse(buffer, end, parsedVector), end);
+		ASSERT_EQ(parsedVector, v);
+
+		end = maths::text::format(buffer, buffer + sizeof(buffer), q, style);
+		ASSERT_NE(end, nullptr);
+		maths::quat parsedQuat;
+		ASSERT_EQ(maths::text::parse(buffer, end, parsedQuat), end);
+		ASSERT_TRUE(parsedQuat.w == q.w && parsedQuat.x == q.x && parsedQuat.y == q.y && parsedQuat.z == q.z);
+
+		end = maths::text::format(buffer, buffer + sizeof(buffer), m, style);
+		ASSERT_NE(end, nullptr);
+		maths::mat4 parsedMatrix;
+		ASSERT_EQ(maths::text::parse(buffer, end, parsedMatrix), end);
+		ASSERT_EQ(parsedMatrix, m);
+	}
+
+	char small[4];
+	ASSERT_EQ(maths::text::format(small, small + sizeof(small), v), nullptr);
+
+	const char json[]{ "[1,2.5,-3]" };
+	char buffer[32];
+	char* end{ maths::text::format(buffer, buffer + sizeof(buffer), maths::vec3{ 1.f, 2.5f, -3.f }, maths::textStyle::Json) };
+	ASSERT_EQ(std::string(buffer, end), std::string(json));
+
+	maths::vec2 invalid;
+	const char garbage[]{ "1 x" };
+	ASSERT_EQ(maths::text::parse(garbage, garbage + 3, invalid), nullptr);
+}
+
+TEST(TEXTTestcase, TEXTWriterReader) {
+	std::vector<maths::vec4> values;
+	for (int i = 0; i < 1000; i++) {
+		values.push_back({ (float)i * 0.37f, -(float)i, 1.f / (float)(i + 1), 0.f });
+	}
+
+	std::string output;
+	size_t sinkCalls{ 0 };
+	{
+		maths::textWriter writer([&output, &sinkCalls](const char* data, size_t size) {
+			output.append(data, size);
+			sinkCalls++;
+		}, maths::textStyle::Csv, 512);
+		writer.write(values.data(), values.size());
+	}
+	ASSERT_TRUE(sinkCalls > 1);
+
+	maths::textReader reader(output.data(), output.data() + output.size());
+	std::vector<maths::vec4> parsed;
+	ASSERT_EQ(reader.readAll(parsed), values.size());
+	ASSERT_TRUE(reader.finished());
+	ASSERT_TRUE(parsed == values);
+}
+
+TEST(INSTRUMENTATIONTestcase, INSTRUMENTATIONCountersAndReset) {
+	maths::instrumentation::reset();
+	maths::instrumentation::record(maths::probe::Mat4Inverse, 1, 10);
+	maths::instrumentation::record(maths::probe::Mat4Inverse, 1, 20);
+	std::thread worker([]() {
+		maths::instrumentation::record(maths::probe::Mat4MultiplyMany, 256, 1000);
+	});
+	worker.join();
+
+	maths::probeRecord records[(size_t)maths::probe::Count];
+	ASSERT_EQ(maths::instrumentation::report(records), (size_t)maths::probe::Count);
+	const maths::probeRecord& inverse{ records[(size_t)maths::probe::Mat4Inverse] };
+	ASSERT_EQ(std::string(inverse.name), "mat4::inverse");
+	ASSERT_EQ(inverse.calls, 2u);
+	ASSERT_EQ(inverse.ticks, 30u);
+	const maths::probeRecord& many{ records[(size_t)maths::probe::Mat4MultiplyMany] };
+	ASSERT_EQ(many.calls, 1u);
+	ASSERT_EQ(many.elements, 256u);
+	ASSERT_EQ(many.maxBatch, 256u);
+
+	if (maths::instrumentation::enabled) {
+		const maths::mat4 m{ maths::mat4::translation({ 1.f, 2.f, 3.f }) };
+		(void)maths::mat4::inverse(m);
+		maths::instrumentation::report(records);
+		ASSERT_EQ(records[(size_t)maths::probe::Mat4Inverse].calls, 3u);
+	}
+
+	// longest probe name does not shift columns of dump
+	maths::instrumentation::record(maths::probe::DecompositionEigenSymmetricMany, 64, 500);
+	std::FILE* dumped{ std::tmpfile() };
+	ASSERT_NE(dumped, nullptr);
+	maths::instrumentation::dump(dumped);
+	std::rewind(dumped);
+	char line[256];
+	std::vector<size_t> lengths;
+	while (std::fgets(line, sizeof(line), dumped)) {
+		lengths.push_back(std::strlen(line));
+	}
+	std::fclose(dumped);
+	ASSERT_EQ(lengths.size(), 4u);
+	ASSERT_TRUE(std::all_of(lengths.begin(), lengths.end(), [&lengths](size_t l) { return l == lengths[0]; }));
+
+	maths::instrumentation::reset();
+	maths::instrumentation::report(records);
+	for (const maths::probeRecord& r : records) {
+		ASSERT_EQ(r.calls, 0u);
+	}
+}
+
+static maths::diagnostic g_trappedKind{ maths::diagnostic::Count };
+
+TEST(DIAGNOSTICSTestcase, DIAGNOSTICSChecksAndTraps) {
+	const float inf{ std::numeric_limits<float>::infinity() };
+	const float nan{ std::numeric_limits<float>::quiet_NaN() };
+	const float denormal{ std::numeric_limits<float>::denorm_min() };
+	const float values[]{ 1.f, inf, 0.f, -0.f, denormal, nan, -inf, 3.f, -denormal, 1e-37f, 2.f };
+	ASSERT_EQ(maths::diagnostics::countNonFinite(values, 11), 3u);
+	ASSERT_EQ(maths::diagnostics::countDenormals(values, 11), 2u);
+
+	maths::diagnostics::reset();
+	maths::diagnostics::setHandler([](maths::diagnostic kind, const char*, uint64_t) { g_trappedKind = kind; });
+	maths::diagnostics::raise(maths::diagnostic::DenormalInput, "test", 2);
+	ASSERT_EQ(g_trappedKind, maths::diagnostic::Count);
+	maths::diagnostics::setTrap(maths::diagnostic::SingularInverse, true);
+	maths::diagnostics::raise(maths::diagnostic::SingularInverse, "test");
+	ASSERT_EQ(g_trappedKind, maths::diagnostic::SingularInverse);
+	ASSERT_EQ(maths::diagnostics::count(maths::diagnostic::DenormalInput), 2u);
+	ASSERT_EQ(std::string(maths::diagnostics::lastWhere(maths::diagnostic::SingularInverse)), "test");
+
+	if (maths::diagnostics::enabled) {
+		maths::diagnostics::reset();
+		(void)maths::mat4::inverse(maths::mat4{});
+		ASSERT_EQ(maths::diagnostics::count(maths::diagnostic::SingularInverse), 1u);
+		ASSERT_TRUE(maths::diagnostics::count(maths::diagnostic::NonFiniteOutput) > 0u);
+		(void)maths::vec3::normalize(maths::vec3{});
+		ASSERT_EQ(maths::diagnostics::count(maths::diagnostic::ZeroLengthNormalize), 1u);
+	}
+	maths::diagnostics::setTrap(maths::diagnostic::SingularInverse, false);
+	maths::diagnostics::setHandler(nullptr);
+	maths::diagnostics::reset();
+}
+
+TEST(DIAGNOSTICSTestcase, DIAGNOSTICSFlushDenormalsInBatch) {
+	const maths::mat4 left{ 1e-20f };
+	const maths::mat4 right[2]{ maths::mat4{ 1e-20f }, maths::mat4{ 1.f } };
+	maths::mat4 out[2];
+
+	maths::mat4::multiplyMany(left, right, out, 2);
+	ASSERT_TRUE(out[0].elements[0] != 0.f);
+
+	maths::diagnostics::setFlushDenormals(true);
+	maths::mat4::multiplyMany(left, right, out, 2);
+	maths::diagnostics::setFlushDenormals(false);
+#if MARMATH_SIMD_SSE
+	ASSERT_EQ(out[0].elements[0], 0.f);
+#endif
+	ASSERT_EQ(out[1].elements[0], 1e-20f);
+
+	// mode is restored after batch
+	volatile float tiny{ 1e-20f };
+	ASSERT_TRUE(tiny * tiny != 0.f);
+}
+
+// Golden values below are raw Q16.16 results. They must be the same on every compiler,
+// optimization level and CPU, any difference breaks lockstep simulation.
+TEST(FIXEDTestcase, FIXEDDeterministicTrigAndSqrt) {
+	const int32_t angles[]{ 0, 1, 12345, 102944, -205887, 411775, 1000000, -3000000 };
+	const int32_t sines[]{ 0, 1, 12272, 65536, 0, 0, 28457, -63909 };
+	const int32_t cosines[]{ 65536, 65536, 64377, 0, -65536, 65536, -59035, -14510 };
+	for (size_t i = 0; i < 8; i++) {
+		const maths::fixed angle{ maths::fixed::fromRaw(angles[i]) };
+		ASSERT_EQ(maths::fixed::sine(angle).raw, sines[i]);
+		ASSERT_EQ(maths::fixed::cosine(angle).raw, cosines[i]);
+	}
+	ASSERT_EQ(maths::fixed::sqrt(maths::fixed::fromInt(2)).raw, 92681);
+
+	for (int32_t raw = -400000; raw <= 400000; raw += 997) {
+		const float radians{ (float)raw / 65536.f };
+		ASSERT_NEAR(maths::fixed::sine(maths::fixed::fromRaw(raw)).toFloat(), std::sin(radians), 3.f / 65536.f);
+		ASSERT_NEAR(maths::fixed::cosine(maths::fixed::fromRaw(raw)).toFloat(), std::cos(radians), 3.f / 65536.f);
+	}
+
+	ASSERT_EQ(maths::fixed::fromFloat(-1.5f).raw, -98304);
+	ASSERT_EQ((maths::fixed::fromInt(3) / maths::fixed::fromInt(2)).raw, 98304);
+	ASSERT_EQ((maths::fixed::fromInt(30000) * maths::fixed::fromInt(30000)).raw, INT32_MAX);
+
+	// sums of products near raw limits are exact or saturate, partial sums do not overflow
+	const maths::fixed maxValue{ maths::fixed::fromRaw(INT32_MAX) };
+	const maths::fixed minValue{ maths::fixed::fromRaw(INT32_MIN) };
+	maths::fixedMat4 large;
+	maths::fixedMat4 smallest;
+	for (size_t i = 0; i < 16; i++) {
+		large.elements[i] = maxValue;
+		smallest.elements[i] = minValue;
+	}
+	ASSERT_EQ((large * large).elements[5].raw, INT32_MAX);
+	ASSERT_EQ((smallest * smallest).elements[5].raw, INT32_MAX);
+	ASSERT_EQ((large * smallest).elements[5].raw, INT32_MIN);
+	maths::fixedMat4 mixed{ large };
+	mixed.elements[0 + 2 * 4] = minValue;
+	mixed.elements[0 + 3 * 4] = minValue;
+	// 2 * MAX * MAX + 2 * MAX * MIN = -2 * MAX, rounded
+	ASSERT_EQ((mixed * large).elements[0].raw, -65536);
+	ASSERT_EQ(maths::fixedVec3::dot({ maxValue, maxValue, minValue }, { maxValue, maxValue, maxValue }).raw, INT32_MAX);
+	ASSERT_EQ(maths::fixedVec3::dot({ minValue, minValue, minValue }, { maxValue, maxValue, maxValue }).raw, INT32_MIN);
+	const maths::fixedVec3 farPoint{ maxValue, maxValue, maxValue };
+	ASSERT_TRUE(large.transformPoint(farPoint) == maths::fixedVec3(maxValue, maxValue, maxValue));
+}
+
+TEST(FIXEDTestcase, FIXEDDeterministicSimulation) {
+	const maths::fixed one{ maths::fixed::one() };
+	const maths::fixedVec3 axis{ maths::fixedVec3::normalize({ one, maths::fixed::fromInt(2), maths::fixed::fromInt(3) }) };
+	const maths::fixedQuat step{ maths::fixedQuat::fromAxisAngle(axis, maths::fixed::fromFloat(0.01f)) };
+	const maths::fixedVec3 velocity{ maths::fixed::fromFloat(0.5f), maths::fixed::fromFloat(-0.25f), maths::fixed::fromFloat(0.125f) };
+	const maths::fixed dt{ maths::fixed::fromFloat(1.f / 60.f) };
+
+	maths::fixedQuat q;
+	maths::fixedVec3 p{ one, maths::fixed(), maths::fixed() };
+	uint64_t hash{ 1469598103934665603ull };
+	const auto mix = [&hash](int32_t value) {
+		hash ^= (uint32_t)value;
+		hash *= 1099511628211ull;
+	};
+	for (int i = 0; i < 1000; i++) {
+		q = maths::fixedQuat::normalize(step * q);
+		p = p + velocity * dt;
+		const maths::fixedMat4 m{ maths::fixedMat4::transform(p, q, { one, maths::fixed::fromInt(2), one }) };
+		const maths::fixedVec3 w{ m.transformPoint({ one, one, one }) };
+		mix(w.x.raw);
+		mix(w.y.raw);
+		mix(w.z.raw);
+		mix(q.w.raw);
+	}
+	ASSERT_EQ(hash, 14221507250485191176ull);
+	ASSERT_TRUE(q == maths::fixedQuat(maths::fixed::fromRaw(17839), maths::fixed::fromRaw(-16857),
+		maths::fixed::fromRaw(-33818), maths::fixed::fromRaw(-50486)));
+	ASSERT_TRUE(p == maths::fixedVec3(maths::fixed::fromRaw(611536), maths::fixed::fromRaw(-273000), maths::fixed::fromRaw(137000)));
+
+	const maths::fixedVec3 rotated{ maths::fixedQuat::rotate(q, { one, maths::fixed(), maths::fixed() }) };
+	ASSERT_TRUE(rotated == maths::fixedVec3(maths::fixed::fromRaw(-47150), maths::fixed::fromRaw(-10088), maths::fixed::fromRaw(44383)));
+
+	// batch and scalar transforms return the same bits
+	const maths::fixedMat4 m{ maths::fixedMat4::transform(p, q, { one, one, one }) };
+	maths::fixedVec3 points[3]{ p, rotated, { one, one, one } };
+	maths::fixedVec3 expected[3];
+	for (size_t i = 0; i < 3; i++) {
+		expected[i] = m.transformPoint(points[i]);
+	}
+	maths::fixedMat4::transformPoints(m, points, points, 3);
+	for (size_t i = 0; i < 3; i++) {
+		ASSERT_TRUE(points[i] == expected[i]);
+	}
+}
+
+TEST(CAMERATestcase, CAMERACachedMatricesAndFrustum) {
+	maths::camera cam;
+	cam.setPerspective(maths::trig::toRadians(60.f), 16.f / 9.f, 0.1f, 100.f);
+	cam.setLookAt({ 1.f, 2.f, 3.f }, { 1.f, 2.f, -10.f }, { 0.f, 1.f, 0.f });
+	ASSERT_TRUE(cam.isDirty());
+
+	const maths::mat4 view{ maths::mat4::lookAt({ 1.f, 2.f, 3.f }, { 1.f, 2.f, -10.f }, { 0.f, 1.f, 0.f }) };
+	const maths::mat4 projection{ maths::mat4::perspective(maths::trig::toRadians(60.f), 16.f / 9.f, 0.1f, 100.f) };
+	ASSERT_EQ(cam.getView(), view);
+	ASSERT_EQ(cam.getViewProjection(), projection * view);
+
+	const maths::mat4 identityView{ cam.getInverseView() * cam.getView() };
+	const maths::mat4 identityViewProjection{ cam.getInverseViewProjection() * cam.getViewProjection() };
+	for (size_t i = 0; i < 16; i++) {
+		const float expected{ i % 5 == 0 ? 1.f : 0.f };
+		ASSERT_NEAR(identityView.elements[i], expected, 1e-5f);
+		ASSERT_NEAR(identityViewProjection.elements[i], expected, 1e-3f);
+	}
+
+	const maths::frustum& f{ cam.getFrustum() };
+	ASSERT_TRUE(f.containsPoint({ 1.f, 2.f, -5.f }));
+	ASSERT_FALSE(f.containsPoint({ 1.f, 2.f, 5.f }));
+	ASSERT_FALSE(f.containsPoint({ 1.f, 2.f, -200.f }));
+	ASSERT_TRUE(f.intersectsSphere({ 1.f, 2.f, 3.5f }, 1.f));
+	ASSERT_FALSE(f.intersectsSphere({ 100.f, 2.f, -5.f }, 1.f));
+	ASSERT_FALSE(cam.isDirty());
+
+	// unchanged inputs don't dirty anything
+	cam.setLookAt({ 1.f, 2.f, 3.f }, { 1.f, 2.f, -10.f }, { 0.f, 1.f, 0.f });
+	cam.setPerspective(maths::trig::toRadians(60.f), 16.f / 9.f, 0.1f, 100.f);
+	ASSERT_FALSE(cam.isDirty());
+
+	std::vector<maths::camera> cameras(40, cam);
+	for (size_t i = 0; i < cameras.size(); i++) {
+		cameras[i].setLookAt({ (float)i, 0.f, 0.f }, { (float)i, 0.f, -1.f }, { 0.f, 1.f, 0.f });
+	}
+	maths::camera::updateMany(cameras.data(), cameras.size());
+	for (maths::camera& c : cameras) {
+		ASSERT_FALSE(c.isDirty());
+	}
+	ASSERT_EQ(cameras[7].getInverseView().getColumn3(3), maths::vec3(7.f, 0.f, 0.f));
+}
+
+static float projectedDepth(const maths::mat4& projection, float viewZ) {
+	const maths::vec4 clip{ projection * maths::vec4(0.f, 0.f, viewZ, 1.f) };
+	return clip.z / clip.w;
+}
+
+TEST(MAT4Testcase, MAT4DepthRangesOfProjections) {
+	const float fov{ maths::trig::toRadians(60.f) };
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspective(fov, 1.5f, 0.1f, 100.f), -0.1f), -1.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspective(fov, 1.5f, 0.1f, 100.f), -100.f), 1.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveZeroToOne(fov, 1.5f, 0.1f, 100.f), -0.1f), 0.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveZeroToOne(fov, 1.5f, 0.1f, 100.f), -100.f), 1.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveReversedZ(fov, 1.5f, 0.1f, 100.f), -0.1f), 1.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveReversedZ(fov, 1.5f, 0.1f, 100.f), -100.f), 0.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveInfinite(fov, 1.5f, 0.1f), -0.1f), -1.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveInfinite(fov, 1.5f, 0.1f), -1e7f), 1.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveInfiniteReversedZ(fov, 1.5f, 0.1f), -0.1f), 1.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::perspectiveInfiniteReversedZ(fov, 1.5f, 0.1f), -1e7f), 0.f, 1e-4f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::orthographic(-1.f, 1.f, 1.f, -1.f, 1.f, 50.f), -1.f), -1.f, 1e-5f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::orthographic(-1.f, 1.f, 1.f, -1.f, 1.f, 50.f), -50.f), 1.f, 1e-5f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::orthographicZeroToOne(-1.f, 1.f, 1.f, -1.f, 1.f, 50.f), -1.f), 0.f, 1e-5f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::orthographicZeroToOne(-1.f, 1.f, 1.f, -1.f, 1.f, 50.f), -50.f), 1.f, 1e-5f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::orthographicReversedZ(-1.f, 1.f, 1.f, -1.f, 1.f, 50.f), -1.f), 1.f, 1e-5f);
+	ASSERT_NEAR(projectedDepth(maths::mat4::orthographicReversedZ(-1.f, 1.f, 1.f, -1.f, 1.f, 50.f), -50.f), 0.f, 1e-5f);
+
+	const maths::vec4 moved{ maths::mat4::translation({ 1.f, 2.f, 3.f }) * maths::vec4(1.f, 1.f, 1.f, 1.f) };
+	ASSERT_EQ(moved, maths::vec4(2.f, 3.f, 4.f, 1.f));
+}
+
+TEST(SHADOWCASCADESTestcase, SHADOWCASCADESFitAndSnap) {
+	float splits[5];
+	maths::shadowCascades::splitDistances(0.1f, 200.f, 0.7f, splits, 4);
+	ASSERT_EQ(splits[0], 0.1f);
+	ASSERT_EQ(splits[4], 200.f);
+	for (size_t i = 0; i < 4; i++) {
+		ASSERT_TRUE(splits[i] < splits[i + 1]);
+	}
+
+	const float fov{ maths::trig::toRadians(60.f) };
+	const float aspectRatio{ 16.f / 9.f };
+	const float resolution{ 2048.f };
+	const maths::mat4 view{ maths::mat4::lookAt({ 10.3f, 5.7f, -3.1f }, { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }) };
+	const maths::mat4 inverseView{ maths::mat4::inverse(view) };
+	maths::cascade cascades[4];
+	maths::shadowCascades::compute(inverseView, fov, aspectRatio, 0.1f, 200.f, { -1.f, -2.f, -0.5f }, 0.7f, resolution, cascades, 4);
+
+	const float tanHalfFov{ std::tan(fov / 2.f) };
+	for (const maths::cascade& c : cascades) {
+		// slice corners are inside bounding sphere and inside light frustum
+		for (float depth : { c.splitNear, c.splitFar }) {
+			for (float sx : { -1.f, 1.f }) {
+				for (float sy : { -1.f, 1.f }) {
+					const maths::vec4 corner{ inverseView * maths::vec4(sx * depth * tanHalfFov * aspectRatio, sy * depth * tanHalfFov, -depth, 1.f) };
+					const maths::vec3 world{ corner.x, corner.y, corner.z };
+					ASSERT_TRUE(maths::vec3::length(world - c.center) <= c.radius * 1.001f);
+					const maths::vec4 clip{ c.viewProjection * corner };
+					ASSERT_TRUE(std::fabs(clip.x) <= 1.01f && std::fabs(clip.y) <= 1.01f && std::fabs(clip.z) <= 1.01f);
+				}
+			}
+		}
+
+		// world origin lands on whole texel
+		const float texelX{ c.viewProjection.elements[0 + 3 * 4] * resolution * 0.5f };
+		ASSERT_NEAR(texelX, std::round(texelX), 1e-2f);
+	}
+
+	// occluder between light and bounding sphere is clipped, unless casters are extended towards light
+	const maths::vec3 lightDirection{ maths::vec3::normalize({ -1.f, -2.f, -0.5f }) };
+	maths::cascade extended[4];
+	maths::shadowCascades::compute(inverseView, fov, aspectRatio, 0.1f, 200.f, lightDirection, 0.7f, resolution, extended, 4, false, 100.f);
+	for (size_t i = 0; i < 4; i++) {
+		const maths::vec3 occluderWorld{ cascades[i].center - lightDirection * (cascades[i].radius + 50.f) };
+		const maths::vec4 occluder{ occluderWorld.x, occluderWorld.y, occluderWorld.z, 1.f };
+		ASSERT_TRUE((cascades[i].viewProjection * occluder).z < -1.f);
+		const maths::vec4 clip{ extended[i].viewProjection * occluder };
+		ASSERT_TRUE(std::fabs(clip.z) <= 1.f);
+
+		// extension keeps xy projection and snapping of cascade
+		const maths::vec4 receiver{ cascades[i].center.x, cascades[i].center.y, cascades[i].center.z, 1.f };
+		const maths::vec4 a{ cascades[i].viewProjection * receiver };
+		const maths::vec4 b{ extended[i].viewProjection * receiver };
+		ASSERT_NEAR(a.x, b.x, 1e-4f);
+		ASSERT_NEAR(a.y, b.y, 1e-4f);
+		ASSERT_TRUE(std::fabs(b.z) <= 1.f);
+	}
+}
+
+TEST(MAT3Testcase, MAT3InverseAndNormalMatrix) {
+	const maths::quat q{ maths::quat(maths::vec3(0.3f, -1.1f, 0.7f)) };
+	const maths::mat3 rotation{ maths::mat3::fromQuat(q) };
+	ASSERT_EQ(rotation, maths::mat3(maths::quat::rotationFromQuat(q)));
+	ASSERT_NEAR(maths::mat3::determinant(rotation), 1.f, 1e-5f);
+
+	const maths::mat3 m{ maths::mat3(maths::mat4::rotation(0.4f, { 1.f, 2.f, 3.f }) * maths::mat4::scale({ 2.f, 0.5f, 3.f })) };
+	const maths::mat3 product{ m * maths::mat3::inverse(m) };
+	for (size_t i = 0; i < 9; i++) {
+		ASSERT_NEAR(product[i], maths::mat3::identity()[i], 1e-5f);
+	}
+
+	// normal matrix matches inverse-transpose of mat4 for non-uniform scale and uniform scale fast path
+	std::vector<maths::mat4> models;
+	for (size_t i = 0; i < 37; i++) {
+		const float f{ (float)i };
+		models.push_back(maths::mat4::translation({ f, -f, 2.f * f })
+			* maths::mat4::rotation(0.1f * f, { 1.f, f, 2.f })
+			* maths::mat4::scale({ 1.f + f, 2.f, 0.5f + 0.1f * f }));
+	}
+	std::vector<maths::mat3> normals(models.size());
+	maths::mat3::normalMatrixMany(models.data(), normals.data(), models.size());
+	for (size_t i = 0; i < models.size(); i++) {
+		maths::mat4 expected{ maths::mat4::inverse(models[i]) };
+		expected.transpose();
+		const maths::mat3 single{ maths::mat3::normalMatrix(models[i]) };
+		for (size_t col = 0; col < 3; col++) {
+			for (size_t row = 0; row < 3; row++) {
+				ASSERT_NEAR(normals[i][row + col * 3], expected[row + col * 4], 1e-4f);
+				ASSERT_NEAR(single[row + col * 3], expected[row + col * 4], 1e-4f);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < models.size(); i++) {
+		const float f{ (float)i };
+		models[i] = maths::mat4::translation({ f, 1.f, 2.f }) * maths::mat4::rotation(0.1f * f, { 1.f, f, 2.f }) * maths::mat4::scale({ 0.5f + f, 0.5f + f, 0.5f + f });
+	}
+	std::vector<maths::mat3> uniformNormals(models.size());
+	maths::mat3::normalMatrixMany(models.data(), normals.data(), models.size());
+	maths::mat3::normalMatrixMany(models.data(), uniformNormals.data(), models.size(), true);
+	for (size_t i = 0; i < models.size(); i++) {
+		for (size_t j = 0; j < 9; j++) {
+			ASSERT_NEAR(uniformNormals[i][j], normals[i][j], 1e-4f);
+		}
+	}
+}
+
+TEST(AFFINE2Testcase, AFFINE2TransformsAndRotors) {
+	const maths::rotor2 r{ maths::rotor2::fromAngle(0.7f) };
+	ASSERT_NEAR(r.angle(), 0.7f, 1e-6f);
+	ASSERT_NEAR((r * maths::rotor2::inverse(r)).c, 1.f, 1e-6f);
+	const maths::rotor2 between{ maths::rotor2::between({ 1.f, 0.f }, { 0.f, 1.f }) };
+	ASSERT_NEAR(between.angle(), maths::trig::toRadians(90.f), 1e-6f);
+	ASSERT_NEAR(maths::rotor2::nlerp(maths::rotor2(), between, 0.5f).angle(), maths::trig::toRadians(45.f), 1e-6f);
+
+	const maths::affine2 a{ maths::affine2::compose({ 3.f, -2.f }, r, { 2.f, 0.5f }) };
+	const maths::affine2 products{ maths::affine2::translation({ 3.f, -2.f }) * maths::affine2::rotation(0.7f) * maths::affine2::scale({ 2.f, 0.5f }) };
+	const maths::mat4 m4{ maths::mat4::translation({ 3.f, -2.f, 0.f }) * maths::mat4::rotation(0.7f, { 0.f, 0.f, 1.f }) * maths::mat4::scale({ 2.f, 0.5f, 1.f }) };
+	const maths::vec2 p{ 1.5f, -4.f };
+	const maths::vec4 expected{ m4 * maths::vec4(p.x, p.y, 0.f, 1.f) };
+	ASSERT_NEAR((a * p).x, expected.x, 1e-5f);
+	ASSERT_NEAR((a * p).y, expected.y, 1e-5f);
+	ASSERT_NEAR((products * p).x, expected.x, 1e-5f);
+	ASSERT_NEAR((products * p).y, expected.y, 1e-5f);
+	ASSERT_NEAR((maths::affine2::inverse(a) * (a * p)).x, p.x, 1e-5f);
+	ASSERT_NEAR((maths::affine2::inverse(a) * (a * p)).y, p.y, 1e-5f);
+
+	const maths::mat4 ortho{ maths::mat4::orthographic(0.f, 800.f, 600.f, 0.f, -1.f, 1.f) };
+	const maths::vec4 clip{ ortho * maths::vec4(200.f, 450.f, 0.f, 1.f) };
+	const maths::vec2 ndc{ maths::affine2::orthographic(0.f, 800.f, 600.f, 0.f) * maths::vec2(200.f, 450.f) };
+	ASSERT_NEAR(ndc.x, clip.x, 1e-6f);
+	ASSERT_NEAR(ndc.y, clip.y, 1e-6f);
+}
+
+TEST(SPRITETestcase, SPRITEQuadVerticesMany) {
+	constexpr size_t count{ 23 };
+	std::vector<float> lanes[8];
+	for (size_t i = 0; i < count; i++) {
+		const float f{ (float)i };
+		const maths::rotor2 r{ maths::rotor2::fromAngle(0.3f * f) };
+		lanes[0].push_back(10.f * f);
+		lanes[1].push_back(-5.f * f);
+		lanes[2].push_back(r.c);
+		lanes[3].push_back(r.s);
+		lanes[4].push_back(1.f + f);
+		lanes[5].push_back(2.f + 0.5f * f);
+		lanes[6].push_back(0.5f);
+		lanes[7].push_back((float)(i % 3) * 0.5f);
+	}
+	const maths::spriteArrays sprites{ lanes[0].data(), lanes[1].data(), lanes[2].data(), lanes[3].data(),
+		lanes[4].data(), lanes[5].data(), lanes[6].data(), lanes[7].data(), count };
+	const maths::affine2 view{ maths::affine2::orthographic(0.f, 800.f, 600.f, 0.f) * maths::affine2::translation({ 7.f, 3.f }) };
+	std::vector<maths::vec2> vertices(count * 4);
+	maths::sprite::quadVerticesMany(view, sprites, vertices.data());
+
+	const maths::vec2 corners[4]{ { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
+	for (size_t i = 0; i < count; i++) {
+		const maths::affine2 model{ maths::affine2::translation({ lanes[0][i], lanes[1][i] })
+			* maths::affine2::rotation(maths::rotor2(lanes[2][i], lanes[3][i]))
+			* maths::affine2::scale({ lanes[4][i], lanes[5][i] })
+			* maths::affine2::translation({ -lanes[6][i], -lanes[7][i] }) };
+		for (size_t k = 0; k < 4; k++) {
+			const maths::vec2 expected{ view * (model * corners[k]) };
+			ASSERT_NEAR(vertices[i * 4 + k].x, expected.x, 1e-5f);
+			ASSERT_NEAR(vertices[i * 4 + k].y, expected.y, 1e-5f);
+		}
+	}
+}
+
+TEST(AABBTestcase, AABBBoundsAndTransform) {
+	const maths::vec3 points[]{ { 1.f, -2.f, 3.f }, { -4.f, 5.f, 0.f }, { 2.f, 2.f, -6.f } };
+	const maths::aabb box{ maths::aabb::fromPoints(points, 3) };
+	ASSERT_EQ(box, maths::aabb({ -4.f, -2.f, -6.f }, { 2.f, 5.f, 3.f }));
+	ASSERT_TRUE(maths::aabb().isEmpty());
+	ASSERT_TRUE(box.contains({ 0.f, 0.f, 0.f }));
+	ASSERT_FALSE(box.contains({ 0.f, 6.f, 0.f }));
+	ASSERT_TRUE(maths::aabb::intersects(box, maths::aabb({ 2.f, 5.f, 3.f }, { 9.f, 9.f, 9.f })));
+	ASSERT_FALSE(maths::aabb::intersects(box, maths::aabb({ 2.1f, 0.f, 0.f }, { 9.f, 9.f, 9.f })));
+	ASSERT_EQ(box.surfaceArea(), 2.f * (6.f * 7.f + 7.f * 9.f + 9.f * 6.f));
+
+	const maths::mat4 transform{ maths::mat4::translation({ 1.f, 2.f, 3.f }) * maths::mat4::rotation(0.5f, { 1.f, 1.f, 0.f }) };
+	const maths::aabb transformed{ maths::aabb::transform(box, transform) };
+	maths::aabb expected;
+	for (size_t i = 0; i < 8; i++) {
+		const maths::vec4 corner{ transform * maths::vec4(
+			i & 1 ? box.maximum.x : box.minimum.x,
+			i & 2 ? box.maximum.y : box.minimum.y,
+			i & 4 ? box.maximum.z : box.minimum.z, 1.f) };
+		expected.expand({ corner.x, corner.y, corner.z });
+	}
+	ASSERT_NEAR(transformed.minimum.x, expected.minimum.x, 1e-5f);
+	ASSERT_NEAR(transformed.minimum.z, expected.minimum.z, 1e-5f);
+	ASSERT_NEAR(transformed.maximum.y, expected.maximum.y, 1e-5f);
+}
+
+TEST(SPATIALCODETestcase, SPATIALCODEEncodeDecode) {
+	ASSERT_EQ(maths::spatialCode::morton30(1, 0, 0), 4u);
+	ASSERT_EQ(maths::spatialCode::morton30(1023, 1023, 1023), (1u << 30) - 1);
+	ASSERT_EQ(maths::spatialCode::morton63(0x1FFFFF, 0x1FFFFF, 0x1FFFFF), (1ull << 63) - 1);
+	ASSERT_EQ(maths::spatialCode::morton64(0xFFFFFFFF, 0), 0xAAAAAAAAAAAAAAAAull);
+
+	for (uint32_t i = 0; i < 1000; i++) {
+		const uint32_t x{ (i * 7919u) & 0x3FF };
+		const uint32_t y{ (i * 104729u) & 0x3FF };
+		const uint32_t z{ (i * 1299709u) & 0x3FF };
+		uint32_t dx, dy, dz;
+		maths::spatialCode::decodeMorton30(maths::spatialCode::morton30(x, y, z), dx, dy, dz);
+		ASSERT_TRUE(dx == x && dy == y && dz == z);
+		maths::spatialCode::decodeHilbert30(maths::spatialCode::hilbert30(x, y, z), dx, dy, dz);
+		ASSERT_TRUE(dx == x && dy == y && dz == z);
+		maths::spatialCode::decodeHilbert63(maths::spatialCode::hilbert63(x << 11, y << 9, z), dx, dy, dz);
+		ASSERT_TRUE(dx == x << 11 && dy == y << 9 && dz == z);
+		maths::spatialCode::decodeMorton64(maths::spatialCode::morton64(x * 4000000u, y), dx, dy);
+		ASSERT_TRUE(dx == x * 4000000u && dy == y);
+		maths::spatialCode::decodeHilbert64(maths::spatialCode::hilbert64(x * 4000000u, y), dx, dy);
+		ASSERT_TRUE(dx == x * 4000000u && dy == y);
+	}
+
+	// consecutive Hilbert codes are neighbouring cells
+	uint32_t previous[3]{ 0, 0, 0 };
+	for (uint32_t code = 1; code < 4096; code++) {
+		uint32_t cell[3];
+		maths::spatialCode::decodeHilbert30(code, cell[0], cell[1], cell[2]);
+		uint32_t distance{ 0 };
+		for (size_t axis = 0; axis < 3; axis++) {
+			distance += cell[axis] > previous[axis] ? cell[axis] - previous[axis] : previous[axis] - cell[axis];
+			previous[axis] = cell[axis];
+		}
+		ASSERT_EQ(distance, 1u);
+	}
+	uint32_t previous2[2]{ 0, 0 };
+	for (uint32_t code = 1; code < 4096; code++) {
+		uint32_t cell[2];
+		maths::spatialCode::decodeHilbert32(code, cell[0], cell[1]);
+		ASSERT_EQ((cell[0] > previous2[0] ? cell[0] - previous2[0] : previous2[0] - cell[0]) + (cell[1] > previous2[1] ? cell[1] - previous2[1] : previous2[1] - cell[1]), 1u);
+		previous2[0] = cell[0];
+		previous2[1] = cell[1];
+	}
+}
+
+TEST(SPATIALCODETestcase, SPATIALCODESortPoints) {
+	std::vector<maths::vec3> points;
+	std::vector<maths::vec2> points2;
+	for (size_t i = 0; i < 10007; i++) {
+		const float f{ (float)i };
+		points.push_back({ std::sin(f) * 100.f, std::cos(f * 1.3f) * 50.f, std::sin(f * 0.7f) * 10.f });
+		points2.push_back({ points.back().x, points.back().y });
+	}
+	points[5].x = std::nanf("");
+	const maths::aabb bounds{ { -100.f, -50.f, -10.f }, { 100.f, 50.f, 10.f } };
+
+	std::vector<uint32_t> codes(points.size());
+	maths::spatialCode::morton30Many(points.data(), points.size(), bounds, codes.data());
+	std::vector<uint32_t> codes2(points.size());
+	maths::spatialCode::morton32Many(points2.data(), points2.size(), { -100.f, -50.f }, { 100.f, 50.f }, codes2.data());
+	std::vector<uint64_t> hilbert(points.size());
+	maths::spatialCode::hilbert63Many(points.data(), points.size(), bounds, hilbert.data());
+	std::vector<uint64_t> hilbert2(points.size());
+	maths::spatialCode::hilbert64Many(points2.data(), points2.size(), { -100.f, -50.f }, { 100.f, 50.f }, hilbert2.data());
+	for (size_t i = 0; i < points.size(); i++) {
+		const maths::vec3 p{ points[i] };
+		const auto cell = [](float value, float minimum, float maximum) {
+			float q{ (value - minimum) * (1024.f / (maximum - minimum)) };
+			q = q > 0.f ? q : 0.f;
+			return (uint32_t)(q < 1023.f ? q : 1023.f);
+		};
+		ASSERT_EQ(codes[i], maths::spatialCode::morton30(cell(p.x, -100.f, 100.f), cell(p.y, -50.f, 50.f), cell(p.z, -10.f, 10.f)));
+		uint32_t x, y;
+		maths::spatialCode::decodeMorton32(codes2[i], x, y);
+		uint32_t hx, hy, hz;
+		maths::spatialCode::decodeHilbert63(hilbert[i], hx, hy, hz);
+		ASSERT_EQ(hx >> 11, cell(p.x, -100.f, 100.f));
+		ASSERT_EQ(hz >> 11, cell(p.z, -10.f, 10.f));
+		ASSERT_EQ(x >> 6, cell(points2[i].x, -100.f, 100.f));
+		ASSERT_EQ(y >> 6, cell(points2[i].y, -50.f, 50.f));
+		maths::spatialCode::decodeHilbert64(hilbert2[i], hx, hy);
+		ASSERT_EQ(hy >> 22, cell(p.y, -50.f, 50.f));
+	}
+
+	// batch decoders return cell centers, which encode back to the same codes
+	std::vector<maths::vec3> decoded(points.size());
+	std::vector<maths::vec2> decoded2(points.size());
+	std::vector<uint32_t> reencoded(points.size());
+	std::vector<uint64_t> reencoded64(points.size());
+	maths::spatialCode::decodeMorton30Many(codes.data(), codes.size(), bounds, decoded.data());
+	maths::spatialCode::morton30Many(decoded.data(), decoded.size(), bounds, reencoded.data());
+	ASSERT_TRUE(reencoded == codes);
+	maths::spatialCode::decodeHilbert63Many(hilbert.data(), hilbert.size(), bounds, decoded.data());
+	maths::spatialCode::hilbert63Many(decoded.data(), decoded.size(), bounds, reencoded64.data());
+	ASSERT_TRUE(reencoded64 == hilbert);
+	maths::spatialCode::decodeMorton32Many(codes2.data(), codes2.size(), { -100.f, -50.f }, { 100.f, 50.f }, decoded2.data());
+	maths::spatialCode::morton32Many(decoded2.data(), decoded2.size(), { -100.f, -50.f }, { 100.f, 50.f }, reencoded.data());
+	ASSERT_TRUE(reencoded == codes2);
+	maths::spatialCode::decodeHilbert64Many(hilbert2.data(), hilbert2.size(), { -100.f, -50.f }, { 100.f, 50.f }, decoded2.data());
+	for (size_t i = 0; i < points.size(); i++) {
+		if (i != 5) { // NaN went to cell 0
+			ASSERT_NEAR(decoded2[i].x, points2[i].x, 1e-4f);
+			ASSERT_NEAR(decoded2[i].y, points2[i].y, 1e-4f);
+		}
+	}
+
+	for (size_t threads : { 1, 4 }) {
+		maths::parallel::setThreadCount(threads);
+		std::vector<uint32_t> order(codes.size());
+		std::vector<uint32_t> sorted(codes.size());
+		maths::radixSort::sort(codes.data(), order.data(), codes.size(), sorted.data());
+		for (size_t i = 1; i < order.size(); i++) {
+			ASSERT_EQ(sorted[i], codes[order[i]]);
+			ASSERT_TRUE(codes[order[i - 1]] < codes[order[i]] || (codes[order[i - 1]] == codes[order[i]] && order[i - 1] < order[i]));
+		}
+
+		std::vector<uint32_t> order64(hilbert.size());
+		maths::radixSort::sort(hilbert.data(), order64.data(), hilbert.size());
+		for (size_t i = 1; i < order64.size(); i++) {
+			ASSERT_TRUE(hilbert[order64[i - 1]] <= hilbert[order64[i]]);
+		}
+
+		// reused scratch must give the same order as own buffers, for both key widths
+		maths::radixSort::buffers scratch;
+		std::vector<uint32_t> reused(codes.size());
+		for (size_t run = 0; run < 2; run++) {
+			maths::radixSort::sort(codes.data(), reused.data(), codes.size(), scratch);
+			ASSERT_EQ(reused, order);
+			maths::radixSort::sort(hilbert.data(), reused.data(), hilbert.size(), scratch);
+			ASSERT_EQ(reused, order64);
+		}
+
+		std::vector<float> lanes[2]{ std::vector<float>(points.size()), std::vector<float>(points.size()) };
+		std::vector<float> sortedLanes[2]{ std::vector<float>(points.size()), std::vector<float>(points.size()) };
+		for (size_t i = 0; i < points.size(); i++) {
+			lanes[0][i] = points[i].y;
+			lanes[1][i] = points[i].z;
+		}
+		const float* in[2]{ lanes[0].data(), lanes[1].data() };
+		float* out[2]{ sortedLanes[0].data(), sortedLanes[1].data() };
+		maths::radixSort::gatherSoA(order.data(), in, out, 2, points.size());
+		std::vector<maths::vec3> sortedPoints(points.size());
+		maths::radixSort::gather(order.data(), points.data(), sortedPoints.data(), points.size());
+		for (size_t i = 0; i < points.size(); i++) {
+			ASSERT_EQ(sortedLanes[0][i], sortedPoints[i].y);
+			ASSERT_EQ(sortedLanes[1][i], sortedPoints[i].z);
+		}
+	}
+	maths::parallel::setThreadCount(1);
+}
+
+TEST(SPATIALHASHTestcase, SPATIALHASHMatchesBruteForce) {
+	std::vector<maths::vec3> points;
+	for (size_t i = 0; i < 5003; i++) {
+		const float f{ (float)i };
+		points.push_back({ std::sin(f * 1.7f) * 40.f, std::cos(f * 0.3f) * 40.f, std::sin(f * 2.9f) * 5.f - 20.f });
+	}
+	std::vector<maths::vec3> centers;
+	for (size_t i = 0; i < 300; i++) {
+		centers.push_back(points[i * 13] + maths::vec3(0.5f, -0.25f, 0.125f));
+	}
+	const float radius{ 3.f };
+	const size_t k{ 7 };
+
+	std::vector<uint32_t> expectedOffsets{ 0 };
+	std::vector<uint32_t> expectedNeighbors;
+	std::vector<uint32_t> expectedNearest;
+	for (const maths::vec3& c : centers) {
+		std::vector<std::pair<float, uint32_t>> all;
+		for (uint32_t i = 0; i < points.size(); i++) {
+			const maths::vec3 d{ points[i] - c };
+			all.push_back({ d.x * d.x + d.y * d.y + d.z * d.z, i });
+		}
+		std::sort(all.begin(), all.end());
+		for (size_t i = 0; i < k; i++) {
+			expectedNearest.push_back(all[i].second);
+		}
+		std::vector<uint32_t> within;
+		for (const auto& a : all) {
+			if (a.first <= radius * radius) {
+				within.push_back(a.second);
+			}
+		}
+		std::sort(within.begin(), within.end());
+		expectedNeighbors.insert(expectedNeighbors.end(), within.begin(), within.end());
+		expectedOffsets.push_back((uint32_t)expectedNeighbors.size());
+	}
+
+	std::vector<uint32_t> firstRun;
+	for (size_t threads : { 1, 4 }) {
+		maths::parallel::setThreadCount(threads);
+		maths::parallel::setGrainSize(256);
+		ASSERT_EQ(maths::parallel::grainSize(16), 16u);
+		ASSERT_EQ(maths::parallel::grainSize(1000), 1u);
+		maths::spatialHash grid{ 2.5f };
+		grid.build(points.data(), points.size());
+		grid.build(points.data(), points.size());
+		ASSERT_EQ(grid.size(), points.size());
+
+		std::vector<uint32_t> offsets, neighbors;
+		grid.queryRadiusMany(centers.data(), centers.size(), radius, offsets, neighbors);
+		ASSERT_EQ(offsets, expectedOffsets);
+		for (size_t i = 0; i < centers.size(); i++) {
+			std::vector<uint32_t> found(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+			std::sort(found.begin(), found.end());
+			ASSERT_TRUE(std::equal(found.begin(), found.end(), expectedNeighbors.begin() + expectedOffsets[i]));
+
+			uint32_t single[64];
+			ASSERT_EQ(grid.queryRadius(centers[i], radius, single, 64), offsets[i + 1] - offsets[i]);
+		}
+
+		std::vector<uint32_t> nearest(centers.size() * k);
+		grid.queryNearestMany(centers.data(), centers.size(), k, 1000.f, nearest.data());
+		ASSERT_EQ(nearest, expectedNearest);
+
+		uint32_t limited[4];
+		ASSERT_EQ(grid.queryNearest({ 1000.f, 1000.f, 1000.f }, 4, 10.f, limited), 0u);
+
+		if (firstRun.empty()) {
+			firstRun = neighbors;
+		}
+		else {
+			ASSERT_EQ(firstRun, neighbors);
+		}
+	}
+	maths::parallel::setThreadCount(1);
+	maths::parallel::setGrainSize(1024);
+}
+
+TEST(KDTREETestcase, KDTREEMatchesBruteForce) {
+	std::vector<maths::vec3> points;
+	std::vector<maths::vec2> points2;
+	for (size_t i = 0; i < 4001; i++) {
+		const float f{ (float)i };
+		points.push_back({ std::sin(f * 1.3f) * 30.f, std::cos(f * 0.7f) * 30.f, std::sin(f * 0.11f) * 30.f });
+		points2.push_back({ points.back().x, points.back().z });
+	}
+	points[17] = points[18]; // duplicates are ordered by index
+
+	std::vector<maths::vec3> queries;
+	std::vector<maths::vec2> queries2;
+	for (size_t i = 0; i < 200; i++) {
+		const float f{ (float)i };
+		queries.push_back({ std::cos(f) * 35.f, std::sin(f * 2.f) * 35.f, f * 0.3f - 30.f });
+		queries2.push_back({ queries.back().x, queries.back().z });
+	}
+	queries[0] = points[17];
+
+	const size_t k{ 5 };
+	const float radius{ 4.f };
+	std::vector<uint32_t> expectedNearest, expectedNearest2, expectedCounts;
+	for (size_t q = 0; q < queries.size(); q++) {
+		std::vector<std::pair<float, uint32_t>> all, all2;
+		for (uint32_t i = 0; i < points.size(); i++) {
+			const maths::vec3 d{ points[i] - queries[q] };
+			all.push_back({ d.x * d.x + d.y * d.y + d.z * d.z, i });
+			const maths::vec2 d2{ points2[i] - queries2[q] };
+			all2.push_back({ d2.x * d2.x + d2.y * d2.y, i });
+		}
+		std::sort(all.begin(), all.end());
+		std::sort(all2.begin(), all2.end());
+		for (size_t i = 0; i < k; i++) {
+			expectedNearest.push_back(all[i].second);
+			expectedNearest2.push_back(all2[i].second);
+		}
+		expectedCounts.push_back((uint32_t)std::count_if(all.begin(), all.end(), [radius](const auto& a) { return a.first <= radius * radius; }));
+	}
+
+	for (size_t threads : { 1, 4 }) {
+		maths::parallel::setThreadCount(threads);
+		maths::kdTree3 tree;
+		tree.build(points.data(), points.size(), 8);
+		maths::kdTree2 tree2;
+		tree2.build(points2.data(), points2.size());
+		ASSERT_EQ(tree.size(), points.size());
+
+		std::vector<uint32_t> nearest(queries.size() * k);
+		tree.nearestMany(queries.data(), queries.size(), k, nearest.data());
+		ASSERT_EQ(nearest, expectedNearest);
+		ASSERT_EQ(nearest[0], 17u);
+		tree2.nearestMany(queries2.data(), queries2.size(), k, nearest.data());
+		ASSERT_EQ(nearest, expectedNearest2);
+
+		// approximate distances are within (1 + epsilon) of exact ones
+		const float epsilon{ 0.5f };
+		tree.nearestMany(queries.data(), queries.size(), k, nearest.data(), epsilon);
+		for (size_t q = 0; q < queries.size(); q++) {
+			for (size_t i = 0; i < k; i++) {
+				const float approximate{ maths::vec3::length(points[nearest[q * k + i]] - queries[q]) };
+				const float exact{ maths::vec3::length(points[expectedNearest[q * k + i]] - queries[q]) };
+				ASSERT_TRUE(approximate <= exact * (1.f + epsilon) + 1e-5f);
+			}
+		}
+
+		std::vector<uint32_t> offsets, neighbors;
+		tree.radiusMany(queries.data(), queries.size(), radius, offsets, neighbors);
+		for (size_t q = 0; q < queries.size(); q++) {
+			ASSERT_EQ(offsets[q + 1] - offsets[q], expectedCounts[q]);
+			for (uint32_t i = offsets[q]; i < offsets[q + 1]; i++) {
+				ASSERT_TRUE(maths::vec3::length(points[neighbors[i]] - queries[q]) <= radius * 1.0001f);
+			}
+			uint32_t single[1];
+			ASSERT_EQ(tree.radius(queries[q], radius, single, 1), expectedCounts[q]);
+		}
+	}
+	maths::parallel::setThreadCount(1);
+
+	maths::kdTree3 empty;
+	empty.build(points.data(), 0);
+	uint32_t none[1];
+	ASSERT_EQ(empty.nearest({ 0.f, 0.f, 0.f }, 1, none), 0u);
+}
+
+TEST(GJKTestcase, GJKDistanceAndPenetration) {
+	maths::convexShape sphereA{ maths::convexShape::sphere(1.f) };
+	maths::convexShape sphereB{ maths::convexShape::sphere(1.f) };
+	sphereA.setTransform({ 0.f, 0.f, 0.f }, maths::quat({ 0.f, 0.f, 0.f }));
+	sphereB.setTransform({ 3.f, 0.f, 0.f }, maths::quat({ 0.f, 0.f, 0.f }));
+
+	maths::convexResult result{ maths::gjk::distance(sphereA, sphereB) };
+	ASSERT_FALSE(result.intersecting);
+	ASSERT_FALSE(maths::gjk::intersect(sphereA, sphereB));
+	ASSERT_NEAR(result.distance, 1.f, 1e-3f);
+	ASSERT_NEAR(result.normal.x, 1.f, 1e-3f);
+	ASSERT_NEAR(result.pointA.x, 1.f, 1e-3f);
+	ASSERT_NEAR(result.pointB.x, 2.f, 1e-3f);
+
+	sphereB.setTransform({ 1.5f, 0.f, 0.f }, maths::quat({ 0.f, 0.f, 0.f }));
+	result = maths::gjk::penetration(sphereA, sphereB);
+	ASSERT_TRUE(result.intersecting);
+	ASSERT_TRUE(maths::gjk::intersect(sphereA, sphereB));
+	ASSERT_NEAR(result.distance, -0.5f, 1e-2f);
+	ASSERT_NEAR(result.normal.x, 1.f, 1e-2f);
+
+	maths::convexShape boxA{ maths::convexShape::box({ 1.f, 1.f, 1.f }) };
+	maths::convexShape boxB{ maths::convexShape::box({ 1.f, 1.f, 1.f }) };
+	boxA.setTransform({ 0.f, 0.f, 0.f }, maths::quat({ 0.f, 0.f, 0.f }));
+	boxB.setTransform({ 1.5f, 0.2f, 0.1f }, maths::quat({ 0.f, 0.f, 0.f }));
+	result = maths::gjk::penetration(boxA, boxB);
+	ASSERT_TRUE(result.intersecting);
+	ASSERT_NEAR(result.distance, -0.5f, 1e-3f);
+	ASSERT_NEAR(result.normal.x, 1.f, 1e-3f);
+
+	// capsule lying along x axis, resting 0.1 deep on top face of hull made of cube corners
+	const maths::vec3 corners[8]{ { -1.f, -1.f, -1.f }, { 1.f, -1.f, -1.f }, { -1.f, 1.f, -1.f }, { 1.f, 1.f, -1.f },
+		{ -1.f, -1.f, 1.f }, { 1.f, -1.f, 1.f }, { -1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f } };
+	maths::convexShape hull{ maths::convexShape::hull(corners, 8) };
+	maths::convexShape capsule{ maths::convexShape::capsule(0.5f, 1.f) };
+	hull.setTransform({ 0.f, 0.f, 0.f }, maths::quat({ 0.f, 0.f, 0.f }));
+	capsule.setTransform({ 0.2f, 1.4f, 0.f }, maths::quat({ 0.f, 0.f, maths::trig::toRadians(90.f) }));
+	result = maths::gjk::penetration(hull, capsule);
+	ASSERT_TRUE(result.intersecting);
+	ASSERT_NEAR(result.distance, -0.1f, 1e-3f);
+	ASSERT_NEAR(result.normal.y, 1.f, 1e-3f);
+	ASSERT_NEAR(result.pointA.y, 1.f, 1e-3f);
+	ASSERT_NEAR(result.pointB.y, 0.9f, 1e-3f);
+
+	capsule.setTransform({ 0.2f, 3.f, 0.f }, maths::quat({ 0.f, 0.f, maths::trig::toRadians(90.f) }));
+	result = maths::gjk::distance(hull, capsule);
+	ASSERT_FALSE(result.intersecting);
+	ASSERT_NEAR(result.distance, 1.5f, 1e-3f);
+
+	// empty hull degenerates to its local origin
+	maths::convexShape empty{ maths::convexShape::hull(corners, 0) };
+	empty.setTransform({ 0.f, 0.f, 0.f }, maths::quat({ 0.f, 0.f, 0.f }));
+	result = maths::gjk::distance(empty, sphereB);
+	ASSERT_FALSE(result.intersecting);
+	ASSERT_NEAR(result.distance, 0.5f, 1e-3f);
+
+	// warm started query of slightly moved shape shouldn't need more iterations than cold one
+	maths::gjkCache cache{};
+	boxB.setTransform({ 3.f, 0.5f, 0.1f }, maths::quat({ 0.1f, 0.2f, 0.f }));
+	maths::gjk::distance(sphereA, boxB, &cache);
+	boxB.setTransform({ 3.02f, 0.5f, 0.1f }, maths::quat({ 0.1f, 0.2f, 0.f }));
+	const maths::convexResult cold{ maths::gjk::distance(sphereA, boxB) };
+	const maths::convexResult warm{ maths::gjk::distance(sphereA, boxB, &cache) };
+	ASSERT_LE(warm.iterations, cold.iterations);
+	ASSERT_NEAR(warm.distance, cold.distance, 1e-3f);
+
+	std::vector<maths::convexShape> shapes;
+	for (size_t i = 0; i < 40; i++) {
+		const float f{ (float)i };
+		maths::convexShape shape{ i % 3 == 0 ? maths::convexShape::sphere(0.7f) : i % 3 == 1
+			? maths::convexShape::box({ 0.5f, 0.8f, 0.6f }) : maths::convexShape::capsule(0.4f, 0.6f) };
+		shape.setTransform({ std::sin(f) * 2.f, std::cos(f * 1.7f) * 2.f, std::sin(f * 0.3f) }, maths::quat({ f, f * 0.5f, 0.f }));
+		shapes.push_back(shape);
+	}
+	std::vector<maths::convexPair> pairs;
+	for (uint32_t i = 0; i < shapes.size(); i++) {
+		for (uint32_t j = i + 1; j < shapes.size(); j++) {
+			pairs.push_back({ i, j });
+		}
+	}
+	std::vector<maths::convexResult> results(pairs.size());
+	maths::gjk::penetrationMany(shapes.data(), pairs.data(), pairs.size(), results.data());
+	for (size_t i = 0; i < pairs.size(); i++) {
+		const maths::convexShape& a{ shapes[pairs[i].a] };
+		const maths::convexShape& b{ shapes[pairs[i].b] };
+		const maths::convexResult expected{ maths::gjk::penetration(a, b) };
+		ASSERT_EQ(results[i].intersecting, expected.intersecting);
+		ASSERT_EQ(results[i].distance, expected.distance);
+		ASSERT_EQ(results[i].intersecting, maths::gjk::intersect(a, b));
+		if (expected.intersecting && expected.distance < 0.f) {
+			// moving B out by depth along normal must separate shapes
+			maths::convexShape moved{ b };
+			moved.translation = moved.translation + expected.normal * (-expected.distance + 1e-2f);
+			ASSERT_FALSE(maths::gjk::intersect(a, moved));
+		}
+		else if (!expected.intersecting) {
+			// witness points must match reported distance
+			const maths::vec3 gap{ expected.pointB - expected.pointA };
+			ASSERT_NEAR(std::sqrt(maths::vec3::dot(gap, gap)), expected.distance, 1e-3f);
+		}
+	}
+}
+
+TEST(OBBTestcase, OBBSeparatingAxisAndFitting) {
+	const maths::quat rotated45{ maths::quat({ 0.f, 0.f, maths::trig::toRadians(45.f) }) };
+	const maths::obb unit{ { 0.f, 0.f, 0.f }, maths::mat3(1.f), { 1.f, 1.f, 1.f } };
+	ASSERT_TRUE(maths::obb::intersects(unit, maths::obb({ 2.3f, 0.f, 0.f }, rotated45, { 1.f, 1.f, 1.f })));
+	ASSERT_FALSE(maths::obb::intersects(unit, maths::obb({ 2.5f, 0.f, 0.f }, rotated45, { 1.f, 1.f, 1.f })));
+
+	// parallel thin diagonal boxes are separated, although their aabbs overlap
+	const maths::obb thinA{ { 0.f, 0.f, 0.f }, rotated45, { 3.f, 0.1f, 0.1f } };
+	const maths::obb thinB{ { -0.7071f, 0.7071f, 0.f }, rotated45, { 3.f, 0.1f, 0.1f } };
+	ASSERT_FALSE(maths::obb::intersects(thinA, thinB));
+	ASSERT_TRUE(maths::aabb::intersects(thinA.toAabb(), thinB.toAabb()));
+	ASSERT_TRUE(maths::obb::intersects(thinA, maths::aabb({ 1.f, 1.f, -1.f }, { 2.f, 2.f, 1.f })));
+	ASSERT_FALSE(maths::obb::intersects(thinA, maths::aabb({ 1.f, -2.f, -1.f }, { 2.f, -1.f, 1.f })));
+	ASSERT_FALSE(maths::obb::intersects(thinA, maths::aabb()));
+	ASSERT_TRUE(thinA.contains({ 2.f, 2.f, 0.f }));
+	ASSERT_FALSE(thinA.contains({ 2.f, -2.f, 0.f }));
+
+	float distance{ 0.f };
+	const maths::obb target{ { 5.f, 0.f, 0.f }, maths::quat({ 0.6f, 0.f, 0.f }), { 1.f, 1.f, 1.f } };
+	ASSERT_TRUE(target.intersectsRay({ 0.f, 0.f, 0.f }, { 2.f, 0.f, 0.f }, distance));
+	ASSERT_NEAR(distance, 2.f, 1e-5f);
+	ASSERT_FALSE(target.intersectsRay({ 0.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, distance));
+	ASSERT_TRUE(target.intersectsRay({ 5.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, distance));
+	ASSERT_EQ(distance, 0.f);
+
+	const maths::frustum planes{ maths::frustum::fromMatrix(maths::mat4::perspective(maths::trig::toRadians(60.f), 1.f, 0.1f, 100.f)
+		* maths::mat4::lookAt({ 0.f, 0.f, 10.f }, { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f })) };
+	ASSERT_TRUE(unit.intersectsFrustum(planes));
+	ASSERT_FALSE(maths::obb({ 0.f, 0.f, 20.f }, maths::mat3(1.f), { 1.f, 1.f, 1.f }).intersectsFrustum(planes));
+
+	const maths::obb transformed{ maths::obb::fromAabb(maths::aabb({ -1.f, -1.f, -1.f }, { 1.f, 3.f, 1.f }),
+		maths::mat4::translation({ 1.f, 0.f, 0.f }) * maths::mat4::scale({ 2.f, 2.f, 2.f })) };
+	ASSERT_NEAR(transformed.center.x, 1.f, 1e-5f);
+	ASSERT_NEAR(transformed.center.y, 2.f, 1e-5f);
+	ASSERT_NEAR(transformed.halfExtents.y, 4.f, 1e-5f);
+
+	// points spread along rotated box, fitted box should follow its axes
+	std::vector<maths::vec3> points;
+	const maths::obb source{ { 3.f, -2.f, 1.f }, maths::quat({ 0.3f, 0.7f, -0.2f }), { 4.f, 1.f, 0.5f } };
+	for (size_t i = 0; i < 2000; i++) {
+		const float f{ (float)i };
+		const maths::vec3 local{ std::sin(f * 1.3f) * 4.f, std::cos(f * 0.7f) * 1.f, std::sin(f * 0.11f) * 0.5f };
+		points.push_back(source.center + source.orientation * local);
+	}
+	const maths::obb fitted{ maths::obb::fromPoints(points.data(), points.size()) };
+	ASSERT_NEAR(fitted.halfExtents.x, 4.f, 0.1f);
+	ASSERT_NEAR(fitted.halfExtents.y, 1.f, 0.1f);
+	ASSERT_NEAR(fitted.halfExtents.z, 0.5f, 0.1f);
+	ASSERT_NEAR(std::fabs(maths::vec3::dot(fitted.orientation.getColumn3(0), source.orientation.getColumn3(0))), 1.f, 1e-3f);
+	ASSERT_NEAR(maths::mat3::determinant(fitted.orientation), 1.f, 1e-4f);
+	const maths::obb inflated{ fitted.center, fitted.orientation, fitted.halfExtents + 1e-3f };
+	for (const maths::vec3& point : points) {
+		ASSERT_TRUE(inflated.contains(point));
+	}
+
+	std::vector<maths::obb> boxes;
+	for (size_t i = 0; i < 1003; i++) {
+		const float f{ (float)i };
+		boxes.push_back({ { std::sin(f) * 20.f, std::cos(f * 1.7f) * 20.f, std::sin(f * 0.3f) * 20.f - 10.f },
+			maths::quat({ f, f * 0.5f, f * 0.25f }), { 0.5f + std::fabs(std::sin(f * 3.f)) * 3.f, 0.5f, 1.f } });
+	}
+	std::vector<uint8_t> overlapping(boxes.size()), visible(boxes.size());
+	std::vector<float> distances(boxes.size());
+	maths::obb::intersectsMany(thinA, boxes.data(), boxes.size(), overlapping.data());
+	maths::obb::intersectsFrustumMany(planes, boxes.data(), boxes.size(), visible.data());
+	maths::obb::intersectsRayMany({ 0.f, 0.f, 10.f }, { 0.3f, 0.2f, -1.f }, boxes.data(), boxes.size(), distances.data());
+	size_t hits{ 0 };
+	for (size_t i = 0; i < boxes.size(); i++) {
+		ASSERT_EQ(overlapping[i] == 1, maths::obb::intersects(thinA, boxes[i]));
+		ASSERT_EQ(visible[i] == 1, boxes[i].intersectsFrustum(planes));
+		const bool hit{ boxes[i].intersectsRay({ 0.f, 0.f, 10.f }, { 0.3f, 0.2f, -1.f }, distance) };
+		ASSERT_EQ(distances[i], hit ? distance : FLT_MAX);
+		hits += hit ? 1 : 0;
+	}
+	ASSERT_GT(hits, 0);
+}
+
+TEST(DECOMPOSITIONTestcase, DECOMPOSITIONEigenSvdPolar) {
+	const auto multiply = [](const maths::mat3& u, maths::vec3 sigma, const maths::mat3& v) {
+		maths::mat3 diagonal(1.f);
+		diagonal[0] = sigma.x;
+		diagonal[4] = sigma.y;
+		diagonal[8] = sigma.z;
+		return u * diagonal * maths::mat3::transpose(v);
+	};
+	const auto expectNear = [](const maths::mat3& left, const maths::mat3& right, float tolerance) {
+		for (unsigned int i = 0; i < 9; i++) {
+			ASSERT_NEAR(left[i], right[i], tolerance);
+		}
+	};
+
+	const maths::mat3 rotation{ maths::mat3::fromQuat(maths::quat({ 0.4f, -1.1f, 2.f })) };
+	const maths::mat3 symmetric{ multiply(rotation, { 2.f, 5.f, -1.f }, rotation) };
+	maths::mat3 vectors;
+	maths::vec3 values;
+	maths::decomposition::eigenSymmetric(symmetric, vectors, values);
+	ASSERT_NEAR(values.x, 5.f, 1e-5f);
+	ASSERT_NEAR(values.y, 2.f, 1e-5f);
+	ASSERT_NEAR(values.z, -1.f, 1e-5f);
+	ASSERT_NEAR(maths::mat3::determinant(vectors), 1.f, 1e-5f);
+	expectNear(multiply(vectors, values, vectors), symmetric, 1e-5f);
+	ASSERT_NEAR(std::fabs(maths::vec3::dot(vectors.getColumn3(0), rotation.getColumn3(1))), 1.f, 1e-5f);
+
+	std::vector<maths::mat3> matrices;
+	for (size_t i = 0; i < 203; i++) {
+		const float f{ (float)i };
+		maths::mat3 m;
+		for (unsigned int k = 0; k < 9; k++) {
+			m[k] = std::sin(f * 1.7f + (float)k * 0.9f) * 3.f;
+		}
+		if (i % 5 == 0) {
+			m[2] = m[0] * 2.f; // singular, first row is proportional to third one
+			m[5] = m[3] * 2.f;
+			m[8] = m[6] * 2.f;
+		}
+		matrices.push_back(m);
+	}
+	matrices.push_back(maths::mat3());
+	matrices.push_back(maths::mat3(1.f));
+	std::vector<maths::mat3> us(matrices.size()), vs(matrices.size());
+	std::vector<maths::vec3> sigmas(matrices.size());
+	maths::decomposition::svdMany(matrices.data(), us.data(), sigmas.data(), vs.data(), matrices.size());
+	for (size_t i = 0; i < matrices.size(); i++) {
+		maths::mat3 u, v;
+		maths::vec3 sigma;
+		maths::decomposition::svd(matrices[i], u, sigma, v);
+		expectNear(multiply(u, sigma, v), matrices[i], 1e-4f);
+		expectNear(u * maths::mat3::transpose(u), maths::mat3(1.f), 1e-5f);
+		expectNear(v * maths::mat3::transpose(v), maths::mat3(1.f), 1e-5f);
+		ASSERT_NEAR(maths::mat3::determinant(u), 1.f, 1e-5f);
+		ASSERT_NEAR(maths::mat3::determinant(v), 1.f, 1e-5f);
+		ASSERT_GE(sigma.x, sigma.y);
+		ASSERT_GE(sigma.y, std::fabs(sigma.z) - 1e-5f);
+		ASSERT_EQ(sigma.z < -1e-4f, maths::mat3::determinant(matrices[i]) < -1e-3f);
+		expectNear(us[i], u, 1e-6f);
+		expectNear(vs[i], v, 1e-6f);
+		ASSERT_NEAR(sigmas[i].x, sigma.x, 1e-6f);
+	}
+
+	std::vector<maths::mat3> eigenVectors(matrices.size());
+	std::vector<maths::vec3> eigenValues(matrices.size());
+	maths::decomposition::eigenSymmetricMany(matrices.data(), eigenVectors.data(), eigenValues.data(), matrices.size());
+	for (size_t i = 0; i < matrices.size(); i++) {
+		maths::decomposition::eigenSymmetric(matrices[i], vectors, values);
+		expectNear(eigenVectors[i], vectors, 1e-6f);
+		ASSERT_NEAR(eigenValues[i].z, values.z, 1e-6f);
+	}
+
+	// sheared matrix, rotation of polar decomposition is orthonormal and stretch is symmetric
+	maths::mat3 shear(1.f);
+	shear[3] = 0.8f;
+	maths::mat3 stretch;
+	const maths::mat3 polarRotation{ maths::decomposition::polar(rotation * shear, &stretch) };
+	expectNear(polarRotation * stretch, rotation * shear, 1e-5f);
+	expectNear(stretch, maths::mat3::transpose(stretch), 1e-5f);
+	expectNear(polarRotation * maths::mat3::transpose(polarRotation), maths::mat3(1.f), 1e-5f);
+	expectNear(maths::decomposition::polar(rotation * multiply(maths::mat3(1.f), { 2.f, 3.f, 4.f }, maths::mat3(1.f))), rotation, 1e-5f);
+
+	std::vector<maths::vec3> from, to;
+	for (size_t i = 0; i < 50; i++) {
+		const float f{ (float)i };
+		from.push_back({ std::sin(f) * 4.f, std::cos(f * 1.3f) * 2.f, std::sin(f * 0.7f) });
+		to.push_back(rotation * from.back() + maths::vec3(1.f, -2.f, 3.f));
+	}
+	maths::vec3 translation;
+	expectNear(maths::decomposition::kabsch(from.data(), to.data(), from.size(), &translation), rotation, 1e-5f);
+	ASSERT_NEAR(translation.x, 1.f, 1e-4f);
+	ASSERT_NEAR(translation.y, -2.f, 1e-4f);
+	ASSERT_NEAR(translation.z, 3.f, 1e-4f);
+
+	maths::vec3 moments;
+	const maths::mat3 axes{ maths::decomposition::principalAxes(multiply(rotation, { 1.f, 3.f, 2.f }, rotation), moments) };
+	ASSERT_NEAR(moments.x, 3.f, 1e-5f);
+	ASSERT_NEAR(moments.z, 1.f, 1e-5f);
+	ASSERT_NEAR(std::fabs(maths::vec3::dot(axes.getColumn3(2), rotation.getColumn3(0))), 1.f, 1e-5f);
+
+	// mirrored and degenerate transforms decompose to proper rotation
+	const maths::vec3 eulers{ 0.3f, -0.4f, 0.2f };
+	const maths::mat4 mirrored{ maths::mat4::translation({ 1.f, 2.f, 3.f }) * maths::quat::rotationFromQuat(maths::quat(eulers))
+		* maths::mat4::scale({ -2.f, 1.f, 3.f }) };
+	maths::vec3 position, angles, scale;
+	maths::mat4::decompose(mirrored, position, angles, scale);
+	maths::mat4 recomposed;
+	maths::mat4::recompose(recomposed, position, maths::quat(angles), scale);
+	for (unsigned int i = 0; i < 16; i++) {
+		ASSERT_NEAR(recomposed[i], mirrored[i], 1e-4f);
+	}
+	maths::mat4::decompose(maths::mat4::scale({ 0.f, 1.f, 1.f }), position, angles, scale);
+	ASSERT_NEAR(scale.x, 0.f, 1e-6f);
+	ASSERT_NEAR(angles.x, 0.f, 1e-6f);
+	ASSERT_NEAR(angles.y, 0.f, 1e-6f);
+	ASSERT_NEAR(angles.z, 0.f, 1e-6f);
+}
+
+TEST(SWEEPANDPRUNETestcase, SWEEPANDPRUNEMatchesBruteForce) {
+	std::vector<maths::aabb> boxes;
+	for (size_t i = 0; i < 1500; i++) {
+		const float f{ (float)i };
+		const maths::vec3 center{ std::sin(f * 1.3f) * 30.f, std::cos(f * 0.7f) * 10.f, std::sin(f * 0.11f) * 8.f };
+		const maths::vec3 half{ 0.5f + std::fabs(std::sin(f)), 0.5f, 0.3f + std::fabs(std::cos(f * 3.f)) };
+		boxes.push_back({ center - half, center + half });
+	}
+	boxes[7] = boxes[3]; // identical and touching boxes overlap
+	boxes[9] = { boxes[3].maximum, boxes[3].maximum + 1.f };
+
+	maths::sweepAndPrune broadphase;
+	std::vector<maths::convexPair> pairs;
+	for (size_t frame = 0; frame < 4; frame++) {
+		if (frame == 3) {
+			boxes.pop_back(); // count change rebuilds order
+		}
+		broadphase.update(boxes.data(), boxes.size());
+		ASSERT_EQ(broadphase.axis(), 0);
+		ASSERT_EQ(broadphase.size(), boxes.size());
+
+		const size_t found{ broadphase.findPairs(pairs.data(), pairs.size()) };
+		if (found > pairs.size()) {
+			pairs.resize(found);
+			ASSERT_EQ(broadphase.findPairs(pairs.data(), pairs.size()), found);
+		}
+
+		std::vector<std::pair<uint32_t, uint32_t>> expected, actual;
+		for (uint32_t i = 0; i < boxes.size(); i++) {
+			for (uint32_t j = i + 1; j < boxes.size(); j++) {
+				if (maths::aabb::intersects(boxes[i], boxes[j])) {
+					expected.push_back({ i, j });
+				}
+			}
+		}
+		for (size_t i = 0; i < found; i++) {
+			ASSERT_LT(pairs[i].a, pairs[i].b);
+			actual.push_back({ pairs[i].a, pairs[i].b });
+		}
+		std::sort(actual.begin(), actual.end());
+		ASSERT_EQ(actual, expected);
+		ASSERT_GT(found, 0);
+
+		// move boxes a bit, next update is incremental
+		for (size_t i = 0; i < boxes.size(); i++) {
+			const maths::vec3 offset{ std::sin((float)(i + frame)) * 0.3f, std::cos((float)i) * 0.2f, 0.f };
+			boxes[i] = { boxes[i].minimum + offset, boxes[i].maximum + offset };
+		}
+	}
+}
+
+TEST(RIGIDBODYTestcase, RIGIDBODYFreeFallMatchesAnalytic) {
+	const maths::vec3 gravity{ 0.f, -9.81f, 0.f };
+	const float dt{ 1.f / 64.f };
+	const size_t steps{ 64 };
+
+	for (int verlet = 0; verlet < 2; verlet++) {
+		maths::rigidBodyArrays bodies;
+		for (size_t i = 0; i < 5; i++) { // one SSE group and scalar tail
+			bodies.add({ (float)i, 10.f, 0.f }, { 1.f, 0.f, 0.f, 0.f }, 2.f, { 1.f, 1.f, 1.f });
+			bodies.velocityX[i] = 1.f;
+		}
+		const size_t fixed{ bodies.add({ 0.f, -5.f, 0.f }, { 1.f, 0.f, 0.f, 0.f }, 0.f, { 0.f, 0.f, 0.f }) };
+		bodies.forceY[fixed] = 100.f;
+
+		for (size_t s = 0; s < steps; s++) {
+			if (verlet) {
+				maths::rigidBody::kick(bodies, gravity, dt * 0.5f);
+				maths::rigidBody::drift(bodies, dt);
+				maths::rigidBody::kick(bodies, gravity, dt * 0.5f);
+			}
+			else {
+				maths::rigidBody::integrateSemiImplicitEuler(bodies, gravity, dt);
+			}
+		}
+
+		// velocity verlet is exact for constant acceleration, semi-implicit euler overshoots by g*t*dt/2
+		const float t{ dt * steps };
+		const float expectedY{ 10.f + 0.5f * gravity.y * t * t + (verlet ? 0.f : 0.5f * gravity.y * t * dt) };
+		for (size_t i = 0; i < 5; i++) {
+			ASSERT_NEAR(bodies.positionX[i], (float)i + t, 1e-4f);
+			ASSERT_NEAR(bodies.positionY[i], expectedY, 1e-3f);
+			ASSERT_NEAR(bodies.velocityY[i], gravity.y * t, 1e-3f);
+		}
+		ASSERT_EQ(bodies.positionY[fixed], -5.f);
+		ASSERT_EQ(bodies.velocityY[fixed], 0.f);
+		ASSERT_EQ(bodies.forceY[fixed], verlet ? 100.f : 0.f);
+	}
+
+	// spring force recomputed between drift and second kick keeps velocity verlet second order
+	maths::rigidBodyArrays springs;
+	for (size_t i = 0; i < 5; i++) {
+		springs.add({ 1.f, 0.f, 0.f }, { 1.f, 0.f, 0.f, 0.f }, 1.f, { 1.f, 1.f, 1.f });
+	}
+	const auto springForces = [&springs]() {
+		for (size_t i = 0; i < springs.size(); i++) {
+			springs.forceX[i] = -springs.positionX[i];
+		}
+	};
+	const size_t period{ 402 }; // 2 pi / dt
+	springForces();
+	for (size_t s = 0; s < period; s++) {
+		maths::rigidBody::kick(springs, { 0.f, 0.f, 0.f }, dt * 0.5f);
+		maths::rigidBody::drift(springs, dt);
+		springForces();
+		maths::rigidBody::kick(springs, { 0.f, 0.f, 0.f }, dt * 0.5f);
+	}
+	const float t{ dt * period };
+	for (size_t i = 0; i < springs.size(); i++) {
+		ASSERT_NEAR(springs.positionX[i], std::cos(t), 1e-4f);
+		ASSERT_NEAR(springs.velocityX[i], -std::sin(t), 1e-4f);
+	}
+}
+
+TEST(RIGIDBODYTestcase, RIGIDBODYRotationMatchesQuatIntegrate) {
+	maths::rigidBodyArrays bodies;
+	std::vector<maths::quat> expected;
+	for (size_t i = 0; i < 7; i++) {
+		const float f{ (float)i };
+		const maths::quat q{ maths::quat::normalize({ 1.f, 0.2f * f, -0.1f, 0.3f }) };
+		bodies.add({ f, 0.f, -f }, q, 1.f, { 1.f + f, 2.f, 0.5f });
+		bodies.angularVelocityX[i] = 0.5f * f;
+		bodies.angularVelocityZ[i] = -1.f;
+		expected.push_back(q);
+	}
+
+	const float dt{ 0.01f };
+	std::vector<maths::mat4> transforms(bodies.size());
+	for (size_t s = 0; s < 20; s++) {
+		maths::rigidBody::integrateSemiImplicitEuler(bodies, { 0.f, 0.f, 0.f }, dt, transforms.data());
+		for (size_t i = 0; i < expected.size(); i++) {
+			expected[i] = maths::quat::integrate(expected[i], { bodies.angularVelocityX[i], 0.f, -1.f }, dt);
+		}
+	}
+
+	for (size_t i = 0; i < expected.size(); i++) {
+		ASSERT_NEAR(bodies.orientationW[i], expected[i].w, 1e-5f);
+		ASSERT_NEAR(bodies.orientationX[i], expected[i].x, 1e-5f);
+		ASSERT_NEAR(bodies.orientationY[i], expected[i].y, 1e-5f);
+		ASSERT_NEAR(bodies.orientationZ[i], expected[i].z, 1e-5f);
+
+		const maths::quat q{ bodies.orientationW[i], bodies.orientationX[i], bodies.orientationY[i], bodies.orientationZ[i] };
+		const maths::mat4 model{ maths::mat4::translation({ bodies.positionX[i], bodies.positionY[i], bodies.positionZ[i] }) * maths::quat::rotationFromQuat(q) };
+		for (unsigned int e = 0; e < 16; e++) {
+			ASSERT_NEAR(transforms[i][e], model[e], 1e-5f);
+		}
+
+		const maths::mat3 r{ maths::mat3::fromQuat(q) };
+		maths::mat3 diagonal;
+		diagonal[0] = 1.f / (1.f + (float)i);
+		diagonal[4] = 0.5f;
+		diagonal[8] = 2.f;
+		const maths::mat3 world{ r * diagonal * maths::mat3::transpose(r) };
+		const maths::mat3 stored{ bodies.inverseInertiaWorld(i) };
+		for (unsigned int e = 0; e < 9; e++) {
+			ASSERT_NEAR(stored[e], world[e], 1e-5f);
+		}
+	}
+}
+
+TEST(RIGIDBODYTestcase, RIGIDBODYTorqueSpinsBody) {
+	maths::rigidBodyArrays bodies;
+	bodies.add({ 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f, 0.f }, 1.f, { 2.f, 2.f, 4.f });
+	bodies.torqueZ[0] = 8.f;
+	maths::rigidBody::kick(bodies, { 0.f, 0.f, 0.f }, 0.5f);
+	ASSERT_NEAR(bodies.angularVelocityZ[0], 1.f, 1e-6f);
+	ASSERT_EQ(bodies.orientationW[0], 1.f);
+	ASSERT_EQ(bodies.torqueZ[0], 8.f);
+	maths::rigidBody::drift(bodies, 0.5f);
+	ASSERT_NEAR(bodies.orientationZ[0], std::sin(0.25f), 1e-2f);
+	ASSERT_EQ(bodies.torqueZ[0], 8.f);
+
+	// quaternion product composes rotations in the same order as matrices
+	const maths::quat a{ maths::quat(maths::vec3(0.3f, -0.2f, 0.9f)) };
+	const maths::quat b{ maths::quat(maths::vec3(-1.1f, 0.4f, 0.1f)) };
+	const maths::mat4 composed{ maths::quat::rotationFromQuat(a) * maths::quat::rotationFromQuat(b) };
+	const maths::mat4 product{ maths::quat::rotationFromQuat(maths::quat::multiply(a, b)) };
+	for (unsigned int e = 0; e < 16; e++) {
+		ASSERT_NEAR(product[e], composed[e], 1e-5f);
+	}
+}
+
 
 #if COMPARE_GLM_TO_MARMATH
 